@@ -14,6 +14,9 @@ function compileAllSources({ klawSync, paths, spawnSync }, extraArguments = [])
         '-D__CRYPTID_GMP',
         '-D__CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION',
         '-D__CRYPTID_HESS_IDENTITY_BASED_SIGNATURE',
+        '-D__CRYPTID_PTHREADS',
+        '-D__CRYPTID_RANDOM_POOL',
+        '-pthread',
         '-std=c99',
         '-Wall',
         '-Wextra',
@@ -47,6 +50,9 @@ function compileExecutableForComponent(componentName, { klawSync, fs, paths, spa
         '-D__CRYPTID_GMP',
         '-D__CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION',
         '-D__CRYPTID_HESS_IDENTITY_BASED_SIGNATURE',
+        '-D__CRYPTID_PTHREADS',
+        '-D__CRYPTID_RANDOM_POOL',
+        '-pthread',
         '-g',
         '-std=c99',
         '-o', testExecutable,
@@ -211,6 +211,47 @@ SHAResult SHA384_OneCall(const unsigned char* message, size_t messageLength, uns
 
 SHAResult SHA512_OneCall(const unsigned char* message, size_t messageLength, unsigned char* hashResult);
 
+/*
+ *  Accelerated block functions, processing count consecutive
+ *  message blocks into the intermediate hash.  These are selected
+ *  at load time from the instruction set extensions of the CPU
+ *  (see sha-kernels.c), and are NULL when none is available, in
+ *  which case the portable reference code is used.
+ */
+typedef void (*SHA256BlockKernel)(uint32_t Intermediate_Hash[SHA256HashSize/4],
+                                  const uint8_t *blocks, size_t count);
+typedef void (*SHA512BlockKernel)(uint64_t Intermediate_Hash[SHA512HashSize/8],
+                                  const uint8_t *blocks, size_t count);
+
+extern SHA256BlockKernel SHA256_Block_Kernel;
+extern SHA512BlockKernel SHA512_Block_Kernel;
+
+/*
+ *  Multi-buffer block function, processing one message block of
+ *  each of SHA256_Multi_Block_Lanes independent messages at once.
+ *  Word i of the intermediate hash of lane j is held at
+ *  Intermediate_Hashes[i * SHA256_Multi_Block_Lanes + j].  NULL, with
+ *  a single lane, when the CPU has no suitable vector extension.
+ */
+enum { SHA256_Max_Multi_Block_Lanes = 16 };
+
+typedef void (*SHA256MultiBlockKernel)(uint32_t *Intermediate_Hashes,
+                                       const uint8_t *const *blocks);
+
+extern SHA256MultiBlockKernel SHA256_Multi_Block_Kernel;
+extern int SHA256_Multi_Block_Lanes;
+
+/*
+ *  Computes the SHA-224 or SHA-256 digests of messageCount
+ *  independent messages, several at once when a multi-buffer block
+ *  function is available.
+ */
+SHAResult SHA224_256_MultiCall(SHAversion whichSha,
+                               const unsigned char *const *messages,
+                               const size_t *messageLengths,
+                               size_t messageCount,
+                               unsigned char *const *hashResults);
+
 /************************ sha-private.h ************************/
 /***************** See RFC 6234 for details. *******************/
 /*
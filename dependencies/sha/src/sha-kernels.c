@@ -0,0 +1,592 @@
+/************************ sha-kernels.c ************************/
+/*
+ *  Description:
+ *      Block functions of SHA-224/256 and SHA-384/512 built on
+ *      instruction set extensions, used by sha.c in place of the
+ *      portable reference code whenever the CPU supports them:
+ *
+ *        - x86 SHA extensions (SHA-NI) for SHA-224/256,
+ *        - ARMv8 Cryptographic Extension for SHA-224/256,
+ *        - AVX2 for SHA-384/512. There are no SHA-512 instructions
+ *          on these CPUs, so the message schedules of four
+ *          consecutive blocks are expanded at once, one block per
+ *          64-bit lane, while the rounds remain scalar,
+ *        - AVX-512 and AVX2 for hashing sixteen or eight independent
+ *          SHA-224/256 messages at once, one message per 32-bit lane
+ *          (see SHA224_256_MultiCall in sha.c).
+ *
+ *      The kernels are compiled with per-function target attributes,
+ *      so no special compiler flags are needed, and they are selected
+ *      at load time by CPUID (x86) or the hardware capabilities of
+ *      the operating system (ARM). Other compilers and targets, e.g.
+ *      WASI, use the reference code only.
+ */
+
+#include "sha.h"
+#include <string.h>
+
+SHA256BlockKernel SHA256_Block_Kernel = NULL;
+SHA512BlockKernel SHA512_Block_Kernel = NULL;
+SHA256MultiBlockKernel SHA256_Multi_Block_Kernel = NULL;
+int SHA256_Multi_Block_Lanes = 1;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA_KERNELS_X86
+#elif defined(__GNUC__) && defined(__aarch64__) && \
+      (defined(__linux__) || defined(__APPLE__))
+#define SHA_KERNELS_ARM
+#endif
+
+#if defined(SHA_KERNELS_X86) || defined(SHA_KERNELS_ARM)
+/* Constants defined in FIPS 180-3, section 4.2.2 */
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
+    0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+    0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+    0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152,
+    0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+    0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+    0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#if defined(SHA_KERNELS_X86)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+/*
+ * SHA224_256BlocksSHANI
+ *
+ * Description:
+ *   SHA-224/256 block function using the SHA extensions. The state
+ *   is kept in the ABEF/CDGH layout expected by SHA256RNDS2, and
+ *   every iteration performs four rounds while the message schedule
+ *   is advanced by SHA256MSG1/SHA256MSG2.
+ */
+__attribute__((target("sha,sse4.1")))
+static void SHA224_256BlocksSHANI(uint32_t Intermediate_Hash[8],
+                                  const uint8_t *blocks, size_t count)
+{
+  const __m128i byteSwap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i state0, state1, message, temp, abefSave, cdghSave;
+  __m128i W[4];
+  int i;
+
+  temp = _mm_loadu_si128((const __m128i *)&Intermediate_Hash[0]);
+  state1 = _mm_loadu_si128((const __m128i *)&Intermediate_Hash[4]);
+  temp = _mm_shuffle_epi32(temp, 0xB1);            /* CDAB */
+  state1 = _mm_shuffle_epi32(state1, 0x1B);        /* EFGH */
+  state0 = _mm_alignr_epi8(temp, state1, 8);       /* ABEF */
+  state1 = _mm_blend_epi16(state1, temp, 0xF0);    /* CDGH */
+
+  while (count--) {
+    abefSave = state0;
+    cdghSave = state1;
+
+    for (i = 0; i < 16; i++) {
+      if (i < 4)
+        W[i] = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(blocks + 16 * i)), byteSwap);
+
+      message = _mm_add_epi32(W[i & 3],
+          _mm_loadu_si128((const __m128i *)&SHA256_K[4 * i]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+
+      /* W[t] for the group after the next one */
+      if (i >= 3 && i < 15) {
+        temp = _mm_alignr_epi8(W[i & 3], W[(i - 1) & 3], 4);
+        W[(i + 1) & 3] = _mm_add_epi32(W[(i + 1) & 3], temp);
+        W[(i + 1) & 3] = _mm_sha256msg2_epu32(W[(i + 1) & 3], W[i & 3]);
+      }
+
+      message = _mm_shuffle_epi32(message, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+
+      if (i >= 1 && i < 13)
+        W[(i - 1) & 3] = _mm_sha256msg1_epu32(W[(i - 1) & 3], W[i & 3]);
+    }
+
+    state0 = _mm_add_epi32(state0, abefSave);
+    state1 = _mm_add_epi32(state1, cdghSave);
+    blocks += SHA256_Message_Block_Size;
+  }
+
+  temp = _mm_shuffle_epi32(state0, 0x1B);          /* FEBA */
+  state1 = _mm_shuffle_epi32(state1, 0xB1);        /* DCHG */
+  state0 = _mm_blend_epi16(temp, state1, 0xF0);    /* DCBA */
+  state1 = _mm_alignr_epi8(state1, temp, 8);       /* HGFE */
+
+  _mm_storeu_si128((__m128i *)&Intermediate_Hash[0], state0);
+  _mm_storeu_si128((__m128i *)&Intermediate_Hash[4], state1);
+}
+
+/* Rotation and sigma functions on eight 32-bit lanes */
+#define SHA256_AVX2_ROTR(bits,word) _mm256_or_si256( \
+  _mm256_srli_epi32((word), (bits)), _mm256_slli_epi32((word), 32-(bits)))
+#define SHA256_AVX2_XOR3(x,y,z) \
+  _mm256_xor_si256(_mm256_xor_si256((x), (y)), (z))
+#define SHA256_AVX2_SIGMA0(word) SHA256_AVX2_XOR3(SHA256_AVX2_ROTR(2,word), \
+  SHA256_AVX2_ROTR(13,word), SHA256_AVX2_ROTR(22,word))
+#define SHA256_AVX2_SIGMA1(word) SHA256_AVX2_XOR3(SHA256_AVX2_ROTR(6,word), \
+  SHA256_AVX2_ROTR(11,word), SHA256_AVX2_ROTR(25,word))
+#define SHA256_AVX2_sigma0(word) SHA256_AVX2_XOR3(SHA256_AVX2_ROTR(7,word), \
+  SHA256_AVX2_ROTR(18,word), _mm256_srli_epi32((word), 3))
+#define SHA256_AVX2_sigma1(word) SHA256_AVX2_XOR3(SHA256_AVX2_ROTR(17,word), \
+  SHA256_AVX2_ROTR(19,word), _mm256_srli_epi32((word), 10))
+
+/*
+ * SHA224_256LoadWordsAVX2
+ *
+ * Description:
+ *   Loads the sixteen big-endian words of one block of each of eight
+ *   lanes, transposed so that W[t] holds word t of every lane.
+ */
+__attribute__((target("avx2")))
+static void SHA224_256LoadWordsAVX2(__m256i W[16],
+                                    const uint8_t *const *blocks)
+{
+  const __m256i byteSwap = _mm256_set_epi64x(
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m256i rows[8], pairs[8], quads[8];
+  int half, j;
+
+  for (half = 0; half < 2; half++) {
+    for (j = 0; j < 8; j++)
+      rows[j] = _mm256_shuffle_epi8(_mm256_loadu_si256(
+          (const __m256i *)(blocks[j] + 32 * half)), byteSwap);
+
+    /* Words 0, 1 | 4, 5 and 2, 3 | 6, 7 of two lanes */
+    for (j = 0; j < 8; j += 2) {
+      pairs[j] = _mm256_unpacklo_epi32(rows[j], rows[j + 1]);
+      pairs[j + 1] = _mm256_unpackhi_epi32(rows[j], rows[j + 1]);
+    }
+
+    /* Word j | j + 4 of four lanes */
+    for (j = 0; j < 8; j += 4) {
+      quads[j] = _mm256_unpacklo_epi64(pairs[j], pairs[j + 2]);
+      quads[j + 1] = _mm256_unpackhi_epi64(pairs[j], pairs[j + 2]);
+      quads[j + 2] = _mm256_unpacklo_epi64(pairs[j + 1], pairs[j + 3]);
+      quads[j + 3] = _mm256_unpackhi_epi64(pairs[j + 1], pairs[j + 3]);
+    }
+
+    for (j = 0; j < 4; j++) {
+      W[8 * half + j] = _mm256_permute2x128_si256(quads[j], quads[j + 4],
+                                                  0x20);
+      W[8 * half + j + 4] = _mm256_permute2x128_si256(quads[j],
+                                                      quads[j + 4], 0x31);
+    }
+  }
+}
+
+/*
+ * SHA224_256MultiBlockAVX2
+ *
+ * Description:
+ *   SHA-224/256 block function hashing one block of each of eight
+ *   independent messages at once, one message per 32-bit lane.
+ */
+__attribute__((target("avx2")))
+static void SHA224_256MultiBlockAVX2(uint32_t *Intermediate_Hashes,
+                                     const uint8_t *const *blocks)
+{
+  __m256i W[16], state[8], temp1, temp2, A, B, C, D, E, F, G, H;
+  int t;
+
+  SHA224_256LoadWordsAVX2(W, blocks);
+
+  for (t = 0; t < 8; t++)
+    state[t] = _mm256_loadu_si256((const __m256i *)&Intermediate_Hashes[8*t]);
+
+  A = state[0]; B = state[1]; C = state[2]; D = state[3];
+  E = state[4]; F = state[5]; G = state[6]; H = state[7];
+
+  for (t = 0; t < 64; t++) {
+    if (t >= 16)
+      W[t & 15] = _mm256_add_epi32(
+          _mm256_add_epi32(SHA256_AVX2_sigma1(W[(t - 2) & 15]),
+                           W[(t - 7) & 15]),
+          _mm256_add_epi32(SHA256_AVX2_sigma0(W[(t - 15) & 15]), W[t & 15]));
+
+    temp1 = _mm256_add_epi32(
+        _mm256_add_epi32(H, SHA256_AVX2_SIGMA1(E)),
+        _mm256_add_epi32(
+            _mm256_xor_si256(_mm256_and_si256(E, F), _mm256_andnot_si256(E, G)),
+            _mm256_add_epi32(W[t & 15],
+                             _mm256_set1_epi32((int)SHA256_K[t]))));
+    temp2 = _mm256_add_epi32(SHA256_AVX2_SIGMA0(A), _mm256_or_si256(
+        _mm256_and_si256(A, B), _mm256_and_si256(C, _mm256_or_si256(A, B))));
+    H = G;
+    G = F;
+    F = E;
+    E = _mm256_add_epi32(D, temp1);
+    D = C;
+    C = B;
+    B = A;
+    A = _mm256_add_epi32(temp1, temp2);
+  }
+
+  state[0] = _mm256_add_epi32(state[0], A);
+  state[1] = _mm256_add_epi32(state[1], B);
+  state[2] = _mm256_add_epi32(state[2], C);
+  state[3] = _mm256_add_epi32(state[3], D);
+  state[4] = _mm256_add_epi32(state[4], E);
+  state[5] = _mm256_add_epi32(state[5], F);
+  state[6] = _mm256_add_epi32(state[6], G);
+  state[7] = _mm256_add_epi32(state[7], H);
+
+  for (t = 0; t < 8; t++)
+    _mm256_storeu_si256((__m256i *)&Intermediate_Hashes[8*t], state[t]);
+}
+
+/* Sigma functions on sixteen 32-bit lanes, 0x96 being x ^ y ^ z */
+#define SHA256_AVX512_XOR3(x,y,z) _mm512_ternarylogic_epi32((x), (y), (z), 0x96)
+#define SHA256_AVX512_SIGMA0(word) SHA256_AVX512_XOR3( \
+  _mm512_ror_epi32((word), 2), _mm512_ror_epi32((word), 13), \
+  _mm512_ror_epi32((word), 22))
+#define SHA256_AVX512_SIGMA1(word) SHA256_AVX512_XOR3( \
+  _mm512_ror_epi32((word), 6), _mm512_ror_epi32((word), 11), \
+  _mm512_ror_epi32((word), 25))
+#define SHA256_AVX512_sigma0(word) SHA256_AVX512_XOR3( \
+  _mm512_ror_epi32((word), 7), _mm512_ror_epi32((word), 18), \
+  _mm512_srli_epi32((word), 3))
+#define SHA256_AVX512_sigma1(word) SHA256_AVX512_XOR3( \
+  _mm512_ror_epi32((word), 17), _mm512_ror_epi32((word), 19), \
+  _mm512_srli_epi32((word), 10))
+
+/*
+ * SHA224_256MultiBlockAVX512
+ *
+ * Description:
+ *   SHA-224/256 block function hashing one block of each of sixteen
+ *   independent messages at once, one message per 32-bit lane. Ch()
+ *   and Maj() are single ternary logic instructions (0xCA and 0xE8).
+ */
+__attribute__((target("avx512f")))
+static void SHA224_256MultiBlockAVX512(uint32_t *Intermediate_Hashes,
+                                       const uint8_t *const *blocks)
+{
+  __m256i low[16], high[16];
+  __m512i W[16], state[8], temp1, temp2, A, B, C, D, E, F, G, H;
+  int t;
+
+  SHA224_256LoadWordsAVX2(low, blocks);
+  SHA224_256LoadWordsAVX2(high, blocks + 8);
+
+  for (t = 0; t < 16; t++)
+    W[t] = _mm512_inserti64x4(_mm512_castsi256_si512(low[t]), high[t], 1);
+
+  for (t = 0; t < 8; t++)
+    state[t] = _mm512_loadu_si512(&Intermediate_Hashes[16 * t]);
+
+  A = state[0]; B = state[1]; C = state[2]; D = state[3];
+  E = state[4]; F = state[5]; G = state[6]; H = state[7];
+
+  for (t = 0; t < 64; t++) {
+    if (t >= 16)
+      W[t & 15] = _mm512_add_epi32(
+          _mm512_add_epi32(SHA256_AVX512_sigma1(W[(t - 2) & 15]),
+                           W[(t - 7) & 15]),
+          _mm512_add_epi32(SHA256_AVX512_sigma0(W[(t - 15) & 15]), W[t & 15]));
+
+    temp1 = _mm512_add_epi32(
+        _mm512_add_epi32(H, SHA256_AVX512_SIGMA1(E)),
+        _mm512_add_epi32(_mm512_ternarylogic_epi32(E, F, G, 0xCA),
+                         _mm512_add_epi32(W[t & 15],
+                             _mm512_set1_epi32((int)SHA256_K[t]))));
+    temp2 = _mm512_add_epi32(SHA256_AVX512_SIGMA0(A),
+                             _mm512_ternarylogic_epi32(A, B, C, 0xE8));
+    H = G;
+    G = F;
+    F = E;
+    E = _mm512_add_epi32(D, temp1);
+    D = C;
+    C = B;
+    B = A;
+    A = _mm512_add_epi32(temp1, temp2);
+  }
+
+  state[0] = _mm512_add_epi32(state[0], A);
+  state[1] = _mm512_add_epi32(state[1], B);
+  state[2] = _mm512_add_epi32(state[2], C);
+  state[3] = _mm512_add_epi32(state[3], D);
+  state[4] = _mm512_add_epi32(state[4], E);
+  state[5] = _mm512_add_epi32(state[5], F);
+  state[6] = _mm512_add_epi32(state[6], G);
+  state[7] = _mm512_add_epi32(state[7], H);
+
+  for (t = 0; t < 8; t++)
+    _mm512_storeu_si512(&Intermediate_Hashes[16 * t], state[t]);
+}
+
+#ifndef USE_32BIT_ONLY
+/* Constants defined in FIPS 180-3, section 4.2.3 */
+static const uint64_t SHA512_K[80] = {
+    0x428A2F98D728AE22ll, 0x7137449123EF65CDll, 0xB5C0FBCFEC4D3B2Fll,
+    0xE9B5DBA58189DBBCll, 0x3956C25BF348B538ll, 0x59F111F1B605D019ll,
+    0x923F82A4AF194F9Bll, 0xAB1C5ED5DA6D8118ll, 0xD807AA98A3030242ll,
+    0x12835B0145706FBEll, 0x243185BE4EE4B28Cll, 0x550C7DC3D5FFB4E2ll,
+    0x72BE5D74F27B896Fll, 0x80DEB1FE3B1696B1ll, 0x9BDC06A725C71235ll,
+    0xC19BF174CF692694ll, 0xE49B69C19EF14AD2ll, 0xEFBE4786384F25E3ll,
+    0x0FC19DC68B8CD5B5ll, 0x240CA1CC77AC9C65ll, 0x2DE92C6F592B0275ll,
+    0x4A7484AA6EA6E483ll, 0x5CB0A9DCBD41FBD4ll, 0x76F988DA831153B5ll,
+    0x983E5152EE66DFABll, 0xA831C66D2DB43210ll, 0xB00327C898FB213Fll,
+    0xBF597FC7BEEF0EE4ll, 0xC6E00BF33DA88FC2ll, 0xD5A79147930AA725ll,
+    0x06CA6351E003826Fll, 0x142929670A0E6E70ll, 0x27B70A8546D22FFCll,
+    0x2E1B21385C26C926ll, 0x4D2C6DFC5AC42AEDll, 0x53380D139D95B3DFll,
+    0x650A73548BAF63DEll, 0x766A0ABB3C77B2A8ll, 0x81C2C92E47EDAEE6ll,
+    0x92722C851482353Bll, 0xA2BFE8A14CF10364ll, 0xA81A664BBC423001ll,
+    0xC24B8B70D0F89791ll, 0xC76C51A30654BE30ll, 0xD192E819D6EF5218ll,
+    0xD69906245565A910ll, 0xF40E35855771202All, 0x106AA07032BBD1B8ll,
+    0x19A4C116B8D2D0C8ll, 0x1E376C085141AB53ll, 0x2748774CDF8EEB99ll,
+    0x34B0BCB5E19B48A8ll, 0x391C0CB3C5C95A63ll, 0x4ED8AA4AE3418ACBll,
+    0x5B9CCA4F7763E373ll, 0x682E6FF3D6B2B8A3ll, 0x748F82EE5DEFB2FCll,
+    0x78A5636F43172F60ll, 0x84C87814A1F0AB72ll, 0x8CC702081A6439ECll,
+    0x90BEFFFA23631E28ll, 0xA4506CEBDE82BDE9ll, 0xBEF9A3F7B2C67915ll,
+    0xC67178F2E372532Bll, 0xCA273ECEEA26619Cll, 0xD186B8C721C0C207ll,
+    0xEADA7DD6CDE0EB1Ell, 0xF57D4F7FEE6ED178ll, 0x06F067AA72176FBAll,
+    0x0A637DC5A2C898A6ll, 0x113F9804BEF90DAEll, 0x1B710B35131C471Bll,
+    0x28DB77F523047D84ll, 0x32CAAB7B40C72493ll, 0x3C9EBE0A15C9BEBCll,
+    0x431D67C49C100D4Cll, 0x4CC5D4BECB3E42B6ll, 0x597F299CFC657E2All,
+    0x5FCB6FAB3AD6FAECll, 0x6C44198C4A475817ll
+};
+
+#define SHA512_KERNEL_ROTR(bits,word) \
+  (((word) >> (bits)) | ((word) << (64-(bits))))
+#define SHA512_KERNEL_SIGMA0(word) (SHA512_KERNEL_ROTR(28,word) ^ \
+  SHA512_KERNEL_ROTR(34,word) ^ SHA512_KERNEL_ROTR(39,word))
+#define SHA512_KERNEL_SIGMA1(word) (SHA512_KERNEL_ROTR(14,word) ^ \
+  SHA512_KERNEL_ROTR(18,word) ^ SHA512_KERNEL_ROTR(41,word))
+
+/* Rotation and sigma functions on four 64-bit lanes */
+#define SHA512_AVX2_ROTR(bits,word) _mm256_or_si256( \
+  _mm256_srli_epi64((word), (bits)), _mm256_slli_epi64((word), 64-(bits)))
+#define SHA512_AVX2_sigma0(word) _mm256_xor_si256(_mm256_xor_si256( \
+  SHA512_AVX2_ROTR(1,word), SHA512_AVX2_ROTR(8,word)),              \
+  _mm256_srli_epi64((word), 7))
+#define SHA512_AVX2_sigma1(word) _mm256_xor_si256(_mm256_xor_si256( \
+  SHA512_AVX2_ROTR(19,word), SHA512_AVX2_ROTR(61,word)),            \
+  _mm256_srli_epi64((word), 6))
+
+/*
+ * SHA384_512BlocksAVX2
+ *
+ * Description:
+ *   SHA-384/512 block function expanding the message schedules
+ *   W[t] + K[t] of up to four blocks at once, lane j holding block
+ *   j of the group. Missing blocks of the last group are expanded
+ *   from zeros and ignored.
+ */
+__attribute__((target("avx2")))
+static void SHA384_512BlocksAVX2(uint64_t Intermediate_Hash[8],
+                                 const uint8_t *blocks, size_t count)
+{
+  /* Interleaved schedules, WK[4 * t + j] for block j */
+  uint64_t WK[4 * 80] __attribute__((aligned(32)));
+  uint64_t temp1, temp2, A, B, C, D, E, F, G, H;
+  __m256i W[80];
+  size_t groupCount, j;
+  int t;
+
+  while (count > 0) {
+    groupCount = count < 4 ? count : 4;
+
+    for (t = 0; t < 16; t++) {
+      uint64_t word[4] = { 0, 0, 0, 0 };
+      for (j = 0; j < groupCount; j++) {
+        memcpy(&word[j], blocks + j * SHA512_Message_Block_Size + 8 * t, 8);
+        word[j] = __builtin_bswap64(word[j]);
+      }
+      W[t] = _mm256_set_epi64x((long long)word[3], (long long)word[2],
+                               (long long)word[1], (long long)word[0]);
+    }
+
+    for (t = 16; t < 80; t++)
+      W[t] = _mm256_add_epi64(
+          _mm256_add_epi64(SHA512_AVX2_sigma1(W[t-2]), W[t-7]),
+          _mm256_add_epi64(SHA512_AVX2_sigma0(W[t-15]), W[t-16]));
+
+    for (t = 0; t < 80; t++)
+      _mm256_store_si256((__m256i *)&WK[4 * t], _mm256_add_epi64(W[t],
+          _mm256_set1_epi64x((long long)SHA512_K[t])));
+
+    for (j = 0; j < groupCount; j++) {
+      A = Intermediate_Hash[0];
+      B = Intermediate_Hash[1];
+      C = Intermediate_Hash[2];
+      D = Intermediate_Hash[3];
+      E = Intermediate_Hash[4];
+      F = Intermediate_Hash[5];
+      G = Intermediate_Hash[6];
+      H = Intermediate_Hash[7];
+
+      for (t = 0; t < 80; t++) {
+        temp1 = H + SHA512_KERNEL_SIGMA1(E) + SHA_Ch(E,F,G) + WK[4 * t + j];
+        temp2 = SHA512_KERNEL_SIGMA0(A) + SHA_Maj(A,B,C);
+        H = G;
+        G = F;
+        F = E;
+        E = D + temp1;
+        D = C;
+        C = B;
+        B = A;
+        A = temp1 + temp2;
+      }
+
+      Intermediate_Hash[0] += A;
+      Intermediate_Hash[1] += B;
+      Intermediate_Hash[2] += C;
+      Intermediate_Hash[3] += D;
+      Intermediate_Hash[4] += E;
+      Intermediate_Hash[5] += F;
+      Intermediate_Hash[6] += G;
+      Intermediate_Hash[7] += H;
+    }
+
+    blocks += groupCount * SHA512_Message_Block_Size;
+    count -= groupCount;
+  }
+}
+#endif /* USE_32BIT_ONLY */
+
+/*
+ * SHAKernelsSelect
+ *
+ * Description:
+ *   Selects the kernels supported by the CPU. SHA-NI needs SSSE3 and
+ *   SSE4.1 besides the SHA extensions, while AVX2 and AVX-512 also
+ *   need the operating system to save the YMM and ZMM registers.
+ */
+__attribute__((constructor))
+static void SHAKernelsSelect(void)
+{
+  unsigned int eax, ebx, ecx, edx;
+  unsigned int features1, features7 = 0;
+  int hasYmmState = 0, hasZmmState = 0;
+
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return;
+  features1 = ecx;
+
+  if (__get_cpuid_max(0, NULL) >= 7) {
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    features7 = ebx;
+  }
+
+  if (features1 & bit_OSXSAVE) {
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    hasYmmState = (eax & 6) == 6;
+    hasZmmState = (eax & 0xE6) == 0xE6;
+  }
+
+  if ((features7 & bit_SHA) && (features1 & bit_SSSE3) &&
+      (features1 & bit_SSE4_1))
+    SHA256_Block_Kernel = SHA224_256BlocksSHANI;
+
+  if ((features7 & bit_AVX512F) && hasZmmState) {
+    SHA256_Multi_Block_Kernel = SHA224_256MultiBlockAVX512;
+    SHA256_Multi_Block_Lanes = 16;
+  } else if ((features7 & bit_AVX2) && hasYmmState) {
+    SHA256_Multi_Block_Kernel = SHA224_256MultiBlockAVX2;
+    SHA256_Multi_Block_Lanes = 8;
+  }
+
+#ifndef USE_32BIT_ONLY
+  if ((features7 & bit_AVX2) && hasYmmState)
+    SHA512_Block_Kernel = SHA384_512BlocksAVX2;
+#endif /* USE_32BIT_ONLY */
+}
+
+#elif defined(SHA_KERNELS_ARM)
+
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+
+#if defined(__clang__)
+#define SHA_KERNELS_ARM_TARGET __attribute__((target("crypto")))
+#else
+#define SHA_KERNELS_ARM_TARGET __attribute__((target("+crypto")))
+#endif
+
+/*
+ * SHA224_256BlocksARMv8
+ *
+ * Description:
+ *   SHA-224/256 block function using the ARMv8 Cryptographic
+ *   Extension. Every iteration performs four rounds by SHA256H and
+ *   SHA256H2, while SHA256SU0 and SHA256SU1 advance the message
+ *   schedule.
+ */
+SHA_KERNELS_ARM_TARGET
+static void SHA224_256BlocksARMv8(uint32_t Intermediate_Hash[8],
+                                  const uint8_t *blocks, size_t count)
+{
+  uint32x4_t state0 = vld1q_u32(&Intermediate_Hash[0]);
+  uint32x4_t state1 = vld1q_u32(&Intermediate_Hash[4]);
+  uint32x4_t abcdSave, efghSave, message, temp;
+  uint32x4_t W[4];
+  int i;
+
+  while (count--) {
+    abcdSave = state0;
+    efghSave = state1;
+
+    for (i = 0; i < 4; i++)
+      W[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * i)));
+
+    for (i = 0; i < 16; i++) {
+      message = vaddq_u32(W[i & 3], vld1q_u32(&SHA256_K[4 * i]));
+
+      /* W[t] for the group four groups later */
+      if (i < 12)
+        W[i & 3] = vsha256su0q_u32(W[i & 3], W[(i + 1) & 3]);
+
+      temp = state0;
+      state0 = vsha256hq_u32(state0, state1, message);
+      state1 = vsha256h2q_u32(state1, temp, message);
+
+      if (i < 12)
+        W[i & 3] = vsha256su1q_u32(W[i & 3], W[(i + 2) & 3], W[(i + 3) & 3]);
+    }
+
+    state0 = vaddq_u32(state0, abcdSave);
+    state1 = vaddq_u32(state1, efghSave);
+    blocks += SHA256_Message_Block_Size;
+  }
+
+  vst1q_u32(&Intermediate_Hash[0], state0);
+  vst1q_u32(&Intermediate_Hash[4], state1);
+}
+
+/*
+ * SHAKernelsSelect
+ *
+ * Description:
+ *   Selects the kernels supported by the CPU. Every 64-bit Apple
+ *   CPU implements the Cryptographic Extension.
+ */
+__attribute__((constructor))
+static void SHAKernelsSelect(void)
+{
+#if defined(__linux__)
+  if (getauxval(AT_HWCAP) & HWCAP_SHA2)
+    SHA256_Block_Kernel = SHA224_256BlocksARMv8;
+#else
+  SHA256_Block_Kernel = SHA224_256BlocksARMv8;
+#endif
+}
+
+#endif
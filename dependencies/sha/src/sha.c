@@ -41,20 +41,26 @@
  */
 #include "sha.h"
 #include <stdlib.h>
+#include <string.h>
+
+/*
+ * The largest number of blocks passed to a block function at once,
+ * so that their length in bits fits in 32 bits.
+ */
+#define SHA_Max_Block_Count (1u << 21)
 
 #define SHA1_ROTL(bits,word) \
                 (((word) << (bits)) | ((word) >> (32-(bits))))
 
 /*
  * Add "length" to the length.
- * Set Corrupted when overflow has occurred.
+ * Set Corrupted when overflow has occurred. The carry is detected from the
+ * sum itself, so contexts can be used from several threads at once.
  */
-static uint32_t addTemp;
-#define SHA1AddLength(context, length)                     \
-    (addTemp = (context)->Length_Low,                      \
-     (context)->Corrupted =                                \
-        (((context)->Length_Low += (length)) < addTemp) && \
-        (++(context)->Length_High == 0) ? shaInputTooLong  \
+#define SHA1AddLength(context, length)                           \
+    ((context)->Corrupted =                                      \
+        (((context)->Length_Low += (length)) < (uint32_t)(length)) && \
+        (++(context)->Length_High == 0) ? shaInputTooLong        \
                                         : (context)->Corrupted )
 
 /* Local Function Prototypes */
@@ -471,15 +477,19 @@ static void SHA1PadMessage(SHA1Context *context, uint8_t Pad_Byte)
  * Add "length" to the length.
  * Set Corrupted when overflow has occurred.
  */
-#define SHA224_256AddLength(context, length)               \
-  (addTemp = (context)->Length_Low, (context)->Corrupted = \
-    (((context)->Length_Low += (length)) < addTemp) &&     \
-    (++(context)->Length_High == 0) ? shaInputTooLong :    \
+#define SHA224_256AddLength(context, length)                      \
+  ((context)->Corrupted =                                         \
+    (((context)->Length_Low += (length)) < (uint32_t)(length)) && \
+    (++(context)->Length_High == 0) ? shaInputTooLong :           \
                                       (context)->Corrupted )
 
 /* Local Function Prototypes */
 static int SHA224_256Reset(SHA256Context *context, uint32_t *H0);
 static void SHA224_256ProcessMessageBlock(SHA256Context *context);
+static void SHA224_256ProcessBlock(SHA256Context *context,
+  const uint8_t *Message_Block);
+static void SHA224_256ProcessBlocks(SHA256Context *context,
+  const uint8_t *blocks, size_t count);
 static void SHA224_256Finalize(SHA256Context *context,
   uint8_t Pad_Byte);
 static void SHA224_256PadMessage(SHA256Context *context,
@@ -640,15 +650,37 @@ int SHA256Input(SHA256Context *context, const uint8_t *message_array,
   if (context->Computed) return context->Corrupted = shaStateError;
   if (context->Corrupted) return context->Corrupted;
 
-  while (length--) {
-    context->Message_Block[context->Message_Block_Index++] =
-            *message_array;
-
-    if ((SHA224_256AddLength(context, 8) == shaSuccess) &&
-      (context->Message_Block_Index == SHA256_Message_Block_Size))
-      SHA224_256ProcessMessageBlock(context);
+  while (length > 0) {
+    unsigned int count;
+
+    if ((context->Message_Block_Index == 0) &&
+        (length >= SHA256_Message_Block_Size)) {
+      /* Whole blocks are processed in place. */
+      count = length / SHA256_Message_Block_Size;
+      if (count > SHA_Max_Block_Count) count = SHA_Max_Block_Count;
+
+      if (SHA224_256AddLength(context, 8 * SHA256_Message_Block_Size * count)
+          != shaSuccess)
+        break;
+      SHA224_256ProcessBlocks(context, message_array, count);
+
+      count *= SHA256_Message_Block_Size;
+    } else {
+      count = SHA256_Message_Block_Size - context->Message_Block_Index;
+      if (count > length) count = length;
+
+      memcpy(&context->Message_Block[context->Message_Block_Index],
+             message_array, count);
+      context->Message_Block_Index += count;
+
+      if (SHA224_256AddLength(context, 8 * count) != shaSuccess)
+        break;
+      if (context->Message_Block_Index == SHA256_Message_Block_Size)
+        SHA224_256ProcessMessageBlock(context);
+    }
 
-    message_array++;
+    message_array += count;
+    length -= count;
   }
 
   return context->Corrupted;
@@ -778,13 +810,69 @@ static int SHA224_256Reset(SHA256Context *context, uint32_t *H0)
  *
  * Returns:
  *   Nothing.
+ */
+static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+{
+  SHA224_256ProcessBlocks(context, context->Message_Block, 1);
+  context->Message_Block_Index = 0;
+}
+
+/*
+ * SHA224_256ProcessBlocks
+ *
+ * Description:
+ *   This helper function will process count consecutive 512-bit
+ *   blocks of the message, using the accelerated block function
+ *   when the CPU supports one.
+ *
+ * Parameters:
+ *   context: [in/out]
+ *     The SHA context to update.
+ *   blocks: [in]
+ *     The blocks.
+ *   count: [in]
+ *     The number of blocks.
+ *
+ * Returns:
+ *   Nothing.
+ */
+static void SHA224_256ProcessBlocks(SHA256Context *context,
+  const uint8_t *blocks, size_t count)
+{
+  if (SHA256_Block_Kernel) {
+    SHA256_Block_Kernel(context->Intermediate_Hash, blocks, count);
+    return;
+  }
+
+  while (count--) {
+    SHA224_256ProcessBlock(context, blocks);
+    blocks += SHA256_Message_Block_Size;
+  }
+}
+
+/*
+ * SHA224_256ProcessBlock
+ *
+ * Description:
+ *   This helper function will process a 512-bit block of the
+ *   message with the portable reference code.
+ *
+ * Parameters:
+ *   context: [in/out]
+ *     The SHA context to update.
+ *   Message_Block: [in]
+ *     The block.
+ *
+ * Returns:
+ *   Nothing.
  *
  * Comments:
  *   Many of the variable names in this code, especially the
  *   single character names, were used because those were the
  *   names used in the Secure Hash Standard.
  */
-static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+static void SHA224_256ProcessBlock(SHA256Context *context,
+  const uint8_t *Message_Block)
 {
   /* Constants defined in FIPS 180-3, section 4.2.2 */
   static const uint32_t K[64] = {
@@ -811,10 +899,10 @@ static void SHA224_256ProcessMessageBlock(SHA256Context *context)
    * Initialize the first 16 words in the array W
    */
   for (t = t4 = 0; t < 16; t++, t4 += 4)
-    W[t] = (((uint32_t)context->Message_Block[t4]) << 24) |
-           (((uint32_t)context->Message_Block[t4 + 1]) << 16) |
-           (((uint32_t)context->Message_Block[t4 + 2]) << 8) |
-           (((uint32_t)context->Message_Block[t4 + 3]));
+    W[t] = (((uint32_t)Message_Block[t4]) << 24) |
+           (((uint32_t)Message_Block[t4 + 1]) << 16) |
+           (((uint32_t)Message_Block[t4 + 2]) << 8) |
+           (((uint32_t)Message_Block[t4 + 3]));
            for (t = 16; t < 64; t++)
     W[t] = SHA256_sigma1(W[t-2]) + W[t-7] +
         SHA256_sigma0(W[t-15]) + W[t-16];
@@ -849,8 +937,6 @@ static void SHA224_256ProcessMessageBlock(SHA256Context *context)
   context->Intermediate_Hash[5] += F;
   context->Intermediate_Hash[6] += G;
   context->Intermediate_Hash[7] += H;
-
-  context->Message_Block_Index = 0;
 }
 
 /*
@@ -1233,6 +1319,10 @@ static uint32_t addTemp2[4] = { 0, 0, 0, 0 };
 static int SHA384_512Reset(SHA512Context *context,
                            uint32_t H0[SHA512HashSize/4]);
 static void SHA384_512ProcessMessageBlock(SHA512Context *context);
+static void SHA384_512ProcessBlock(SHA512Context *context,
+  const uint8_t *Message_Block);
+static void SHA384_512ProcessBlocks(SHA512Context *context,
+  const uint8_t *blocks, size_t count);
 static void SHA384_512Finalize(SHA512Context *context,
   uint8_t Pad_Byte);
 static void SHA384_512PadMessage(SHA512Context *context,
@@ -1279,16 +1369,20 @@ static uint32_t SHA512_H0[SHA512HashSize/4] = {
  * Add "length" to the length.
  * Set Corrupted when overflow has occurred.
  */
-#define SHA384_512AddLength(context, length)                   \
-   (addTemp = context->Length_Low, context->Corrupted =        \
-    ((context->Length_Low += length) < addTemp) &&             \
-    (++context->Length_High == 0) ? shaInputTooLong :          \
-                                    (context)->Corrupted)
+#define SHA384_512AddLength(context, length)                      \
+   ((context)->Corrupted =                                        \
+    (((context)->Length_Low += (length)) < (uint64_t)(length)) && \
+    (++(context)->Length_High == 0) ? shaInputTooLong :           \
+                                      (context)->Corrupted)
 
 /* Local Function Prototypes */
 static int SHA384_512Reset(SHA512Context *context,
                            uint64_t H0[SHA512HashSize/8]);
                            static void SHA384_512ProcessMessageBlock(SHA512Context *context);
+static void SHA384_512ProcessBlock(SHA512Context *context,
+  const uint8_t *Message_Block);
+static void SHA384_512ProcessBlocks(SHA512Context *context,
+  const uint8_t *blocks, size_t count);
 static void SHA384_512Finalize(SHA512Context *context,
   uint8_t Pad_Byte);
 static void SHA384_512PadMessage(SHA512Context *context,
@@ -1458,15 +1552,37 @@ int SHA512Input(SHA512Context *context,
   if (context->Computed) return context->Corrupted = shaStateError;
   if (context->Corrupted) return context->Corrupted;
 
-  while (length--) {
-    context->Message_Block[context->Message_Block_Index++] =
-            *message_array;
-
-    if ((SHA384_512AddLength(context, 8) == shaSuccess) &&
-      (context->Message_Block_Index == SHA512_Message_Block_Size))
-      SHA384_512ProcessMessageBlock(context);
+  while (length > 0) {
+    unsigned int count;
+
+    if ((context->Message_Block_Index == 0) &&
+        (length >= SHA512_Message_Block_Size)) {
+      /* Whole blocks are processed in place. */
+      count = length / SHA512_Message_Block_Size;
+      if (count > SHA_Max_Block_Count) count = SHA_Max_Block_Count;
+
+      if (SHA384_512AddLength(context, 8 * SHA512_Message_Block_Size * count)
+          != shaSuccess)
+        break;
+      SHA384_512ProcessBlocks(context, message_array, count);
+
+      count *= SHA512_Message_Block_Size;
+    } else {
+      count = SHA512_Message_Block_Size - context->Message_Block_Index;
+      if (count > length) count = length;
+
+      memcpy(&context->Message_Block[context->Message_Block_Index],
+             message_array, count);
+      context->Message_Block_Index += count;
+
+      if (SHA384_512AddLength(context, 8 * count) != shaSuccess)
+        break;
+      if (context->Message_Block_Index == SHA512_Message_Block_Size)
+        SHA384_512ProcessMessageBlock(context);
+    }
 
-    message_array++;
+    message_array += count;
+    length -= count;
   }
 
   return context->Corrupted;
@@ -1609,6 +1725,63 @@ static int SHA384_512Reset(SHA512Context *context,
  *
  * Returns:
  *   Nothing.
+ */
+static void SHA384_512ProcessMessageBlock(SHA512Context *context)
+{
+  SHA384_512ProcessBlocks(context, context->Message_Block, 1);
+  context->Message_Block_Index = 0;
+}
+
+/*
+ * SHA384_512ProcessBlocks
+ *
+ * Description:
+ *   This helper function will process count consecutive 1024-bit
+ *   blocks of the message, using the accelerated block function
+ *   when the CPU supports one.
+ *
+ * Parameters:
+ *   context: [in/out]
+ *     The SHA context to update.
+ *   blocks: [in]
+ *     The blocks.
+ *   count: [in]
+ *     The number of blocks.
+ *
+ * Returns:
+ *   Nothing.
+ */
+static void SHA384_512ProcessBlocks(SHA512Context *context,
+  const uint8_t *blocks, size_t count)
+{
+#ifndef USE_32BIT_ONLY
+  if (SHA512_Block_Kernel) {
+    SHA512_Block_Kernel(context->Intermediate_Hash, blocks, count);
+    return;
+  }
+#endif /* USE_32BIT_ONLY */
+
+  while (count--) {
+    SHA384_512ProcessBlock(context, blocks);
+    blocks += SHA512_Message_Block_Size;
+  }
+}
+
+/*
+ * SHA384_512ProcessBlock
+ *
+ * Description:
+ *   This helper function will process a 1024-bit block of the
+ *   message with the portable reference code.
+ *
+ * Parameters:
+ *   context: [in/out]
+ *     The SHA context to update.
+ *   Message_Block: [in]
+ *     The block.
+ *
+ * Returns:
+ *   Nothing.
  *
  * Comments:
  *   Many of the variable names in this code, especially the
@@ -1617,7 +1790,8 @@ static int SHA384_512Reset(SHA512Context *context,
  *
  *
  */
-static void SHA384_512ProcessMessageBlock(SHA512Context *context)
+static void SHA384_512ProcessBlock(SHA512Context *context,
+  const uint8_t *Message_Block)
 {
 #ifdef USE_32BIT_ONLY
   /* Constants defined in FIPS 180-3, section 4.2.3 */
@@ -1664,14 +1838,14 @@ static void SHA384_512ProcessMessageBlock(SHA512Context *context)
 
   /* Initialize the first 16 words in the array W */
   for (t = t2 = t8 = 0; t < 16; t++, t8 += 8) {
-    W[t2++] = ((((uint32_t)context->Message_Block[t8    ])) << 24) |
-              ((((uint32_t)context->Message_Block[t8 + 1])) << 16) |
-              ((((uint32_t)context->Message_Block[t8 + 2])) << 8) |
-              ((((uint32_t)context->Message_Block[t8 + 3])));
-    W[t2++] = ((((uint32_t)context->Message_Block[t8 + 4])) << 24) |
-              ((((uint32_t)context->Message_Block[t8 + 5])) << 16) |
-              ((((uint32_t)context->Message_Block[t8 + 6])) << 8) |
-               ((((uint32_t)context->Message_Block[t8 + 7])));
+    W[t2++] = ((((uint32_t)Message_Block[t8    ])) << 24) |
+              ((((uint32_t)Message_Block[t8 + 1])) << 16) |
+              ((((uint32_t)Message_Block[t8 + 2])) << 8) |
+              ((((uint32_t)Message_Block[t8 + 3])));
+    W[t2++] = ((((uint32_t)Message_Block[t8 + 4])) << 24) |
+              ((((uint32_t)Message_Block[t8 + 5])) << 16) |
+              ((((uint32_t)Message_Block[t8 + 6])) << 8) |
+               ((((uint32_t)Message_Block[t8 + 7])));
   }
 
   for (t = 16; t < 80; t++, t2 += 2) {
@@ -1780,14 +1954,14 @@ static void SHA384_512ProcessMessageBlock(SHA512Context *context)
    * Initialize the first 16 words in the array W
    */
   for (t = t8 = 0; t < 16; t++, t8 += 8)
-    W[t] = ((uint64_t)(context->Message_Block[t8  ]) << 56) |
-           ((uint64_t)(context->Message_Block[t8 + 1]) << 48) |
-           ((uint64_t)(context->Message_Block[t8 + 2]) << 40) |
-           ((uint64_t)(context->Message_Block[t8 + 3]) << 32) |
-           ((uint64_t)(context->Message_Block[t8 + 4]) << 24) |
-           ((uint64_t)(context->Message_Block[t8 + 5]) << 16) |
-           ((uint64_t)(context->Message_Block[t8 + 6]) << 8) |
-           ((uint64_t)(context->Message_Block[t8 + 7]));
+    W[t] = ((uint64_t)(Message_Block[t8  ]) << 56) |
+           ((uint64_t)(Message_Block[t8 + 1]) << 48) |
+           ((uint64_t)(Message_Block[t8 + 2]) << 40) |
+           ((uint64_t)(Message_Block[t8 + 3]) << 32) |
+           ((uint64_t)(Message_Block[t8 + 4]) << 24) |
+           ((uint64_t)(Message_Block[t8 + 5]) << 16) |
+           ((uint64_t)(Message_Block[t8 + 6]) << 8) |
+           ((uint64_t)(Message_Block[t8 + 7]));
 
   for (t = 16; t < 80; t++)
     W[t] = SHA512_sigma1(W[t-2]) + W[t-7] +
@@ -1823,8 +1997,6 @@ static void SHA384_512ProcessMessageBlock(SHA512Context *context)
   context->Intermediate_Hash[6] += G;
   context->Intermediate_Hash[7] += H;
 #endif /* USE_32BIT_ONLY */
-
-  context->Message_Block_Index = 0;
 }
 
 /*
@@ -2360,4 +2532,172 @@ SHAResult SHA512_OneCall(const unsigned char* message, size_t messageLength, uns
     SHA512Result(&context, hashResult);
 
   return shaSuccess;
-}
\ No newline at end of file
+}
+/*
+ * SHA224_256LoadLane
+ *
+ * Description:
+ *   Starts hashing a message in a lane of SHA224_256_MultiCall: the
+ *   intermediate hash of the lane is reset, and the padded tail of
+ *   the message, one or two blocks, is built in Final_Blocks.
+ */
+static void SHA224_256LoadLane(uint32_t *Intermediate_Hashes, int lanes,
+                               int lane, const uint32_t *H0,
+                               const unsigned char *message, size_t length,
+                               uint8_t *Final_Blocks, size_t *Whole_Blocks,
+                               size_t *Total_Blocks)
+{
+  size_t remainder = length % SHA256_Message_Block_Size;
+  uint64_t bitLength = (uint64_t)length << 3;
+  int i;
+
+  for (i = 0; i < SHA256HashSize/4; i++)
+    Intermediate_Hashes[i * lanes + lane] = H0[i];
+
+  *Whole_Blocks = length / SHA256_Message_Block_Size;
+  *Total_Blocks = *Whole_Blocks +
+      ((remainder + 9 <= SHA256_Message_Block_Size) ? 1 : 2);
+
+  memset(Final_Blocks, 0, 2 * SHA256_Message_Block_Size);
+  if (remainder)
+    memcpy(Final_Blocks,
+           message + *Whole_Blocks * SHA256_Message_Block_Size, remainder);
+  Final_Blocks[remainder] = 0x80;
+
+  /* The message length in bits ends the last block */
+  for (i = 0; i < 8; i++)
+    Final_Blocks[(*Total_Blocks - *Whole_Blocks) * SHA256_Message_Block_Size
+                 - 1 - i] = (uint8_t)(bitLength >> 8 * i);
+}
+
+/*
+ * SHA224_256_MultiCall
+ *
+ * Description:
+ *   Computes the SHA-224 or SHA-256 digests of messageCount
+ *   independent messages. With a multi-buffer block function, every
+ *   lane hashes one message at a time, and is handed the next
+ *   message as soon as its current one is complete, so messages of
+ *   different lengths keep the lanes busy. Lanes without a message
+ *   process a block of zeros, which is ignored. Without a
+ *   multi-buffer block function the messages are hashed one by one.
+ *
+ * Parameters:
+ *   whichSha: [in]
+ *     SHA224 or SHA256.
+ *   messages: [in]
+ *     The messages.
+ *   messageLengths: [in]
+ *     The lengths of the messages in octets.
+ *   messageCount: [in]
+ *     The number of messages.
+ *   hashResults: [out]
+ *     Where the digests are returned.
+ *
+ * Returns:
+ *   sha Error Code.
+ */
+SHAResult SHA224_256_MultiCall(SHAversion whichSha,
+                               const unsigned char *const *messages,
+                               const size_t *messageLengths,
+                               size_t messageCount,
+                               unsigned char *const *hashResults)
+{
+  static const uint8_t Idle_Block[SHA256_Message_Block_Size] = { 0 };
+  uint32_t Intermediate_Hashes[SHA256HashSize/4 * SHA256_Max_Multi_Block_Lanes];
+  uint8_t Final_Blocks[SHA256_Max_Multi_Block_Lanes]
+                      [2 * SHA256_Message_Block_Size];
+  const uint8_t *blocks[SHA256_Max_Multi_Block_Lanes];
+  size_t message[SHA256_Max_Multi_Block_Lanes];
+  size_t block[SHA256_Max_Multi_Block_Lanes];
+  size_t Whole_Blocks[SHA256_Max_Multi_Block_Lanes];
+  size_t Total_Blocks[SHA256_Max_Multi_Block_Lanes];
+  int isActive[SHA256_Max_Multi_Block_Lanes];
+  const SHA256MultiBlockKernel kernel = SHA256_Multi_Block_Kernel;
+  const int lanes = SHA256_Multi_Block_Lanes;
+  uint32_t *H0;
+  int hashSize, activeLanes = 0, lane, i;
+  size_t next = 0;
+
+  switch (whichSha) {
+    case SHA224: H0 = SHA224_H0; hashSize = SHA224HashSize; break;
+    case SHA256: H0 = SHA256_H0; hashSize = SHA256HashSize; break;
+    default: return shaBadParam;
+  }
+
+  if (messageCount == 0) return shaSuccess;
+  if (!messages || !messageLengths || !hashResults) return shaNull;
+
+  if (!kernel || lanes < 2 || messageCount < 2) {
+    for (next = 0; next < messageCount; next++) {
+      const unsigned char *bytes = messages[next];
+      size_t remaining = messageLengths[next];
+      SHA256Context context;
+
+      SHA224_256Reset(&context, H0);
+      while (remaining > 0) {
+        unsigned int length = remaining > SHA256_Message_Block_Size *
+            SHA_Max_Block_Count ? SHA256_Message_Block_Size *
+            SHA_Max_Block_Count : (unsigned int)remaining;
+        SHA256Input(&context, bytes, length);
+        bytes += length;
+        remaining -= length;
+      }
+      SHA224_256ResultN(&context, hashResults[next], hashSize);
+    }
+
+    return shaSuccess;
+  }
+
+  for (lane = 0; lane < lanes; lane++) {
+    isActive[lane] = next < messageCount;
+    if (isActive[lane]) {
+      message[lane] = next++;
+      block[lane] = 0;
+      SHA224_256LoadLane(Intermediate_Hashes, lanes, lane, H0,
+                         messages[message[lane]],
+                         messageLengths[message[lane]], Final_Blocks[lane],
+                         &Whole_Blocks[lane], &Total_Blocks[lane]);
+      activeLanes++;
+    }
+  }
+
+  while (activeLanes > 0) {
+    for (lane = 0; lane < lanes; lane++) {
+      if (!isActive[lane])
+        blocks[lane] = Idle_Block;
+      else if (block[lane] < Whole_Blocks[lane])
+        blocks[lane] = messages[message[lane]] +
+                       block[lane] * SHA256_Message_Block_Size;
+      else
+        blocks[lane] = Final_Blocks[lane] +
+            (block[lane] - Whole_Blocks[lane]) * SHA256_Message_Block_Size;
+    }
+
+    kernel(Intermediate_Hashes, blocks);
+
+    for (lane = 0; lane < lanes; lane++) {
+      if (!isActive[lane] || ++block[lane] < Total_Blocks[lane])
+        continue;
+
+      for (i = 0; i < hashSize; ++i)
+        hashResults[message[lane]][i] = (uint8_t)
+          (Intermediate_Hashes[(i >> 2) * lanes + lane] >>
+           8 * (3 - (i & 0x03)));
+
+      isActive[lane] = next < messageCount;
+      if (isActive[lane]) {
+        message[lane] = next++;
+        block[lane] = 0;
+        SHA224_256LoadLane(Intermediate_Hashes, lanes, lane, H0,
+                           messages[message[lane]],
+                           messageLengths[message[lane]], Final_Blocks[lane],
+                           &Whole_Blocks[lane], &Total_Blocks[lane]);
+      } else {
+        activeLanes--;
+      }
+    }
+  }
+
+  return shaSuccess;
+}
@@ -5,6 +5,7 @@
 
 #include "elliptic/AffinePoint.h"
 #include "elliptic/EllipticCurve.h"
+#include "elliptic/FixedBaseTable.h"
 #include "elliptic/TatePairing.h"
 #include "util/HashFunction.h"
 
@@ -16,9 +17,22 @@ typedef struct bswCiphertextPolicyAttributeBasedEncryptionPublicKey {
   Complex eggalpha;            // e(g, g)^alpha
   HashFunction hashFunction;
   mpz_t q;
+  FixedBaseTable *gTable; // precomputed multiples of g, or NULL
 } bswCiphertextPolicyAttributeBasedEncryptionPublicKey;
 
 void bswCiphertextPolicyAttributeBasedEncryptionPublicKey_destroy(
     bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey);
 
+// Builds the fixed-base table of g (if not built yet), so that subsequent
+// multiplications of g are cheaper
+void bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+    bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey);
+
+// Computes [s]g, using the fixed-base table of g if it is available
+CryptidStatus
+bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+    AffinePoint *result,
+    const bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey,
+    const mpz_t s);
+
 #endif
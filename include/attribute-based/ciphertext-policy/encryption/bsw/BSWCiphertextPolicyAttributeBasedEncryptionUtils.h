@@ -17,7 +17,7 @@ int Lagrange_coefficient(const int xi, const int *s, const int sLength,
 
 char *concat(const char *s1, const char *s2);
 
-void bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
+CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
     mpz_t randElement,
     const bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey);
 
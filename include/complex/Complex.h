@@ -30,6 +30,44 @@ typedef struct Complex {
   mpz_t imaginary;
 } Complex;
 
+/**
+ * ## Description
+ *
+ * Temporaries used by the {@code *Into} functions, so that repeated
+ * operations, such as the ones in a Miller loop, do not allocate. A scratch
+ * instance can be reused by any number of calls, but must not be shared by
+ * concurrent ones.
+ */
+typedef struct ComplexScratch {
+  /**
+   * ## Description
+   *
+   * The first temporary.
+   */
+  mpz_t t0;
+
+  /**
+   * ## Description
+   *
+   * The second temporary.
+   */
+  mpz_t t1;
+
+  /**
+   * ## Description
+   *
+   * The third temporary.
+   */
+  mpz_t t2;
+
+  /**
+   * ## Description
+   *
+   * The fourth temporary.
+   */
+  mpz_t t3;
+} ComplexScratch;
+
 /**
  * ## Description
  *
@@ -195,6 +233,25 @@ void complex_modAdd(Complex *sum, const Complex augend, const Complex addend,
 void complex_additiveInverse(Complex *inverse, const Complex operand,
                              const mpz_t modulus);
 
+/**
+ * ## Description
+ *
+ * Calculates the conjugate of the specified Complex with respect to the
+ * specified modulus. For \f$p \equiv 3 \pmod 4\f$ this is the Frobenius map
+ * \f$z \mapsto z^p\f$ of \f$F_p^2\f$.
+ *
+ * ## Parameters
+ *
+ *   * conjugate
+ *     * The conjugate.
+ *   * operand
+ *     * The Complex to conjugate.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_conjugate(Complex *conjugate, const Complex operand,
+                       const mpz_t modulus);
+
 /**
  * ## Description
  *
@@ -233,6 +290,24 @@ void complex_modAddInteger(Complex *sum, const Complex augend,
 void complex_modMul(Complex *product, const Complex multiplier,
                     const Complex multiplicand, const mpz_t modulus);
 
+/**
+ * ## Description
+ *
+ * Squares a Complex value with respect to the specified modulus. Cheaper
+ * than multiplying the value by itself.
+ *
+ * ## Parameters
+ *
+ *   * square
+ *     * The result of the squaring.
+ *   * operand
+ *     * The complex number to be squared.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_modSquare(Complex *square, const Complex operand,
+                       const mpz_t modulus);
+
 /**
  * ## Description
  *
@@ -295,4 +370,248 @@ CryptidStatus complex_multiplicativeInverse(Complex *inverse,
                                             const Complex operand,
                                             const mpz_t modulus);
 
+/**
+ * ## Description
+ *
+ * Initializes the temporaries of a scratch.
+ *
+ * ## Parameters
+ *
+ *   * scratchOutput
+ *     * The scratch to be initialized. This should be destroyed by the caller.
+ */
+void complex_initScratch(ComplexScratch *scratchOutput);
+
+/**
+ * ## Description
+ *
+ * Frees the temporaries of a scratch.
+ *
+ * ## Parameters
+ *
+ *   * scratch
+ *     * The scratch to be destroyed.
+ */
+void complex_destroyScratch(ComplexScratch scratch);
+
+/**
+ * ## Description
+ *
+ * Copies a Complex into an already initialized one.
+ *
+ * ## Parameters
+ *
+ *   * destination
+ *     * The initialized Complex to overwrite.
+ *   * source
+ *     * The Complex to copy.
+ */
+void complex_set(Complex *destination, const Complex source);
+
+/**
+ * ## Description
+ *
+ * Sets an already initialized Complex to the specified value.
+ *
+ * ## Parameters
+ *
+ *   * destination
+ *     * The initialized Complex to overwrite.
+ *   * real
+ *     * The real part.
+ *   * imaginary
+ *     * The imaginary part.
+ */
+void complex_setLong(Complex *destination, const long real,
+                     const long imaginary);
+
+/**
+ * ## Description
+ *
+ * Same as complex_modAdd, but stores the result in an already initialized
+ * Complex, which may be the same as any of the operands.
+ *
+ * ## Parameters
+ *
+ *   * sum
+ *     * The initialized Complex receiving the result of the addition.
+ *   * augend
+ *     * The complex number to which the addend is added.
+ *   * addend
+ *     * The complex number that is added to the augend.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_modAddInto(Complex *sum, const Complex augend,
+                        const Complex addend, const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Subtracts two Complex values with respect to the specified modulus, storing
+ * the result in an already initialized Complex, which may be the same as any
+ * of the operands.
+ *
+ * ## Parameters
+ *
+ *   * difference
+ *     * The initialized Complex receiving the result of the subtraction.
+ *   * minuend
+ *     * The complex number from which the subtrahend is subtracted.
+ *   * subtrahend
+ *     * The complex number that is subtracted from the minuend.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_modSubInto(Complex *difference, const Complex minuend,
+                        const Complex subtrahend, const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Same as complex_additiveInverse, but stores the result in an already
+ * initialized Complex, which may be the same as the operand.
+ *
+ * ## Parameters
+ *
+ *   * inverse
+ *     * The initialized Complex receiving the additive inverse.
+ *   * operand
+ *     * The Complex to invert.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_additiveInverseInto(Complex *inverse, const Complex operand,
+                                 const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Same as complex_conjugate, but stores the result in an already initialized
+ * Complex, which may be the same as the operand.
+ *
+ * ## Parameters
+ *
+ *   * conjugate
+ *     * The initialized Complex receiving the conjugate.
+ *   * operand
+ *     * The Complex to conjugate.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_conjugateInto(Complex *conjugate, const Complex operand,
+                           const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Same as complex_modAddInteger, but stores the result in an already
+ * initialized Complex, which may be the same as the augend.
+ *
+ * ## Parameters
+ *
+ *   * sum
+ *     * The initialized Complex receiving the result of the addition.
+ *   * augend
+ *     * The complex number to which the addend is added.
+ *   * addend
+ *     * The integer number that is added to the augend.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_modAddIntegerInto(Complex *sum, const Complex augend,
+                               const mpz_t addend, const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Same as complex_modMul, but stores the result in an already initialized
+ * Complex, which may be the same as any of the operands.
+ *
+ * ## Parameters
+ *
+ *   * product
+ *     * The initialized Complex receiving the result of the multiplication.
+ *   * multiplier
+ *     * The complex number to multiply with.
+ *   * multiplicand
+ *     * The complex number to be multiplied by the multiplier.
+ *   * modulus
+ *     * The modulus.
+ *   * scratch
+ *     * The temporaries to use.
+ */
+void complex_modMulInto(Complex *product, const Complex multiplier,
+                        const Complex multiplicand, const mpz_t modulus,
+                        ComplexScratch *scratch);
+
+/**
+ * ## Description
+ *
+ * Same as complex_modSquare, but stores the result in an already initialized
+ * Complex, which may be the same as the operand.
+ *
+ * ## Parameters
+ *
+ *   * square
+ *     * The initialized Complex receiving the result of the squaring.
+ *   * operand
+ *     * The complex number to be squared.
+ *   * modulus
+ *     * The modulus.
+ *   * scratch
+ *     * The temporaries to use.
+ */
+void complex_modSquareInto(Complex *square, const Complex operand,
+                           const mpz_t modulus, ComplexScratch *scratch);
+
+/**
+ * ## Description
+ *
+ * Same as complex_modMulInteger, but stores the result in an already
+ * initialized Complex, which may be the same as the multiplicand.
+ *
+ * ## Parameters
+ *
+ *   * product
+ *     * The initialized Complex receiving the result of the multiplication.
+ *   * multiplier
+ *     * The integer number to multiply with.
+ *   * multiplicand
+ *     * The complex number to be multiplied by the multiplier.
+ *   * modulus
+ *     * The modulus.
+ */
+void complex_modMulIntegerInto(Complex *product, const mpz_t multiplier,
+                               const Complex multiplicand,
+                               const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Same as complex_multiplicativeInverse, but stores the result in an already
+ * initialized Complex, which may be the same as the operand.
+ *
+ * ## Parameters
+ *
+ *   * inverse
+ *     * The initialized Complex receiving the multiplicative inverse. It is
+ * left unchanged if the return value is not CRYPTID_SUCCESS.
+ *   * operand
+ *     * The Complex to invert.
+ *   * modulus
+ *     * The modulus.
+ *   * scratch
+ *     * The temporaries to use.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if complex has a multiplicative inverse, HAS_NO_MUL_INV error
+ * otherwise.
+ */
+CryptidStatus complex_multiplicativeInverseInto(Complex *inverse,
+                                                const Complex operand,
+                                                const mpz_t modulus,
+                                                ComplexScratch *scratch);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef __CRYPTID_CYCLOTOMIC_H
+#define __CRYPTID_CYCLOTOMIC_H
+
+#include "gmp.h"
+
+#include "complex/Complex.h"
+#include "util/MontgomeryField.h"
+
+/**
+ * ## Description
+ *
+ * The width of the NAF recoding used by cyclotomic_pow and
+ * cyclotomic_powMontgomery. The table holds the \f$2^{w - 2}\f$ odd powers
+ * \f$g, g^3, \ldots, g^{2^{w-1} - 1}\f$.
+ */
+#define CYCLOTOMIC_WINDOW_WIDTH 5
+
+/**
+ * ## Description
+ *
+ * The number of \f$F_p\f$ elements of the scratch of cyclotomic_powMontgomery:
+ * the table of odd powers and that of their inverses, the square of the base,
+ * and five temporaries.
+ */
+#define CYCLOTOMIC_POW_SCRATCH_ELEMENT_COUNT                                   \
+  (2 * (2 * (1 << (CYCLOTOMIC_WINDOW_WIDTH - 2)) + 1) + 5)
+
+/**
+ * ## Description
+ *
+ * Arithmetic of the cyclotomic subgroup of \f$F_p^2\f$, that is the subgroup
+ * of order \f$p + 1\f$ consisting of the elements of norm
+ * \f$a^2 + b^2 = 1\f$. Every output of the modified Tate pairing with
+ * embedding degree 2 lies in this subgroup (the group \f$G_T\f$), which makes
+ * inversion a conjugation and squaring two \f$F_p\f$ squarings.
+ *
+ * The functions below expect their Complex operands to lie in the subgroup,
+ * the result is unspecified for any other value.
+ */
+
+/**
+ * ## Description
+ *
+ * Squares an element of the cyclotomic subgroup as
+ * \f$(a + bi)^2 = (2a^2 - 1) + ((a + b)^2 - 1)i\f$.
+ *
+ * ## Parameters
+ *
+ *   * square
+ *     * The result of the squaring.
+ *   * operand
+ *     * The element to square.
+ *   * modulus
+ *     * The modulus.
+ */
+void cyclotomic_square(Complex *square, const Complex operand,
+                       const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Calculates the inverse of an element of the cyclotomic subgroup, which is
+ * its conjugate.
+ *
+ * ## Parameters
+ *
+ *   * inverse
+ *     * The multiplicative inverse.
+ *   * operand
+ *     * The element to invert.
+ *   * modulus
+ *     * The modulus.
+ */
+void cyclotomic_inverse(Complex *inverse, const Complex operand,
+                        const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Raises an element of the cyclotomic subgroup to the specified exponent
+ * using the window NAF method. The negative digits of the recoding are
+ * served by the conjugates of the precomputed powers, so negative exponents
+ * are supported at no extra cost. The exponentiation runs in Montgomery
+ * representation, see cyclotomic_powMontgomery.
+ *
+ * ## Parameters
+ *
+ *   * power
+ *     * The result of the exponentiation.
+ *   * base
+ *     * The base of the exponentiation.
+ *   * exponent
+ *     * The exponent of the exponentiation, may be negative.
+ *   * modulus
+ *     * The modulus.
+ */
+void cyclotomic_pow(Complex *power, const Complex base, const mpz_t exponent,
+                    const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Raises an element of the cyclotomic subgroup to the specified exponent like
+ * cyclotomic_pow, where both the base and the power are in the Montgomery
+ * representation of a
+ * [MontgomeryField](codebase://util/MontgomeryField.h#MontgomeryField). An
+ * element of \f$F_p^2\f$ is stored as 2 * limbCount limbs, the real part
+ * followed by the imaginary part.
+ *
+ * The table and the temporaries live in the scratch of the caller. For
+ * exponents shorter than the modulus of the highest security level, the NAF
+ * digits are kept in automatic storage, so the exponentiation allocates no
+ * memory.
+ *
+ * ## Parameters
+ *
+ *   * power
+ *     * The result of the exponentiation. May be the same as base.
+ *   * base
+ *     * The base of the exponentiation.
+ *   * exponent
+ *     * The exponent of the exponentiation, may be negative.
+ *   * scratch
+ *     * Room for CYCLOTOMIC_POW_SCRATCH_ELEMENT_COUNT elements, overlapping
+ * neither the base nor the power.
+ *   * field
+ *     * The field \f$F_p\f$. Its conversion temporary is overwritten.
+ */
+void cyclotomic_powMontgomery(mp_limb_t *power, const mp_limb_t *base,
+                              const mpz_t exponent, mp_limb_t *scratch,
+                              MontgomeryField *field);
+
+#endif
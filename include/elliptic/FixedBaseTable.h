@@ -0,0 +1,115 @@
+#ifndef __CRYPTID_FIXEDBASETABLE_H
+#define __CRYPTID_FIXEDBASETABLE_H
+
+#include <stddef.h>
+
+#include "gmp.h"
+
+#include "elliptic/AffinePoint.h"
+#include "elliptic/EllipticCurve.h"
+#include "elliptic/JacobianPoint.h"
+#include "util/Status.h"
+
+/**
+ * ## Description
+ *
+ * Precomputed comb table for scalar multiplication with a fixed base point.
+ * Building the table costs about as much as a single
+ * [affine_wNAFMultiply](codebase://elliptic/AffinePoint.h#affine_wNAFMultiply),
+ * after which every multiplication needs only
+ * \f$\lceil \frac{t}{w} \rceil\f$ doublings and additions, where \f$t\f$ is
+ * the bitlength of the order of the base point and \f$w\f$ is the width of
+ * the comb.
+ */
+typedef struct FixedBaseTable {
+  /**
+   * ## Description
+   *
+   * The order of the base point. Scalars are reduced modulo this value.
+   */
+  mpz_t order;
+
+  /**
+   * ## Description
+   *
+   * The width of the comb (number of teeth) \f$w\f$.
+   */
+  size_t width;
+
+  /**
+   * ## Description
+   *
+   * The distance of the teeth of the comb \f$d = \lceil \frac{t}{w}
+   * \rceil\f$.
+   */
+  size_t spacing;
+
+  /**
+   * ## Description
+   *
+   * The \f$2^w\f$ precomputed points. The point with index
+   * \f$(a_{w-1}, \ldots, a_0)_2\f$ is
+   * \f$a_{w-1}2^{(w-1)d}P + \ldots + a_12^dP + a_0P\f$. The points are
+   * normalized and in the Montgomery representation of the field of the curve.
+   */
+  JacobianPoint *points;
+} FixedBaseTable;
+
+/**
+ * ## Description
+ *
+ * Precomputes the comb table of a base point.
+ *
+ * ## Parameters
+ *
+ *   * tableOutput
+ *     * The table to be initialized. This should be destroyed by the caller.
+ *   * base
+ *     * The fixed base point.
+ *   * order
+ *     * The order of the base point.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate over.
+ */
+void fixedBase_init(FixedBaseTable *tableOutput, const AffinePoint base,
+                    const mpz_t order, const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Frees a FixedBaseTable.
+ *
+ * ## Parameters
+ *
+ *   * table
+ *     * The table to be destroyed.
+ */
+void fixedBase_destroy(FixedBaseTable table);
+
+/**
+ * ## Description
+ *
+ * Multiplies the base point of the table with a scalar using the fixed-base
+ * comb method.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The result of the multiplication. On CRYPTID_SUCCESS, this should be
+ * destroyed by the caller.
+ *   * table
+ *     * The precomputed table of the base point.
+ *   * s
+ *     * The scalar to multiply with.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate over.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, error otherwise.
+ */
+CryptidStatus fixedBase_multiply(AffinePoint *result,
+                                 const FixedBaseTable table, const mpz_t s,
+                                 const EllipticCurve ellipticCurve);
+
+#endif
@@ -0,0 +1,322 @@
+#ifndef __CRYPTID_JACOBIANPOINT_H
+#define __CRYPTID_JACOBIANPOINT_H
+
+#include <stddef.h>
+
+#include "gmp.h"
+
+#include "elliptic/AffinePoint.h"
+#include "elliptic/EllipticCurve.h"
+#include "util/MontgomeryField.h"
+
+/**
+ * ## Description
+ *
+ * An elliptic curve prepared for the arithmetic of JacobianPoints: its field
+ * \f$F_p\f$ in Montgomery representation, the coefficient \f$a\f$ and the
+ * temporaries of the group operations.
+ *
+ * As it holds temporaries, an instance must not be used by concurrent calls.
+ */
+typedef struct JacobianCurve {
+  /**
+   * ## Description
+   *
+   * The field \f$F_p\f$ of the curve.
+   */
+  MontgomeryField field;
+
+  /**
+   * ## Description
+   *
+   * The coefficient \f$a\f$ of the curve, in Montgomery representation.
+   */
+  mp_limb_t *a;
+
+  /**
+   * ## Description
+   *
+   * \f$1\f$ in Montgomery representation.
+   */
+  mp_limb_t *one;
+
+  /**
+   * ## Description
+   *
+   * The temporaries of the group operations.
+   */
+  mp_limb_t *temporaries;
+} JacobianCurve;
+
+/**
+ * ## Description
+ *
+ * Represents a point in Jacobian projective coordinates. The triple
+ * \f$(X, Y, Z)\f$ corresponds to the affine point
+ * \f$(\frac{X}{Z^2}, \frac{Y}{Z^3})\f$, the point at infinity has \f$Z = 0\f$.
+ * The coordinates are elements of the field of a JacobianCurve, so the group
+ * operations need neither a modular inversion nor a division.
+ *
+ * Unlike AffinePoint arithmetic, the group operations on JacobianPoints do not
+ * require modular inversions, therefore they should be used for long chains
+ * of additions and doublings, converting back to affine form only at the end.
+ *
+ * A point is normalized if \f$Z = 1\f$ or it is the point at infinity. Mixed
+ * additions take a normalized operand.
+ *
+ * Every function of this module expects its output to be already initialized
+ * and allows it to alias any of the inputs.
+ */
+typedef struct JacobianPoint {
+  /**
+   * ## Description
+   *
+   * The \f$X\f$ coordinate, in Montgomery representation. The limbs of the
+   * other coordinates follow it.
+   */
+  mp_limb_t *x;
+
+  /**
+   * ## Description
+   *
+   * The \f$Y\f$ coordinate, in Montgomery representation.
+   */
+  mp_limb_t *y;
+
+  /**
+   * ## Description
+   *
+   * The \f$Z\f$ coordinate, in Montgomery representation.
+   */
+  mp_limb_t *z;
+} JacobianPoint;
+
+/**
+ * ## Description
+ *
+ * Initializes a new JacobianCurve for the specified elliptic curve.
+ *
+ * ## Parameters
+ *
+ *   * curveOutput
+ *     * The JacobianCurve to be initialized. This should be destroyed by the
+ * caller.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate over.
+ */
+void jacobian_initCurve(JacobianCurve *curveOutput,
+                        const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Frees a JacobianCurve.
+ *
+ * ## Parameters
+ *
+ *   * curve
+ *     * The JacobianCurve to be destroyed.
+ */
+void jacobian_destroyCurve(JacobianCurve curve);
+
+/**
+ * ## Description
+ *
+ * Initializes a new JacobianPoint to the point at infinity.
+ *
+ * ## Parameters
+ *
+ *   * jacobianPointOutput
+ *     * The JacobianPoint to be initialized.
+ *   * curve
+ *     * The curve of the point.
+ */
+void jacobian_initInfinity(JacobianPoint *jacobianPointOutput,
+                           const JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Initializes a new normalized JacobianPoint representing the specified
+ * AffinePoint.
+ *
+ * ## Parameters
+ *
+ *   * jacobianPointOutput
+ *     * The JacobianPoint to be initialized.
+ *   * affinePoint
+ *     * The point to convert.
+ *   * curve
+ *     * The curve of the point.
+ */
+void jacobian_initFromAffine(JacobianPoint *jacobianPointOutput,
+                             const AffinePoint affinePoint,
+                             JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Frees a JacobianPoint.
+ *
+ * ## Parameters
+ *
+ *   * jacobianPoint
+ *     * The JacobianPoint to be destroyed.
+ */
+void jacobian_destroy(JacobianPoint jacobianPoint);
+
+/**
+ * ## Description
+ *
+ * Copies the coordinates of a JacobianPoint into another, initialized one.
+ *
+ * ## Parameters
+ *
+ *   * destination
+ *     * The JacobianPoint to overwrite.
+ *   * source
+ *     * The JacobianPoint to copy.
+ *   * curve
+ *     * The curve of the points.
+ */
+void jacobian_set(JacobianPoint *destination, const JacobianPoint source,
+                  const JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Checks if the specified JacobianPoint is the point at infinity.
+ *
+ * ## Parameters
+ *
+ *   * jacobianPoint
+ *     * The point to check.
+ *   * curve
+ *     * The curve of the point.
+ *
+ * ## Return Value
+ *
+ * 1 if the specified point is the infinity point, 0 otherwise.
+ */
+int jacobian_isInfinity(const JacobianPoint jacobianPoint,
+                        const JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Converts a JacobianPoint to affine coordinates. Requires a single modular
+ * inversion.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The affine representation of the point. This should be destroyed by
+ * the caller. Initialization is done by this function.
+ *   * jacobianPoint
+ *     * The point to convert.
+ *   * curve
+ *     * The curve of the point.
+ */
+void jacobian_toAffine(AffinePoint *result, const JacobianPoint jacobianPoint,
+                       JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Normalizes multiple JacobianPoints in place at the cost of a single modular
+ * inversion, using Montgomery's simultaneous inversion trick.
+ *
+ * ## Parameters
+ *
+ *   * jacobianPoints
+ *     * The points to normalize.
+ *   * count
+ *     * The number of points to normalize.
+ *   * curve
+ *     * The curve of the points.
+ */
+void jacobian_normalizeMany(JacobianPoint *jacobianPoints, const size_t count,
+                            JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Negates the specified JacobianPoint.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The result of the operation. Must be initialized, may alias
+ * {@code jacobianPoint}.
+ *   * jacobianPoint
+ *     * The point to negate.
+ *   * curve
+ *     * The curve of the point.
+ */
+void jacobian_negate(JacobianPoint *result, const JacobianPoint jacobianPoint,
+                     const JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Doubles the specified JacobianPoint.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The result of the operation. Must be initialized, may alias
+ * {@code jacobianPoint}.
+ *   * jacobianPoint
+ *     * The point to double.
+ *   * curve
+ *     * The curve of the point.
+ */
+void jacobian_double(JacobianPoint *result, const JacobianPoint jacobianPoint,
+                     JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Adds two JacobianPoints.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The result of the addition. Must be initialized, may alias any of the
+ * operands.
+ *   * jacobianPoint1
+ *     * A JacobianPoint.
+ *   * jacobianPoint2
+ *     * A JacobianPoint.
+ *   * curve
+ *     * The curve of the points.
+ */
+void jacobian_add(JacobianPoint *result, const JacobianPoint jacobianPoint1,
+                  const JacobianPoint jacobianPoint2, JacobianCurve *curve);
+
+/**
+ * ## Description
+ *
+ * Adds a normalized JacobianPoint to a JacobianPoint (mixed addition). This is
+ * cheaper than a full Jacobian addition, because the \f$Z\f$ coordinate of the
+ * normalized operand is known to be \f$1\f$.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The result of the addition. Must be initialized, may alias any of the
+ * operands.
+ *   * jacobianPoint
+ *     * A JacobianPoint.
+ *   * normalizedPoint
+ *     * A normalized JacobianPoint, see jacobian_initFromAffine and
+ * jacobian_normalizeMany.
+ *   * curve
+ *     * The curve of the points.
+ */
+void jacobian_addNormalized(JacobianPoint *result,
+                            const JacobianPoint jacobianPoint,
+                            const JacobianPoint normalizedPoint,
+                            JacobianCurve *curve);
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef __CRYPTID_TATEPAIRING_H
 #define __CRYPTID_TATEPAIRING_H
 
+#include <stddef.h>
+
 #include "gmp.h"
 
 #include "complex/Complex.h"
@@ -9,6 +11,76 @@
 #include "elliptic/EllipticCurve.h"
 #include "util/Status.h"
 
+/**
+ * ## Description
+ *
+ * Values used by the Tate pairing which only depend on the elliptic curve, the
+ * embedding degree and the subgroup order. Computing these once and reusing
+ * them saves a modular exponentiation (and a few big integer divisions) per
+ * pairing.
+ */
+typedef struct TatePairingPrecomputation {
+  /**
+   * ## Description
+   *
+   * The \f$\xi\f$ value of the distortion map, that is \f$\xi = \frac{p -
+   * 1}{2}(1 + 3^{\frac{p + 1}{4}}i)\f$.
+   */
+  Complex xi;
+
+  /**
+   * ## Description
+   *
+   * The embedding degree \f$k\f$ of the curve.
+   */
+  int embeddingDegree;
+
+  /**
+   * ## Description
+   *
+   * The exponent of the final exponentiation. For \f$k = 2\f$ only the hard
+   * part \f$\frac{p + 1}{q}\f$ is stored, as the easy part \f$p - 1\f$ is
+   * computed by a conjugation and an inversion, otherwise this is
+   * \f$\frac{p^k - 1}{q}\f$.
+   */
+  mpz_t finalExponent;
+} TatePairingPrecomputation;
+
+/**
+ * ## Description
+ *
+ * Initializes a new TatePairingPrecomputation for the specified curve and
+ * subgroup.
+ *
+ * ## Parameters
+ *
+ *   * precomputationOutput
+ *     * The TatePairingPrecomputation to be initialized.
+ *   * embeddingDegree
+ *     * The embedding degree of the curve.
+ *   * subgroupOrder
+ *     * The order of the subgroup.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ */
+void tate_initPrecomputation(TatePairingPrecomputation *precomputationOutput,
+                             const int embeddingDegree,
+                             const mpz_t subgroupOrder,
+                             const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Frees a TatePairingPrecomputation. After calling this function on a
+ * TatePairingPrecomputation instance, that instance should not be used anymore.
+ *
+ * ## Parameters
+ *
+ *   * precomputation
+ *     * The TatePairingPrecomputation to be destroyed.
+ */
+void tate_destroyPrecomputation(TatePairingPrecomputation precomputation);
+
 /**
  * ## Description
  *
@@ -40,4 +112,202 @@ CryptidStatus tate_performPairing(Complex *result, const AffinePoint p,
                                   const mpz_t subgroupOrder,
                                   const EllipticCurve ellipticCurve);
 
+/**
+ * ## Description
+ *
+ * Computes the Tate pairing over Type-1 elliptic curves using previously
+ * computed curve-dependent values.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter to the resulting Complex value. On CRYPTID_SUCCESS, this
+ * should be destroyed by the caller.
+ *   * p
+ *     * A point of \f$E[r]\f$.
+ *   * b
+ *     * A point of \f$E[r]\f$.
+ *   * precomputation
+ *     * The values computed by tate_initPrecomputation for the same curve and
+ * subgroup order.
+ *   * subgroupOrder
+ *     * The order of the subgroup.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus tate_performPairingWithPrecomputation(
+    Complex *result, const AffinePoint p, const AffinePoint b,
+    const TatePairingPrecomputation precomputation, const mpz_t subgroupOrder,
+    const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Computes the product of Tate pairings \f$\prod_{j} e(p_j, b_j)\f$ over
+ * Type-1 elliptic curves. The Miller loops of the pairs are interleaved, so
+ * the squarings of the accumulator and the final exponentiation are performed
+ * only once for the whole product.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter to the resulting Complex value. On CRYPTID_SUCCESS, this
+ * should be destroyed by the caller.
+ *   * ps
+ *     * The first arguments of the pairings, points of \f$E[r]\f$.
+ *   * bs
+ *     * The second arguments of the pairings, points of \f$E[r]\f$.
+ *   * count
+ *     * The number of pairs.
+ *   * embeddingDegree
+ *     * The embedding degree of the curve.
+ *   * subgroupOrder
+ *     * The order of the subgroup.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus tate_performMultiPairing(Complex *result,
+                                       const AffinePoint *const ps,
+                                       const AffinePoint *const bs,
+                                       const size_t count,
+                                       const int embeddingDegree,
+                                       const mpz_t subgroupOrder,
+                                       const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Computes the product of Tate pairings \f$\prod_{j} e(p_j, b_j)\f$ over
+ * Type-1 elliptic curves using previously computed curve-dependent values.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter to the resulting Complex value. On CRYPTID_SUCCESS, this
+ * should be destroyed by the caller.
+ *   * ps
+ *     * The first arguments of the pairings, points of \f$E[r]\f$.
+ *   * bs
+ *     * The second arguments of the pairings, points of \f$E[r]\f$.
+ *   * count
+ *     * The number of pairs.
+ *   * precomputation
+ *     * The values computed by tate_initPrecomputation for the same curve and
+ * subgroup order.
+ *   * subgroupOrder
+ *     * The order of the subgroup.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus tate_performMultiPairingWithPrecomputation(
+    Complex *result, const AffinePoint *const ps, const AffinePoint *const bs,
+    const size_t count, const TatePairingPrecomputation precomputation,
+    const mpz_t subgroupOrder, const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * The lines of the Miller loop of a fixed first pairing argument \f$p\f$.
+ * They depend only on \f$p\f$ and the subgroup order, so a pairing with a
+ * precomputed TatePairingLines only evaluates them at the distorted second
+ * argument instead of doing the point arithmetic again.
+ */
+typedef struct TatePairingLines {
+  /**
+   * ## Description
+   *
+   * The number of steps of the Miller loop. Zero if \f$p\f$ is the point at
+   * infinity.
+   */
+  size_t length;
+
+  /**
+   * ## Description
+   *
+   * The coefficients \f$a, b, c\f$ of the lines \f$ax + by + c\f$ of every
+   * step of the Miller loop, in the Montgomery representation of the base
+   * field: the tangent or chord of the step, followed by its vertical line.
+   */
+  mp_limb_t *coefficients;
+} TatePairingLines;
+
+/**
+ * ## Description
+ *
+ * Precomputes the lines of the Miller loop of a fixed first pairing argument.
+ *
+ * ## Parameters
+ *
+ *   * linesOutput
+ *     * The TatePairingLines to be initialized. This should be destroyed by
+ * the caller.
+ *   * p
+ *     * A point of \f$E[r]\f$, the first argument of the later pairings.
+ *   * subgroupOrder
+ *     * The order of the subgroup.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ */
+void tate_initLines(TatePairingLines *linesOutput, const AffinePoint p,
+                    const mpz_t subgroupOrder,
+                    const EllipticCurve ellipticCurve);
+
+/**
+ * ## Description
+ *
+ * Frees a TatePairingLines. After calling this function on a TatePairingLines
+ * instance, that instance should not be used anymore.
+ *
+ * ## Parameters
+ *
+ *   * lines
+ *     * The TatePairingLines to be destroyed.
+ */
+void tate_destroyLines(TatePairingLines lines);
+
+/**
+ * ## Description
+ *
+ * Computes the Tate pairing over Type-1 elliptic curves, where the lines of
+ * the first argument have already been computed by tate_initLines.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter to the resulting Complex value. On CRYPTID_SUCCESS, this
+ * should be destroyed by the caller.
+ *   * lines
+ *     * The precomputed lines of the first argument.
+ *   * b
+ *     * A point of \f$E[r]\f$.
+ *   * precomputation
+ *     * The values computed by tate_initPrecomputation for the same curve and
+ * subgroup order.
+ *   * subgroupOrder
+ *     * The order of the subgroup, the same as the one passed to
+ * tate_initLines.
+ *   * ellipticCurve
+ *     * The elliptic curve to operate on.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus tate_performPairingWithLines(
+    Complex *result, const TatePairingLines lines, const AffinePoint b,
+    const TatePairingPrecomputation precomputation, const mpz_t subgroupOrder,
+    const EllipticCurve ellipticCurve);
+
 #endif
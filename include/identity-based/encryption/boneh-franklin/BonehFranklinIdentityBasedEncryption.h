@@ -7,8 +7,11 @@
 
 #include "elliptic/AffinePoint.h"
 #include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionCiphertextAsBinary.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary.h"
 #include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary.h"
 #include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionStream.h"
 #include "util/SecurityLevel.h"
 #include "util/Status.h"
 
@@ -106,7 +109,8 @@ CryptidStatus cryptid_ibe_bonehFranklin_extract(
  *
  * ## Return Value
  *
- * CRYPTID_SUCCESS if everything went right.
+ * CRYPTID_SUCCESS if everything went right,
+ * CRYPTID_RANDOM_GENERATION_ERROR if the random source failed.
  */
 CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
     BonehFranklinIdentityBasedEncryptionCiphertextAsBinary *result,
@@ -145,6 +149,350 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
     const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
         publicParametersAsBinary);
 
+/**
+ * ## Description
+ *
+ * Parses and validates the public parameters and precomputes the values
+ * derived from them. The resulting context can be passed to any number of
+ * {@code *WithContext} calls, which then skip the validation of the public
+ * parameters. The tables which only pay off over many calls are precomputed as
+ * well.
+ *
+ * ## Parameters
+ *
+ *   * contextOutput
+ *     * Out parameter holding the context. If the return value is
+ * CRYPTID_SUCCESS, then it will point to a
+ * [BonehFranklinIdentityBasedEncryptionContext](codebase://identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h#BonehFranklinIdentityBasedEncryptionContext)
+ * instance, that must be destroyed by the caller using
+ * cryptid_ibe_bonehFranklin_destroyContext. Initialization is done by this
+ * function.
+ *   * publicParametersAsBinary
+ *     * The BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right,
+ * CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR if the public parameters are invalid.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_createContext(
+    BonehFranklinIdentityBasedEncryptionContext *contextOutput,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary);
+
+/**
+ * ## Description
+ *
+ * Frees a context created by cryptid_ibe_bonehFranklin_createContext.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context to be destroyed.
+ */
+void cryptid_ibe_bonehFranklin_destroyContext(
+    BonehFranklinIdentityBasedEncryptionContext *context);
+
+/**
+ * ## Description
+ *
+ * Enables a bounded least recently used cache of the per-identity pairing
+ * values in a context created by cryptid_ibe_bonehFranklin_createContext.
+ * Repeated encryptions to a cached identity then cost a single exponentiation
+ * in \f$F_p^2\f$ and a single point multiplication.
+ *
+ * Calling it again empties the cache and changes its capacity. The cache is
+ * synchronized, so the context can still be shared by threads encrypting
+ * concurrently, and later calls may run while they do. The first call should
+ * be made before the context is shared.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context.
+ *   * capacity
+ *     * The maximal number of identities to cache, clamped to
+ * BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_MAX_CAPACITY.
+ */
+void cryptid_ibe_bonehFranklin_enableIdentityCache(
+    BonehFranklinIdentityBasedEncryptionContext *context,
+    const size_t capacity);
+
+/**
+ * ## Description
+ *
+ * Same as cryptid_ibe_bonehFranklin_extract, but uses a previously created
+ * context instead of the binary public parameters.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter holding the private key in binary format.
+ *   * identity
+ *     * The identity string we're extracting the private key for.
+ *   * identityLength
+ *     * The length of the identity string.
+ *   * masterSecretAsBinary
+ *     * The master secret corresponding to the public parameters.
+ *   * context
+ *     * The context created from the BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_extractWithContext(
+    AffinePointAsBinary *result, const char *const identity,
+    const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary
+        masterSecretAsBinary,
+    const BonehFranklinIdentityBasedEncryptionContext *const context);
+
+/**
+ * ## Description
+ *
+ * Same as cryptid_ibe_bonehFranklin_encrypt, but uses a previously created
+ * context instead of the binary public parameters.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter storing the ciphertext.
+ *   * message
+ *     * The string to encrypt.
+ *   * messageLength
+ *     * The length of the message string.
+ *   * identity
+ *     * The identity string to encrypt with.
+ *   * identityLength
+ *     * The length of the identity string.
+ *   * context
+ *     * The context created from the BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right,
+ * CRYPTID_RANDOM_GENERATION_ERROR if the random source failed.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_encryptWithContext(
+    BonehFranklinIdentityBasedEncryptionCiphertextAsBinary *result,
+    const char *const message, const size_t messageLength,
+    const char *const identity, const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionContext *const context);
+
+/**
+ * ## Description
+ *
+ * Same as cryptid_ibe_bonehFranklin_decrypt, but uses a previously created
+ * context instead of the binary public parameters.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter holding the message in plaintext.
+ *   * ciphertextAsBinary
+ *     * The ciphertext to decrypt.
+ *   * privateKeyAsBinary
+ *     * The private key to decrypt with.
+ *   * context
+ *     * The context created from the BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_decryptWithContext(
+    char **result,
+    const BonehFranklinIdentityBasedEncryptionCiphertextAsBinary
+        ciphertextAsBinary,
+    const AffinePointAsBinary privateKeyAsBinary,
+    const BonehFranklinIdentityBasedEncryptionContext *const context);
+
+/**
+ * ## Description
+ *
+ * Starts encrypting a payload of arbitrary length with the given identity
+ * string in the hybrid mode. The pairing based part only encapsulates a short
+ * key, while the payload is processed by subsequent calls to
+ * cryptid_ibe_bonehFranklin_encryptUpdate in pieces of any size, so the
+ * memory use does not depend on the length of the payload.
+ *
+ * ## Parameters
+ *
+ *   * streamOutput
+ *     * Out parameter holding the state of the encryption. If the return value
+ * is CRYPTID_SUCCESS, then it must be passed to
+ * cryptid_ibe_bonehFranklin_encryptFinal or
+ * cryptid_ibe_bonehFranklin_destroyStream.
+ *   * encapsulationOutput
+ *     * Out parameter storing the encapsulated key. If the return value is
+ * CRYPTID_SUCCESS, then it will point to a
+ * [BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary](codebase://identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary.h#BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary)
+ * instance, that must be destroyed by the caller.
+ *   * identity
+ *     * The identity string to encrypt with.
+ *   * identityLength
+ *     * The length of the identity string.
+ *   * context
+ *     * The context created from the BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right,
+ * CRYPTID_RANDOM_GENERATION_ERROR if the random source failed.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_encryptInit(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        *encapsulationOutput,
+    const char *const identity, const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionContext *const context);
+
+/**
+ * ## Description
+ *
+ * Encrypts the next piece of the payload. The ciphertext has the same length
+ * as the plaintext.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The state created by cryptid_ibe_bonehFranklin_encryptInit.
+ *   * output
+ *     * Buffer of at least length octets receiving the ciphertext. May be the
+ * same as input.
+ *   * input
+ *     * The plaintext octets.
+ *   * length
+ *     * The number of plaintext octets.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_encryptUpdate(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length);
+
+/**
+ * ## Description
+ *
+ * Finishes the encryption by computing the authentication tag of the
+ * ciphertext, and frees the stream.
+ *
+ * ## Parameters
+ *
+ *   * tagOutput
+ *     * Buffer receiving the tag, the length of which is the output length of
+ * the hash function of the public parameters.
+ *   * stream
+ *     * The state created by cryptid_ibe_bonehFranklin_encryptInit.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_encryptFinal(
+    unsigned char *tagOutput,
+    BonehFranklinIdentityBasedEncryptionStream *stream);
+
+/**
+ * ## Description
+ *
+ * Recovers the key encapsulated by cryptid_ibe_bonehFranklin_encryptInit and
+ * starts decrypting the payload.
+ *
+ * ## Parameters
+ *
+ *   * streamOutput
+ *     * Out parameter holding the state of the decryption. If the return value
+ * is CRYPTID_SUCCESS, then it must be passed to
+ * cryptid_ibe_bonehFranklin_decryptFinal or
+ * cryptid_ibe_bonehFranklin_destroyStream.
+ *   * encapsulationAsBinary
+ *     * The encapsulated key.
+ *   * privateKeyAsBinary
+ *     * The private key to decrypt with.
+ *   * context
+ *     * The context created from the BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_DECRYPTION_FAILED_ERROR if
+ * the encapsulation was not created for the private key.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_decryptInit(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    const BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        encapsulationAsBinary,
+    const AffinePointAsBinary privateKeyAsBinary,
+    const BonehFranklinIdentityBasedEncryptionContext *const context);
+
+/**
+ * ## Description
+ *
+ * Decrypts the next piece of the payload. The plaintext is not authenticated
+ * until cryptid_ibe_bonehFranklin_decryptFinal succeeds, the caller must
+ * discard it otherwise.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The state created by cryptid_ibe_bonehFranklin_decryptInit.
+ *   * output
+ *     * Buffer of at least length octets receiving the plaintext. May be the
+ * same as input.
+ *   * input
+ *     * The ciphertext octets.
+ *   * length
+ *     * The number of ciphertext octets.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_decryptUpdate(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length);
+
+/**
+ * ## Description
+ *
+ * Finishes the decryption by verifying the authentication tag of the
+ * ciphertext, and frees the stream.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The state created by cryptid_ibe_bonehFranklin_decryptInit.
+ *   * tag
+ *     * The tag produced by cryptid_ibe_bonehFranklin_encryptFinal.
+ *   * tagLength
+ *     * The length of the tag.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if the ciphertext is authentic,
+ * CRYPTID_DECRYPTION_FAILED_ERROR otherwise.
+ */
+CryptidStatus cryptid_ibe_bonehFranklin_decryptFinal(
+    BonehFranklinIdentityBasedEncryptionStream *stream,
+    const unsigned char *const tag, const size_t tagLength);
+
+/**
+ * ## Description
+ *
+ * Frees a stream without finishing it, for example when the processing of the
+ * payload is aborted.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The stream to be destroyed.
+ */
+void cryptid_ibe_bonehFranklin_destroyStream(
+    BonehFranklinIdentityBasedEncryptionStream *stream);
+
 #endif
 
 #endif
\ No newline at end of file
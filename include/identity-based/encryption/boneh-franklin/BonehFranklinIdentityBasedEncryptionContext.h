@@ -0,0 +1,162 @@
+#ifndef __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_CONTEXT_H
+#define __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_CONTEXT_H
+
+#include "gmp.h"
+
+#include "elliptic/FixedBaseTable.h"
+#include "elliptic/TatePairing.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionIdentityCache.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionPublicParameters.h"
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary.h"
+#include "util/Status.h"
+
+/**
+ * ## Description
+ *
+ * Reusable handle holding a set of BF-IBE public parameters which have already
+ * been parsed and validated, along with the values derived from them. Creating
+ * a context once and passing it to the {@code *WithContext} operations avoids
+ * importing and primality testing the public parameters on every call.
+ *
+ * The fields are managed by the library, the caller should treat an instance as
+ * an opaque handle.
+ */
+typedef struct BonehFranklinIdentityBasedEncryptionContext {
+  /**
+   * ## Description
+   *
+   * The parsed and validated public parameters.
+   */
+  BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters;
+
+  /**
+   * ## Description
+   *
+   * The length of the output of the hash function of the public parameters in
+   * octets.
+   */
+  int hashLength;
+
+  /**
+   * ## Description
+   *
+   * The cofactor \f$\frac{p + 1}{q}\f$ used when hashing to a point.
+   */
+  mpz_t cofactor;
+
+  /**
+   * ## Description
+   *
+   * The curve-dependent values of the Tate pairing (the \f$\xi\f$ value of the
+   * distortion map and the exponent of the final exponentiation).
+   */
+  TatePairingPrecomputation pairingPrecomputation;
+
+  /**
+   * ## Description
+   *
+   * Optional fixed-base table of the point \f$P\f$, used to compute
+   * \f$U = [l]P\f$ in encryption and decryption, NULL if not precomputed.
+   * See bonehFranklinIdentityBasedEncryptionContext_precompute.
+   */
+  FixedBaseTable *pointPTable;
+
+  /**
+   * ## Description
+   *
+   * Optional Miller loop lines of \f$P_{pub}\f$, the first argument of the
+   * pairing in encryption, NULL if not precomputed. See
+   * bonehFranklinIdentityBasedEncryptionContext_precompute.
+   */
+  TatePairingLines *pointPpublicLines;
+
+  /**
+   * ## Description
+   *
+   * Optional cache of the pairing values \f$e(P_{pub}, Q_{id})\f$ of
+   * recently used identities, NULL if disabled. See
+   * bonehFranklinIdentityBasedEncryptionContext_enableIdentityCache.
+   */
+  BonehFranklinIdentityBasedEncryptionIdentityCache *identityCache;
+} BonehFranklinIdentityBasedEncryptionContext;
+
+/**
+ * ## Description
+ *
+ * Initializes a new
+ * [BonehFranklinIdentityBasedEncryptionContext](codebase://identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h#BonehFranklinIdentityBasedEncryptionContext)
+ * from binary public parameters. The public parameters are validated exactly
+ * once, here.
+ *
+ * ## Parameters
+ *
+ *   * contextOutput
+ *     * The context to be initialized. On CRYPTID_SUCCESS, this should be
+ * destroyed by the caller.
+ *   * publicParametersAsBinary
+ *     * The BF-IBE public parameters.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right,
+ * CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR if the public parameters are invalid.
+ */
+CryptidStatus bonehFranklinIdentityBasedEncryptionContext_init(
+    BonehFranklinIdentityBasedEncryptionContext *contextOutput,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary);
+
+/**
+ * ## Description
+ *
+ * Precomputes the tables of a context which only pay off over many
+ * operations. A context used for a single operation is faster without them.
+ * Calling it again has no effect.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context.
+ */
+void bonehFranklinIdentityBasedEncryptionContext_precompute(
+    BonehFranklinIdentityBasedEncryptionContext *context);
+
+/**
+ * ## Description
+ *
+ * Enables the identity cache of a context, so that repeated encryptions to the
+ * same identity skip {@code HashToPoint} and the pairing. Calling it again
+ * empties the cache and changes its capacity.
+ *
+ * The cache is synchronized, so the context can still be shared by threads
+ * encrypting concurrently, and later calls may run while they do. The first
+ * call creates the cache, so it should be made before the context is shared.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context.
+ *   * capacity
+ *     * The maximal number of identities to cache.
+ */
+void bonehFranklinIdentityBasedEncryptionContext_enableIdentityCache(
+    BonehFranklinIdentityBasedEncryptionContext *context,
+    const size_t capacity);
+
+/**
+ * ## Description
+ *
+ * Frees a
+ * [BonehFranklinIdentityBasedEncryptionContext](codebase://identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h#BonehFranklinIdentityBasedEncryptionContext).
+ * After calling this function on a context, that context should not be used
+ * anymore.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context to be destroyed.
+ */
+void bonehFranklinIdentityBasedEncryptionContext_destroy(
+    BonehFranklinIdentityBasedEncryptionContext *context);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_ENCAPSULATION_AS_BINARY_H
+#define __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_ENCAPSULATION_AS_BINARY_H
+
+#include <stddef.h>
+
+#include "elliptic/AffinePointAsBinary.h"
+
+/**
+ * ## Description
+ *
+ * The key encapsulation part \f$(U, V)\f$ of a BF-IBE ciphertext in the hybrid
+ * mode. The payload and its authentication tag are transmitted separately.
+ */
+typedef struct BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary {
+  /**
+   * ## Description
+   *
+   * The point \f$U = [l]P\f$.
+   */
+  AffinePointAsBinary cipherU;
+
+  /**
+   * ## Description
+   *
+   * The masked key seed \f$V = w \oplus rho\f$.
+   */
+  void *cipherV;
+
+  /**
+   * ## Description
+   *
+   * The length of cipherV.
+   */
+  size_t cipherVLength;
+} BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary;
+
+/**
+ * ## Description
+ *
+ * Initializes a new encapsulation, copying the specified values.
+ *
+ * ## Parameters
+ *
+ *   * encapsulationAsBinaryOutput
+ *     * The encapsulation to be initialized. This should be destroyed by the
+ * caller.
+ *   * cipherU
+ *     * The point \f$U\f$.
+ *   * cipherV
+ *     * The masked key seed \f$V\f$.
+ *   * cipherVLength
+ *     * The length of cipherV.
+ */
+void bonehFranklinIdentityBasedEncryptionEncapsulationAsBinary_init(
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        *encapsulationAsBinaryOutput,
+    const AffinePointAsBinary cipherU, const void *const cipherV,
+    const size_t cipherVLength);
+
+/**
+ * ## Description
+ *
+ * Frees an encapsulation.
+ *
+ * ## Parameters
+ *
+ *   * encapsulationAsBinary
+ *     * The encapsulation to be destroyed.
+ */
+void bonehFranklinIdentityBasedEncryptionEncapsulationAsBinary_destroy(
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        encapsulationAsBinary);
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef __CRYPTID_BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_H
+#define __CRYPTID_BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_H
+
+#include <stddef.h>
+
+#if defined(__CRYPTID_PTHREADS)
+#include <pthread.h>
+#endif
+
+#include "complex/Complex.h"
+
+/**
+ * ## Description
+ *
+ * The largest capacity of an identity cache. Larger capacities are clamped to
+ * it.
+ */
+#define BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_MAX_CAPACITY \
+  ((size_t)1 << 20)
+
+/**
+ * ## Description
+ *
+ * An entry of the identity cache.
+ */
+typedef struct BonehFranklinIdentityBasedEncryptionIdentityCacheEntry {
+  /**
+   * ## Description
+   *
+   * A copy of the identity.
+   */
+  char *identity;
+
+  /**
+   * ## Description
+   *
+   * The length of the identity.
+   */
+  size_t identityLength;
+
+  /**
+   * ## Description
+   *
+   * The pairing value \f$e(P_{pub}, Q_{id})\f$ of the identity.
+   */
+  Complex pairingValue;
+
+  /**
+   * ## Description
+   *
+   * The next entry in the same bucket.
+   */
+  struct BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *nextInBucket;
+
+  /**
+   * ## Description
+   *
+   * The next more recently used entry.
+   */
+  struct BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *moreRecent;
+
+  /**
+   * ## Description
+   *
+   * The next less recently used entry.
+   */
+  struct BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *lessRecent;
+} BonehFranklinIdentityBasedEncryptionIdentityCacheEntry;
+
+/**
+ * ## Description
+ *
+ * Bounded least recently used cache of the pairing values
+ * \f$e(P_{pub}, Q_{id})\f$ keyed by identity. A cache belongs to a single set
+ * of public parameters (see
+ * [BonehFranklinIdentityBasedEncryptionContext](codebase://identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h#BonehFranklinIdentityBasedEncryptionContext)),
+ * hence the identity alone identifies an entry.
+ *
+ * Lookups and insertions are serialized by a lock, so the cache can be used
+ * from multiple threads concurrently.
+ */
+typedef struct BonehFranklinIdentityBasedEncryptionIdentityCache {
+  /**
+   * ## Description
+   *
+   * The maximal number of entries.
+   */
+  size_t capacity;
+
+  /**
+   * ## Description
+   *
+   * The current number of entries.
+   */
+  size_t size;
+
+  /**
+   * ## Description
+   *
+   * The number of hash buckets, a power of two.
+   */
+  size_t bucketCount;
+
+  /**
+   * ## Description
+   *
+   * The hash buckets.
+   */
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry **buckets;
+
+  /**
+   * ## Description
+   *
+   * The most recently used entry.
+   */
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *mostRecent;
+
+  /**
+   * ## Description
+   *
+   * The least recently used entry, the next one to be evicted.
+   */
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *leastRecent;
+
+#if defined(__CRYPTID_PTHREADS)
+  /**
+   * ## Description
+   *
+   * Guards the entries and the recency list.
+   */
+  pthread_mutex_t lock;
+#endif
+} BonehFranklinIdentityBasedEncryptionIdentityCache;
+
+/**
+ * ## Description
+ *
+ * Initializes a new, empty identity cache.
+ *
+ * ## Parameters
+ *
+ *   * cacheOutput
+ *     * The cache to be initialized. This should be destroyed by the caller.
+ *   * capacity
+ *     * The maximal number of identities to store, at most
+ * BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_MAX_CAPACITY. A zero
+ * capacity cache stores nothing, and so does a cache whose buckets could not
+ * be allocated.
+ */
+void bonehFranklinIdentityBasedEncryptionIdentityCache_init(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cacheOutput,
+    const size_t capacity);
+
+/**
+ * ## Description
+ *
+ * Empties an identity cache and changes its capacity. The cache is modified in
+ * place under its lock, so other threads may use it meanwhile.
+ *
+ * ## Parameters
+ *
+ *   * cache
+ *     * The cache.
+ *   * capacity
+ *     * The new capacity, as in
+ * bonehFranklinIdentityBasedEncryptionIdentityCache_init.
+ */
+void bonehFranklinIdentityBasedEncryptionIdentityCache_reset(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const size_t capacity);
+
+/**
+ * ## Description
+ *
+ * Frees an identity cache and all of its entries.
+ *
+ * ## Parameters
+ *
+ *   * cache
+ *     * The cache to be destroyed.
+ */
+void bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache);
+
+/**
+ * ## Description
+ *
+ * Looks up the pairing value of an identity, and marks the identity as the
+ * most recently used one.
+ *
+ * ## Parameters
+ *
+ *   * pairingValueOutput
+ *     * Out parameter to a copy of the cached pairing value. If the return
+ * value is 1, this should be destroyed by the caller.
+ *   * cache
+ *     * The cache.
+ *   * identity
+ *     * The identity.
+ *   * identityLength
+ *     * The length of the identity.
+ *
+ * ## Return Value
+ *
+ * 1 if the identity was found, 0 otherwise.
+ */
+int bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+    Complex *pairingValueOutput,
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength);
+
+/**
+ * ## Description
+ *
+ * Stores the pairing value of an identity as the most recently used entry.
+ * If the cache is full, the least recently used entry is evicted.
+ *
+ * ## Parameters
+ *
+ *   * cache
+ *     * The cache.
+ *   * identity
+ *     * The identity.
+ *   * identityLength
+ *     * The length of the identity.
+ *   * pairingValue
+ *     * The pairing value \f$e(P_{pub}, Q_{id})\f$, which is copied.
+ */
+void bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength,
+    const Complex pairingValue);
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_STREAM_H
+#define __CRYPTID_BONEH_FRANKLIN_IDENTITY_BASED_ENCRYPTION_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "util/HashFunction.h"
+#include "util/Hmac.h"
+
+/**
+ * ## Description
+ *
+ * State of the data encapsulation part of the hybrid BF-IBE mode. The payload
+ * is XORed with the output of {@code HashBytes} and the ciphertext is
+ * authenticated with HMAC as it passes, so the memory held by a stream does
+ * not depend on the length of the payload.
+ *
+ * The fields are managed by the library, the caller should treat an instance as
+ * an opaque handle.
+ */
+typedef struct BonehFranklinIdentityBasedEncryptionStream {
+  /**
+   * ## Description
+   *
+   * The hash function used for the keystream and the authentication.
+   */
+  HashFunction hashFunction;
+
+  /**
+   * ## Description
+   *
+   * The length of the output of the hash function in octets.
+   */
+  int hashLength;
+
+  /**
+   * ## Description
+   *
+   * The value \f$h_i\f$ of {@code HashBytes} followed by its value \f$k\f$,
+   * the hash of the keystream seed, so that
+   * \f$r_i = \mathrm{hashfcn}(h_i || k)\f$ is a single hash invocation.
+   */
+  unsigned char *keystreamState;
+
+  /**
+   * ## Description
+   *
+   * The current block \f$r_i\f$ of the keystream.
+   */
+  unsigned char *keystreamBlock;
+
+  /**
+   * ## Description
+   *
+   * The number of octets of keystreamBlock already used.
+   */
+  int keystreamOffset;
+
+  /**
+   * ## Description
+   *
+   * The HMAC key of the authentication.
+   */
+  HmacKey macKey;
+
+  /**
+   * ## Description
+   *
+   * The HMAC computation fed with the ciphertext processed so far, so the
+   * ciphertext is never buffered.
+   */
+  HashFunctionContext macContext;
+
+  /**
+   * ## Description
+   *
+   * The total number of payload octets processed.
+   */
+  uint64_t processedLength;
+} BonehFranklinIdentityBasedEncryptionStream;
+
+/**
+ * ## Description
+ *
+ * Initializes a stream from the key material established by the key
+ * encapsulation.
+ *
+ * ## Parameters
+ *
+ *   * streamOutput
+ *     * The stream to be initialized. This should be destroyed by the caller.
+ *   * keyMaterial
+ *     * \f$2 \cdot \mathrm{hashlen}\f$ octets, the first half of which seeds
+ * the keystream, while the second half is the authentication key.
+ *   * hashFunction
+ *     * The hash function of the public parameters.
+ */
+void bonehFranklinIdentityBasedEncryptionStream_init(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    const unsigned char *const keyMaterial, const HashFunction hashFunction);
+
+/**
+ * ## Description
+ *
+ * Frees a stream.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The stream to be destroyed.
+ */
+void bonehFranklinIdentityBasedEncryptionStream_destroy(
+    BonehFranklinIdentityBasedEncryptionStream *stream);
+
+/**
+ * ## Description
+ *
+ * XORs the next octets of the keystream into the input and authenticates the
+ * ciphertext side of the transformation.
+ *
+ * ## Parameters
+ *
+ *   * stream
+ *     * The stream.
+ *   * output
+ *     * Buffer of at least length octets receiving the result. May be the same
+ * as input.
+ *   * input
+ *     * The octets to transform.
+ *   * length
+ *     * The number of octets to transform.
+ *   * isEncryption
+ *     * Nonzero if input is plaintext, zero if input is ciphertext.
+ */
+void bonehFranklinIdentityBasedEncryptionStream_update(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length,
+    const int isEncryption);
+
+/**
+ * ## Description
+ *
+ * Computes the authentication tag of the ciphertext processed so far.
+ *
+ * ## Parameters
+ *
+ *   * tagOutput
+ *     * Buffer of hashLength octets receiving the tag.
+ *   * stream
+ *     * The stream.
+ */
+void bonehFranklinIdentityBasedEncryptionStream_tag(
+    unsigned char *tagOutput,
+    BonehFranklinIdentityBasedEncryptionStream *stream);
+
+#endif
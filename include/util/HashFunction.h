@@ -3,6 +3,8 @@
 
 #include <stddef.h>
 
+#include "sha.h"
+
 #include "util/SecurityLevel.h"
 #include "util/Status.h"
 #include "util/Validation.h"
@@ -14,6 +16,13 @@
  */
 #define HASHFUNCTION_MAX_VALUE 4
 
+/**
+ * ## Description
+ *
+ * The length in bytes of the longest hash of the supported hash functions.
+ */
+#define HASHFUNCTION_MAX_HASH_SIZE 64
+
 /**
  * ## Description
  *
@@ -27,6 +36,33 @@ typedef enum HashFunction {
   hashFunction_SHA512 = 4
 } HashFunction;
 
+/**
+ * ## Description
+ *
+ * The state of an incremental hash computation, which processes a message
+ * given in arbitrary pieces. Hashing the concatenation of several strings this
+ * way needs no buffer holding the concatenation.
+ *
+ * An instance needs no destruction and can be reused after being initialized
+ * again. Copying an instance duplicates the computation, so a common prefix
+ * can be hashed once.
+ */
+typedef struct HashFunctionContext {
+  /**
+   * ## Description
+   *
+   * The hash function being computed.
+   */
+  HashFunction hashFunction;
+
+  /**
+   * ## Description
+   *
+   * The state of the hash function.
+   */
+  USHAContext state;
+} HashFunctionContext;
+
 /**
  * ## Description
  *
@@ -73,6 +109,99 @@ CryptidStatus hashFunction_hash(unsigned char *hashResult,
                                 const size_t messageLength,
                                 const HashFunction hashFunction);
 
+/**
+ * ## Description
+ *
+ * Calls the specified hash function to several independent strings. SHA-224
+ * and SHA-256 hash up to 16 strings at once in the lanes of the vector
+ * registers, if the CPU supports it, the other hash functions hash the strings
+ * one by one.
+ *
+ * ## Parameters
+ *
+ *   * hashResults
+ *     * The results of the hashes, one per string.
+ *   * messages
+ *     * The strings which need to be hashed.
+ *   * messageLengths
+ *     * The lengths of the strings.
+ *   * messageCount
+ *     * The number of strings.
+ *   * hashFunction
+ *     * The hashfunction to be called.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus hashFunction_hashMany(unsigned char *const *hashResults,
+                                    const unsigned char *const *messages,
+                                    const size_t *messageLengths,
+                                    const size_t messageCount,
+                                    const HashFunction hashFunction);
+
+/**
+ * ## Description
+ *
+ * Starts an incremental hash computation.
+ *
+ * ## Parameters
+ *
+ *   * contextOutput
+ *     * The context to be initialized.
+ *   * hashFunction
+ *     * The hash function to be computed.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if the function is called to existing hashFunction,
+ * CRPYTID_UNKNOWN_HASH_TYPE_ERROR otherwise.
+ */
+CryptidStatus hashFunction_initContext(HashFunctionContext *contextOutput,
+                                       const HashFunction hashFunction);
+
+/**
+ * ## Description
+ *
+ * Feeds the next piece of the message into an incremental hash computation.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The context of the computation.
+ *   * message
+ *     * The next piece of the message.
+ *   * messageLength
+ *     * The length of message.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus hashFunction_update(HashFunctionContext *context,
+                                  const unsigned char *const message,
+                                  const size_t messageLength);
+
+/**
+ * ## Description
+ *
+ * Finishes an incremental hash computation. The context has to be initialized
+ * again before further use.
+ *
+ * ## Parameters
+ *
+ *   * hashResult
+ *     * The hash of the pieces fed into the context.
+ *   * context
+ *     * The context of the computation.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus hashFunction_final(unsigned char *hashResult,
+                                 HashFunctionContext *context);
+
 /**
  * ## Description
  *
@@ -0,0 +1,128 @@
+#ifndef __CRYPTID_HMAC_H
+#define __CRYPTID_HMAC_H
+
+#include <stddef.h>
+
+#include "util/HashFunction.h"
+
+/**
+ * ## Description
+ *
+ * A key of HMAC (RFC 2104) over one of the supported hash functions, with the
+ * inner and outer pads already hashed, so the key is processed once instead of
+ * once per message.
+ *
+ * An instance can be copied and should be destroyed with hmac_destroyKey, which
+ * erases it.
+ */
+typedef struct HmacKey {
+  /**
+   * ## Description
+   *
+   * The hash computation fed with the key XORed with the inner pad.
+   */
+  HashFunctionContext inner;
+
+  /**
+   * ## Description
+   *
+   * The hash computation fed with the key XORed with the outer pad.
+   */
+  HashFunctionContext outer;
+
+  /**
+   * ## Description
+   *
+   * The length of the output of the hash function in octets, which is the
+   * length of the HMAC.
+   */
+  int hashLength;
+} HmacKey;
+
+/**
+ * ## Description
+ *
+ * Prepares an HMAC key.
+ *
+ * ## Parameters
+ *
+ *   * keyOutput
+ *     * The key to be initialized. This should be destroyed by the caller.
+ *   * key
+ *     * The octets of the key. Keys longer than the block size of the hash
+ * function are hashed first.
+ *   * keyLength
+ *     * The length of the key.
+ *   * hashFunction
+ *     * The underlying hash function.
+ */
+void hmac_initKey(HmacKey *keyOutput, const unsigned char *const key,
+                  const size_t keyLength, const HashFunction hashFunction);
+
+/**
+ * ## Description
+ *
+ * Erases an HMAC key.
+ *
+ * ## Parameters
+ *
+ *   * key
+ *     * The key to be destroyed.
+ */
+void hmac_destroyKey(HmacKey *key);
+
+/**
+ * ## Description
+ *
+ * Starts computing the HMAC of a message given in pieces, which are then fed
+ * with hashFunction_update.
+ *
+ * ## Parameters
+ *
+ *   * contextOutput
+ *     * The hash computation to start.
+ *   * key
+ *     * The key.
+ */
+void hmac_init(HashFunctionContext *contextOutput, const HmacKey *const key);
+
+/**
+ * ## Description
+ *
+ * Finishes computing an HMAC started by hmac_init.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Buffer of hashLength octets receiving the HMAC.
+ *   * context
+ *     * The hash computation, which is erased.
+ *   * key
+ *     * The key the computation was started with.
+ */
+void hmac_final(unsigned char *result, HashFunctionContext *context,
+                const HmacKey *const key);
+
+/**
+ * ## Description
+ *
+ * Computes the HMAC of the concatenation of pieces of a message.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Buffer of hashLength octets receiving the HMAC.
+ *   * key
+ *     * The key.
+ *   * pieces
+ *     * The pieces of the message.
+ *   * pieceLengths
+ *     * The lengths of the pieces.
+ *   * pieceCount
+ *     * The number of pieces.
+ */
+void hmac_hash(unsigned char *result, const HmacKey *const key,
+               const unsigned char *const *pieces, const size_t *pieceLengths,
+               const int pieceCount);
+
+#endif
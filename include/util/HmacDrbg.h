@@ -0,0 +1,155 @@
+#ifndef __CRYPTID_HMAC_DRBG_H
+#define __CRYPTID_HMAC_DRBG_H
+
+#include <stddef.h>
+
+#include "util/Status.h"
+
+/**
+ * ## Description
+ *
+ * The length of the key and of the value of the generator, the output length
+ * of HMAC-SHA-256.
+ */
+#define HMACDRBG_OUTPUT_SIZE 32
+
+/**
+ * ## Description
+ *
+ * The largest number of octets a single call to hmacDrbg_generate can return,
+ * \f$2^{19}\f$ bits.
+ */
+#define HMACDRBG_MAX_REQUEST_SIZE 65536
+
+/**
+ * ## Description
+ *
+ * The largest number of requests between two reseeds, \f$2^{48}\f$.
+ */
+#define HMACDRBG_RESEED_INTERVAL (1ULL << 48)
+
+/**
+ * ## Description
+ *
+ * The working state of an HMAC_DRBG of NIST SP 800-90A Rev. 1, Section 10.1.2,
+ * instantiated with HMAC-SHA-256, without prediction resistance.
+ *
+ * An HmacDrbg must not be used from multiple threads concurrently.
+ */
+typedef struct HmacDrbg {
+  /**
+   * ## Description
+   *
+   * The key \f$Key\f$ of the state.
+   */
+  unsigned char key[HMACDRBG_OUTPUT_SIZE];
+
+  /**
+   * ## Description
+   *
+   * The value \f$V\f$ of the state.
+   */
+  unsigned char value[HMACDRBG_OUTPUT_SIZE];
+
+  /**
+   * ## Description
+   *
+   * The number of requests since instantiation or the last reseed, plus one.
+   */
+  unsigned long long reseedCounter;
+} HmacDrbg;
+
+/**
+ * ## Description
+ *
+ * Instantiates a generator (HMAC_DRBG_Instantiate_algorithm).
+ *
+ * ## Parameters
+ *
+ *   * drbgOutput
+ *     * The generator to instantiate.
+ *   * entropy
+ *     * The entropy input, at least 32 octets for the full security strength.
+ *   * entropyLength
+ *     * The length of the entropy input.
+ *   * nonce
+ *     * The nonce, may be NULL if nonceLength is 0.
+ *   * nonceLength
+ *     * The length of the nonce.
+ *   * personalization
+ *     * The personalization string, may be NULL if personalizationLength is 0.
+ *   * personalizationLength
+ *     * The length of the personalization string.
+ */
+void hmacDrbg_instantiate(HmacDrbg *drbgOutput,
+                          const unsigned char *const entropy,
+                          const size_t entropyLength,
+                          const unsigned char *const nonce,
+                          const size_t nonceLength,
+                          const unsigned char *const personalization,
+                          const size_t personalizationLength);
+
+/**
+ * ## Description
+ *
+ * Reseeds a generator (HMAC_DRBG_Reseed_algorithm).
+ *
+ * ## Parameters
+ *
+ *   * drbg
+ *     * The generator to reseed.
+ *   * entropy
+ *     * The fresh entropy input.
+ *   * entropyLength
+ *     * The length of the entropy input.
+ *   * additionalInput
+ *     * Additional input, may be NULL if additionalInputLength is 0.
+ *   * additionalInputLength
+ *     * The length of the additional input.
+ */
+void hmacDrbg_reseed(HmacDrbg *drbg, const unsigned char *const entropy,
+                     const size_t entropyLength,
+                     const unsigned char *const additionalInput,
+                     const size_t additionalInputLength);
+
+/**
+ * ## Description
+ *
+ * Generates pseudorandom octets (HMAC_DRBG_Generate_algorithm).
+ *
+ * ## Parameters
+ *
+ *   * drbg
+ *     * The generator.
+ *   * output
+ *     * The buffer to fill.
+ *   * outputLength
+ *     * The number of octets to generate, at most HMACDRBG_MAX_REQUEST_SIZE.
+ *   * additionalInput
+ *     * Additional input, may be NULL if additionalInputLength is 0.
+ *   * additionalInputLength
+ *     * The length of the additional input.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the request is too long or the generator has to be reseeded first.
+ */
+CryptidStatus hmacDrbg_generate(HmacDrbg *drbg, unsigned char *output,
+                                const size_t outputLength,
+                                const unsigned char *const additionalInput,
+                                const size_t additionalInputLength);
+
+/**
+ * ## Description
+ *
+ * Wipes the state of a generator (Uninstantiate_function).
+ *
+ * ## Parameters
+ *
+ *   * drbg
+ *     * The generator to wipe.
+ */
+void hmacDrbg_destroy(HmacDrbg *drbg);
+
+#endif
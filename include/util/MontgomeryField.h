@@ -0,0 +1,317 @@
+#ifndef __CRYPTID_MONTGOMERY_FIELD_H
+#define __CRYPTID_MONTGOMERY_FIELD_H
+
+#include <limits.h>
+
+#include "gmp.h"
+#include "util/Status.h"
+
+/**
+ * ## Description
+ *
+ * The number of bits of a limb.
+ */
+#define MONTGOMERY_FIELD_LIMB_BITS (sizeof(mp_limb_t) * CHAR_BIT)
+
+/**
+ * ## Description
+ *
+ * The number of limbs of an element of a field of the specified bit length.
+ */
+#define MONTGOMERY_FIELD_LIMB_COUNT(bits)                                      \
+  (((bits) + MONTGOMERY_FIELD_LIMB_BITS - 1) / MONTGOMERY_FIELD_LIMB_BITS)
+
+/**
+ * ## Description
+ *
+ * The number of limbs of an element of the field of a security level, whose
+ * nominal bit length is given. The field order \f$p = 12rq - 1\f$ may exceed
+ * the nominal length by two bits.
+ */
+#define MONTGOMERY_FIELD_LEVEL_LIMB_COUNT(bits)                                \
+  MONTGOMERY_FIELD_LIMB_COUNT((bits) + 2)
+
+/**
+ * ## Description
+ *
+ * The number of limbs of an element of the field of the HIGHEST security level.
+ * No field of a security level has more limbs.
+ */
+#define MONTGOMERY_FIELD_MAX_LEVEL_LIMB_COUNT                                  \
+  MONTGOMERY_FIELD_LEVEL_LIMB_COUNT(7680)
+
+/**
+ * ## Description
+ *
+ * A prime field \f$F_p\f$ whose elements are kept in Montgomery representation:
+ * \f$a\f$ is stored as \f$aR \mod p\f$, where \f$R = 2^{wn}\f$ for limbs of
+ * \f$w\f$ bits and \f$n\f$ limbs of \f$p\f$. A product is then reduced by
+ * Montgomery reduction, which takes multiplications only, instead of a
+ * division.
+ *
+ * An element is an array of limbCount limbs, holding a value in \f$[0, p)\f$.
+ * Results may be the same as any of the operands.
+ *
+ * The limb counts of the fields of the security levels have multiplication
+ * and squaring kernels specialized at compile time, which keep the unreduced
+ * product in automatic storage. Other fields use generic kernels working in the
+ * product buffer of the field. The field also holds the temporary of the
+ * conversions, so an instance must not be used by concurrent calls.
+ */
+typedef struct MontgomeryField {
+  /**
+   * ## Description
+   *
+   * The number of limbs of the modulus and of every element.
+   */
+  mp_size_t limbCount;
+
+  /**
+   * ## Description
+   *
+   * The modulus \f$p\f$, an odd prime.
+   */
+  mp_limb_t *modulus;
+
+  /**
+   * ## Description
+   *
+   * \f$-p^{-1} \mod 2^w\f$.
+   */
+  mp_limb_t modulusInverse;
+
+  /**
+   * ## Description
+   *
+   * \f$R^2 \mod p\f$, used to convert into Montgomery representation.
+   */
+  mp_limb_t *rSquared;
+
+  /**
+   * ## Description
+   *
+   * Room for an unreduced product of 2 * limbCount limbs.
+   */
+  mp_limb_t *product;
+
+  /**
+   * ## Description
+   *
+   * Temporary of the conversions.
+   */
+  mpz_t conversion;
+
+  /**
+   * ## Description
+   *
+   * The multiplication kernel for limbCount limbs.
+   */
+  void (*mulKernel)(mp_limb_t *product, const mp_limb_t *multiplier,
+                    const mp_limb_t *multiplicand,
+                    struct MontgomeryField *field);
+
+  /**
+   * ## Description
+   *
+   * The squaring kernel for limbCount limbs.
+   */
+  void (*sqrKernel)(mp_limb_t *square, const mp_limb_t *operand,
+                    struct MontgomeryField *field);
+} MontgomeryField;
+
+/**
+ * ## Description
+ *
+ * Initializes a new field, precomputing the constants of the Montgomery
+ * representation.
+ *
+ * ## Parameters
+ *
+ *   * fieldOutput
+ *     * The field to be initialized. This should be destroyed by the caller.
+ *   * modulus
+ *     * The order of the field, an odd prime.
+ */
+void montgomeryField_init(MontgomeryField *fieldOutput, const mpz_t modulus);
+
+/**
+ * ## Description
+ *
+ * Frees a field.
+ *
+ * ## Parameters
+ *
+ *   * field
+ *     * The field to be destroyed.
+ */
+void montgomeryField_destroy(MontgomeryField field);
+
+/**
+ * ## Description
+ *
+ * Allocates an array of elements, each set to zero.
+ *
+ * ## Parameters
+ *
+ *   * elementsOutput
+ *     * Out parameter to the limbs of the elements, the ith element starting
+ * at i * limbCount. This should be freed by the caller.
+ *   * count
+ *     * The number of elements.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_initElements(mp_limb_t **elementsOutput,
+                                  const size_t count,
+                                  const MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Converts an integer into Montgomery representation.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The element receiving \f$vR \mod p\f$.
+ *   * value
+ *     * The integer \f$v\f$, which need not be reduced.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_fromMpz(mp_limb_t *result, const mpz_t value,
+                             MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Converts an element out of Montgomery representation.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * The initialized integer receiving the value of the element.
+ *   * element
+ *     * The element.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_toMpz(mpz_t result, const mp_limb_t *element,
+                           MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Adds two elements.
+ *
+ * ## Parameters
+ *
+ *   * sum
+ *     * The element receiving the result.
+ *   * augend
+ *     * The element to which the addend is added.
+ *   * addend
+ *     * The element that is added to the augend.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_add(mp_limb_t *sum, const mp_limb_t *augend,
+                         const mp_limb_t *addend, const MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Subtracts an element from another.
+ *
+ * ## Parameters
+ *
+ *   * difference
+ *     * The element receiving the result.
+ *   * minuend
+ *     * The element from which the subtrahend is subtracted.
+ *   * subtrahend
+ *     * The element subtracted from the minuend.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_sub(mp_limb_t *difference, const mp_limb_t *minuend,
+                         const mp_limb_t *subtrahend,
+                         const MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Computes the additive inverse of an element.
+ *
+ * ## Parameters
+ *
+ *   * inverse
+ *     * The element receiving the result.
+ *   * operand
+ *     * The element to be negated.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_neg(mp_limb_t *inverse, const mp_limb_t *operand,
+                         const MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Multiplies two elements.
+ *
+ * ## Parameters
+ *
+ *   * product
+ *     * The element receiving the result.
+ *   * multiplier
+ *     * The element to multiply with.
+ *   * multiplicand
+ *     * The element to be multiplied by the multiplier.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_mul(mp_limb_t *product, const mp_limb_t *multiplier,
+                         const mp_limb_t *multiplicand, MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Squares an element.
+ *
+ * ## Parameters
+ *
+ *   * square
+ *     * The element receiving the result.
+ *   * operand
+ *     * The element to be squared.
+ *   * field
+ *     * The field.
+ */
+void montgomeryField_sqr(mp_limb_t *square, const mp_limb_t *operand,
+                         MontgomeryField *field);
+
+/**
+ * ## Description
+ *
+ * Computes the multiplicative inverse of an element.
+ *
+ * ## Parameters
+ *
+ *   * inverse
+ *     * The element receiving the result.
+ *   * operand
+ *     * The element to be inverted.
+ *   * field
+ *     * The field.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_HAS_NO_MUL_INV_ERROR if the
+ * operand is zero.
+ */
+CryptidStatus montgomeryField_inverse(mp_limb_t *inverse,
+                                      const mp_limb_t *operand,
+                                      MontgomeryField *field);
+
+#endif
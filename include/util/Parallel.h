@@ -0,0 +1,77 @@
+#ifndef __CRYPTID_PARALLEL_H
+#define __CRYPTID_PARALLEL_H
+
+/**
+ * ## Description
+ *
+ * The largest number of threads a parallel operation is split across.
+ */
+#define PARALLEL_MAX_THREAD_COUNT 64
+
+/**
+ * ## Description
+ *
+ * A unit of work of a parallel operation.
+ *
+ * ## Parameters
+ *
+ *   * argument
+ *     * The argument shared by every task of the operation.
+ *   * taskIndex
+ *     * The index of the task, in the range \f$[0, \mathrm{taskCount})\f$.
+ *   * taskCount
+ *     * The number of tasks of the operation.
+ */
+typedef void (*ParallelTask)(void *argument, const int taskIndex,
+                             const int taskCount);
+
+/**
+ * ## Description
+ *
+ * Gives the number of threads a parallel operation should be split across:
+ * the number set by parallel_setThreadCount or, by default, the number of
+ * online processors. Always 1 if the library was built without
+ * __CRYPTID_PTHREADS.
+ *
+ * ## Return Value
+ *
+ * The number of threads, at least 1 and at most PARALLEL_MAX_THREAD_COUNT.
+ */
+int parallel_threadCount(void);
+
+/**
+ * ## Description
+ *
+ * Sets the number of threads of the parallel operations of the library. The
+ * setting applies process-wide, so it should be made before the library is
+ * used from multiple threads.
+ *
+ * ## Parameters
+ *
+ *   * threadCount
+ *     * The number of threads, or 0 to use every online processor. 1 disables
+ * parallelism. Counts above PARALLEL_MAX_THREAD_COUNT are clamped.
+ */
+void parallel_setThreadCount(const int threadCount);
+
+/**
+ * ## Description
+ *
+ * Runs the tasks of a parallel operation, each on its own thread, and waits for
+ * all of them to finish. The task with index 0 runs on the calling thread. If a
+ * thread cannot be started, its task runs on the calling thread as well, so
+ * every task is run exactly once.
+ *
+ * ## Parameters
+ *
+ *   * task
+ *     * The function run by every task.
+ *   * argument
+ *     * The argument passed to every task.
+ *   * taskCount
+ *     * The number of tasks, at most PARALLEL_MAX_THREAD_COUNT.
+ */
+void parallel_run(const ParallelTask task, void *argument,
+                  const int taskCount);
+
+#endif
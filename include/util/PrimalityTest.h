@@ -7,17 +7,146 @@
 /**
  * ## Description
  *
- * Check whether \f$p\f$ is a probable prime.
+ * The probability of error the primality tests aim for is at most
+ * \f$2^{-\mathrm{PRIMALITYTEST\_ERROR\_BITS}}\f$.
+ */
+#define PRIMALITYTEST_ERROR_BITS 100
+
+/**
+ * ## Description
+ *
+ * The ways a number can be tested for primality.
+ */
+typedef enum PrimalityTestPolicy {
+  /**
+   * ## Description
+   *
+   * Miller-Rabin tests with random bases. Randomly generated candidates get the
+   * number of rounds the bound of Damgard, Landrock and Pomerance gives for
+   * their bit size, as in FIPS 186-5 Appendix B.3, which is only a few rounds
+   * for large candidates. Other numbers might be chosen adversarially, so they
+   * get PRIMALITYTEST_ERROR_BITS / 2 rounds.
+   */
+  primalityTest_MILLER_RABIN = 0,
+
+  /**
+   * ## Description
+   *
+   * The Baillie-PSW test: a Miller-Rabin test to base 2 and a strong Lucas
+   * test. No composite passing it is known, and it costs about as much as
+   * three Miller-Rabin rounds, regardless of where the number comes from.
+   */
+  primalityTest_BAILLIE_PSW = 1,
+
+  /**
+   * ## Description
+   *
+   * No test at all, every number is accepted. Only applies to validation, for
+   * public parameters coming from a trusted source. Generated candidates are
+   * tested with primalityTest_MILLER_RABIN instead.
+   */
+  primalityTest_TRUSTED = 2
+} PrimalityTestPolicy;
+
+/**
+ * ## Description
+ *
+ * The reasons a number is tested for primality, each with a policy of its own.
+ */
+typedef enum PrimalityTestPurpose {
+  /**
+   * ## Description
+   *
+   * The number is a randomly generated candidate, while generating parameters.
+   * The policy defaults to primalityTest_MILLER_RABIN.
+   */
+  primalityTest_GENERATION = 0,
+
+  /**
+   * ## Description
+   *
+   * The number is part of parameters passed to the library, while validating
+   * them. The policy defaults to primalityTest_MILLER_RABIN.
+   */
+  primalityTest_VALIDATION = 1
+} PrimalityTestPurpose;
+
+/**
+ * ## Description
+ *
+ * Sets the policy used to test numbers for a purpose. The setting applies
+ * process-wide. With __CRYPTID_PTHREADS it may be changed while other threads
+ * test numbers, each test using either the previous or the new policy.
+ *
+ * ## Parameters
+ *
+ *   * purpose
+ *     * The purpose the policy applies to.
+ *   * policy
+ *     * The policy.
+ */
+void primalityTest_setPolicy(const PrimalityTestPurpose purpose,
+                             const PrimalityTestPolicy policy);
+
+/**
+ * ## Description
+ *
+ * Gives the number of Miller-Rabin rounds a randomly generated candidate of a
+ * given size is tested with by primalityTest_MILLER_RABIN.
+ *
+ * ## Parameters
+ *
+ *   * bitLength
+ *     * The bit length of the candidate.
+ *
+ * ## Return Value
+ *
+ * The number of rounds, at most PRIMALITYTEST_ERROR_BITS / 2.
+ */
+int primalityTest_millerRabinRounds(const unsigned long bitLength);
+
+/**
+ * ## Description
+ *
+ * Check whether \f$p\f$ is a probable prime, with the policy set for the
+ * purpose of the test.
+ *
+ * ## Parameters
+ *
+ *   * p
+ *     * The number to check.
+ *   * purpose
+ *     * Why the number is checked.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_VALIDATION_SUCCESS if \f$p\f$ is a probable prime.
+ */
+CryptidValidationResult
+primalityTest_isProbablePrime(const mpz_t p,
+                              const PrimalityTestPurpose purpose);
+
+/**
+ * ## Description
+ *
+ * Check whether \f$p\f$ is a probable prime with a given policy.
  *
  * ## Parameters
  *
  *   * p
  *     * The number to check.
+ *   * policy
+ *     * The test to use.
+ *   * purpose
+ *     * Why the number is checked.
  *
  * ## Return Value
  *
  * CRYPTID_VALIDATION_SUCCESS if \f$p\f$ is a probable prime.
  */
-CryptidValidationResult primalityTest_isProbablePrime(const mpz_t p);
+CryptidValidationResult
+primalityTest_isProbablePrimeWithPolicy(const mpz_t p,
+                                        const PrimalityTestPolicy policy,
+                                        const PrimalityTestPurpose purpose);
 
 #endif
@@ -9,7 +9,12 @@
  * Fills the passed buffer from a cryptographically secure source.
  * If {@code (__CRYPTID_EXTERN_RANDOM} is defined, then this function will
  * call the {@code int __cryptid_cryptoRandom(void *buf, const int num)}
- * function internally.
+ * function internally. On Linux the bytes come from getrandom(2), on other
+ * POSIX systems from /dev/urandom.
+ *
+ * If {@code __CRYPTID_RANDOM_POOL} is defined, small requests are served from a
+ * per-thread pool refilled 4 KiB at a time, so they cost a copy instead of a
+ * system call. The pool needs POSIX threads for its fork handler.
  *
  * ## Parameters
  *
@@ -7,6 +7,50 @@
 #include "elliptic/EllipticCurve.h"
 #include "util/Status.h"
 
+/**
+ * ## Description
+ *
+ * Fills the passed buffer with cryptographically secure random octets. Every
+ * function of this module draws from here.
+ *
+ * The octets come from an HMAC_DRBG of NIST SP 800-90A (see HmacDrbg.h), one
+ * per thread if the library is built with __CRYPTID_PTHREADS. The generator is
+ * seeded from cryptid_randomBytes on first use, reseeded from it after every
+ * 65536 requests, and, with __CRYPTID_PTHREADS, discarded in a forked child.
+ * After random_setSeed the generator is seeded explicitly instead.
+ *
+ * ## Parameters
+ *
+ *   * output
+ *     * The buffer to fill.
+ *   * outputLength
+ *     * The size of the buffer.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the generator could not be seeded.
+ */
+CryptidStatus random_bytes(unsigned char *output, const size_t outputLength);
+
+/**
+ * ## Description
+ *
+ * Seeds the generator of the calling thread explicitly, making its output, and
+ * so every random value it draws, reproducible. The generator is not reseeded
+ * from the operating system until random_setSeed is called with NULL. Meant
+ * for repeatable benchmarks and tests only, since anyone knowing the seed can
+ * compute every key and nonce generated.
+ *
+ * ## Parameters
+ *
+ *   * seed
+ *     * The seed, or NULL to return to seeding from the operating system.
+ *   * seedLength
+ *     * The length of the seed, at least 32 octets for full security strength.
+ */
+void random_setSeed(const unsigned char *const seed, const size_t seedLength);
+
 /**
  * ## Description
  *
@@ -19,9 +63,14 @@
  *     * The generated random unsigned integer.
  *   * numberOfBits
  *     * The bitlength of the result.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
-void random_unsignedIntOfLength(unsigned int *randomOutput,
-                                const unsigned int numberOfBits);
+CryptidStatus random_unsignedIntOfLength(unsigned int *randomOutput,
+                                         const unsigned int numberOfBits);
 
 /**
  * ## Description
@@ -35,9 +84,14 @@ void random_unsignedIntOfLength(unsigned int *randomOutput,
  *     * The generated random unsigned integer.
  *   * range
  *     * The upper limit of the generation.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
-void random_unsignedIntInRange(unsigned int *randomOutput,
-                               const unsigned int range);
+CryptidStatus random_unsignedIntInRange(unsigned int *randomOutput,
+                                        const unsigned int range);
 
 /**
  * ## Description
@@ -51,8 +105,14 @@ void random_unsignedIntInRange(unsigned int *randomOutput,
  *     * Out parameter for the generated value.
  *   * numberOfBits
  *     * The bitlength of the result.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
-void random_mpzOfLength(mpz_t result, const unsigned int numberOfBits);
+CryptidStatus random_mpzOfLength(mpz_t result,
+                                 const unsigned int numberOfBits);
 
 /**
  * ## Description
@@ -66,8 +126,13 @@ void random_mpzOfLength(mpz_t result, const unsigned int numberOfBits);
  *     * Out parameter for the generated value.
  *   * range
  *     * The upper limit of the generation.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
-void random_mpzInRange(mpz_t result, const mpz_t range);
+CryptidStatus random_mpzInRange(mpz_t result, const mpz_t range);
 
 /**
  * ## Description
@@ -75,6 +140,8 @@ void random_mpzInRange(mpz_t result, const mpz_t range);
  * enerates a cryptographically secure random Solinas prime having the
  * specified bitlength. A Solinas prime is a prime of the form \f$2^a \pm 2^b
  * \pm 1\f$, where \f$a > b\f$.
+ * Candidates are trial divided by the odd primes below 2048 before the
+ * primality test.
  *
  * ## Parameters
  *
@@ -87,11 +154,47 @@ void random_mpzInRange(mpz_t result, const mpz_t range);
  *
  * ## Return Value
  *
- * CRYPTID_SUCCESS if everything went right.
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
 CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
                                   const unsigned int attemptLimit);
 
+/**
+ * ## Description
+ *
+ * Selects a random integer \f$r\f$ of at most {@code rBitLength} bits, such
+ * that \f$p = 12 \cdot r \cdot q - 1\f$ is a probable prime. The candidates
+ * are searched incrementally from a random starting point, and sieved by the
+ * odd primes below \f$2^{16}\f$ before the primality test.
+ *
+ * The starting points are drawn from generators derived from a single seed,
+ * which is drawn from the generator of the calling thread, and the number of
+ * the starting point. The search is spread over parallel_threadCount() threads,
+ * and the first prime from the lowest-numbered starting point is the result.
+ * The number of threads can be bounded by parallel_setThreadCount. After
+ * random_setSeed the result is therefore reproducible, whatever the number of
+ * threads.
+ *
+ * ## Parameters
+ *
+ *   * p
+ *     * Out parameter for the prime \f$p\f$.
+ *   * r
+ *     * Out parameter for the multiplier \f$r\f$.
+ *   * q
+ *     * The prime \f$q\f$.
+ *   * rBitLength
+ *     * The largest bitlength of \f$r\f$.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
+ */
+CryptidStatus random_pairingPrime(mpz_t p, mpz_t r, const mpz_t q,
+                                  const unsigned int rBitLength);
+
 /**
  * ## Description
  *
@@ -109,7 +212,8 @@ CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
  *
  * ## Return Value
  *
- * CRYPTID_SUCCESS if everything went right.
+ * CRYPTID_SUCCESS if everything went right, CRYPTID_RANDOM_GENERATION_ERROR if
+ * the random source failed.
  */
 CryptidStatus random_affinePoint(AffinePoint *result,
                                  const EllipticCurve ellipticCurve,
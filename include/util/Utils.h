@@ -61,6 +61,38 @@ CryptidStatus hashToPoint(AffinePoint *result, const char *const id,
                           const EllipticCurve ellipticCurve,
                           const HashFunction hashFunction);
 
+/**
+ * ## Description
+ *
+ * Cryptographically hashes a string to a point on the specified elliptic curve
+ * using a previously computed cofactor.
+ *
+ * ## Parameters
+ *
+ *   * result
+ *     * Out parameter storing a point of order \f$q\f$ in \f$E(F_p)\f$. On
+ * CRYPTID_SUCCESS, it must be destroyed by the caller.
+ *   * id
+ *     * A string.
+ *   * idLength
+ *     * The length of the id string.
+ *   * cofactor
+ *     * The cofactor \f$\frac{p + 1}{q}\f$, where \f$q\f$ is the order of the
+ * subgroup of interest.
+ *   * ellipticCurve
+ *     * The curve to operate on.
+ *   * hashFunction
+ *     * The hash function to use.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_SUCCESS if everything went right.
+ */
+CryptidStatus hashToPointWithCofactor(AffinePoint *result, const char *const id,
+                                      const int idLength, const mpz_t cofactor,
+                                      const EllipticCurve ellipticCurve,
+                                      const HashFunction hashFunction);
+
 /**
  * ## Description
  *
@@ -0,0 +1,143 @@
+#ifndef __CRYPTID_VALIDATION_CACHE_H
+#define __CRYPTID_VALIDATION_CACHE_H
+
+#include "gmp.h"
+
+#include "util/HashFunction.h"
+#include "util/Validation.h"
+
+/**
+ * ## Description
+ *
+ * The largest number of fingerprints the validation cache holds. Adding a
+ * fingerprint to a full cache evicts the least recently used one.
+ */
+#define VALIDATIONCACHE_CAPACITY 64
+
+/**
+ * ## Description
+ *
+ * The length in octets of a fingerprint, the output length of SHA-256.
+ */
+#define VALIDATIONCACHE_FINGERPRINT_SIZE 32
+
+/**
+ * ## Description
+ *
+ * Starts computing the fingerprint of a serialized object. The fingerprint is
+ * the SHA-256 hash of the name of the kind of the object and of its fields.
+ *
+ * ## Parameters
+ *
+ *   * contextOutput
+ *     * The hash computation to start.
+ *   * kind
+ *     * The name of the kind of the object, so objects of different kinds with
+ * equal fields have different fingerprints.
+ */
+void validationCache_fingerprintInit(HashFunctionContext *contextOutput,
+                                     const char *const kind);
+
+/**
+ * ## Description
+ *
+ * Adds an integer field to a fingerprint.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The hash computation.
+ *   * integer
+ *     * The field.
+ */
+void validationCache_fingerprintAddInteger(HashFunctionContext *context,
+                                           const mpz_t integer);
+
+/**
+ * ## Description
+ *
+ * Adds a small unsigned field, like the value of an enum, to a fingerprint.
+ *
+ * ## Parameters
+ *
+ *   * context
+ *     * The hash computation.
+ *   * value
+ *     * The field.
+ */
+void validationCache_fingerprintAddUnsigned(HashFunctionContext *context,
+                                            const unsigned long value);
+
+/**
+ * ## Description
+ *
+ * Finishes computing a fingerprint.
+ *
+ * ## Parameters
+ *
+ *   * fingerprintOutput
+ *     * VALIDATIONCACHE_FINGERPRINT_SIZE octets to hold the fingerprint.
+ *   * context
+ *     * The hash computation.
+ */
+void validationCache_fingerprintFinal(unsigned char *fingerprintOutput,
+                                      HashFunctionContext *context);
+
+/**
+ * ## Description
+ *
+ * Checks whether an object with a fingerprint has been validated. The cache is
+ * shared process-wide and is safe to use from multiple threads.
+ *
+ * ## Parameters
+ *
+ *   * fingerprint
+ *     * The fingerprint of the object.
+ *
+ * ## Return Value
+ *
+ * CRYPTID_VALIDATION_SUCCESS if the object is in the cache.
+ */
+CryptidValidationResult
+validationCache_contains(const unsigned char *const fingerprint);
+
+/**
+ * ## Description
+ *
+ * The number of times the cache has been emptied. A validation should read it
+ * before validating, and pass it to validationCache_add, so the result of a
+ * validation overlapping a policy change is not recorded.
+ *
+ * ## Return Value
+ *
+ * The current generation of the cache.
+ */
+unsigned long validationCache_generation(void);
+
+/**
+ * ## Description
+ *
+ * Records that an object with a fingerprint has been validated, unless the
+ * cache has been emptied since the validation started.
+ *
+ * ## Parameters
+ *
+ *   * fingerprint
+ *     * The fingerprint of the object.
+ *   * generation
+ *     * The value of validationCache_generation read before validating.
+ */
+void validationCache_add(const unsigned char *const fingerprint,
+                         const unsigned long generation);
+
+/**
+ * ## Description
+ *
+ * Empties the cache, so every object is fully validated again. Changing the
+ * validation policy of
+ * [PrimalityTest](codebase://util/PrimalityTest.h#primalityTest_setPolicy)
+ * empties it as well.
+ */
+void validationCache_invalidate(void);
+
+#endif
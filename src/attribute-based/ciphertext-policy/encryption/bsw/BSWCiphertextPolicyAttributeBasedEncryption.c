@@ -3,8 +3,8 @@
 #include <string.h>
 
 #include "attribute-based/ciphertext-policy/encryption/bsw/BSWCiphertextPolicyAttributeBasedEncryption.h"
+#include "complex/Cyclotomic.h"
 #include "elliptic/TatePairing.h"
-#include "util/PrimalityTest.h"
 #include "util/RandBytes.h"
 #include "util/Utils.h"
 
@@ -43,12 +43,13 @@ CryptidStatus cryptid_abe_bsw_setup(
                            Q_LENGTH_MAPPING[(int)securityLevel] - 3;
   mpz_t r, p;
   mpz_inits(r, p, NULL);
-  do {
-    random_mpzOfLength(r, lengthOfR);
-    mpz_mul_ui(p, r, 12);
-    mpz_mul(p, p, q);
-    mpz_sub_ui(p, p, 1);
-  } while (!primalityTest_isProbablePrime(p));
+  status = random_pairingPrime(p, r, q, lengthOfR);
+
+  if (status) {
+    mpz_clears(p, q, r, NULL);
+    free(masterkey);
+    return status;
+  }
 
   mpz_t zero, one;
   mpz_init_set_ui(zero, 0);
@@ -91,22 +92,38 @@ CryptidStatus cryptid_abe_bsw_setup(
   mpz_init(pMinusOne);
   mpz_sub_ui(pMinusOne, p, 1);
 
-  mpz_t alpha;
-  mpz_init(alpha);
-  random_mpzInRange(alpha, pMinusOne);
+  mpz_t alpha, beta;
+  mpz_inits(alpha, beta, NULL);
 
-  mpz_t beta;
-  mpz_init(beta);
-  random_mpzInRange(beta, pMinusOne);
+  status = random_mpzInRange(alpha, pMinusOne);
+  if (!status) {
+    status = random_mpzInRange(beta, pMinusOne);
+  }
+
+  if (status) {
+    mpz_clears(zero, one, p, q, r, pMinusOne, alpha, beta, NULL);
+    affine_destroy(pointP);
+    ellipticCurve_destroy(ec);
+    free(masterkey);
+    return status;
+  }
 
   bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey =
       malloc(sizeof(bswCiphertextPolicyAttributeBasedEncryptionPublicKey));
 
   publickey->ellipticCurve = ec;
   publickey->g = pointP;
+  mpz_init(publickey->q);
+  mpz_set(publickey->q, q);
 
-  status = affine_wNAFMultiply(&publickey->h, publickey->g, beta,
-                               publickey->ellipticCurve);
+  // \f$h\f$, \f$f\f$ and \f$g^{\alpha}\f$ all are multiples of \f$g\f$.
+  publickey->gTable = NULL;
+  bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+      publickey);
+
+  status =
+      bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+          &publickey->h, publickey, beta);
   if (status) {
     mpz_clears(p, q, r, pMinusOne, alpha, beta, NULL);
     ellipticCurve_destroy(ec);
@@ -117,8 +134,9 @@ CryptidStatus cryptid_abe_bsw_setup(
   mpz_init(betaInverse);
   mpz_invert(betaInverse, beta, q);
 
-  status = affine_wNAFMultiply(&publickey->f, publickey->g, betaInverse,
-                               publickey->ellipticCurve);
+  status =
+      bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+          &publickey->f, publickey, betaInverse);
   if (status) {
     mpz_clears(p, q, r, pMinusOne, alpha, beta, betaInverse, NULL);
     return status;
@@ -127,16 +145,14 @@ CryptidStatus cryptid_abe_bsw_setup(
   mpz_init(masterkey->beta);
   mpz_set(masterkey->beta, beta);
 
-  status = affine_wNAFMultiply(&masterkey->g_alpha, publickey->g, alpha,
-                               publickey->ellipticCurve);
+  status =
+      bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+          &masterkey->g_alpha, publickey, alpha);
   if (status) {
     mpz_clears(p, q, r, pMinusOne, alpha, beta, betaInverse, NULL);
     return status;
   }
 
-  mpz_init(publickey->q);
-  mpz_set(publickey->q, q);
-
   hashFunction_initForSecurityLevel(&(publickey->hashFunction), securityLevel);
 
   Complex pairValue;
@@ -147,7 +163,7 @@ CryptidStatus cryptid_abe_bsw_setup(
   }
 
   Complex eggalpha;
-  complex_modPow(&eggalpha, pairValue, alpha,
+  cyclotomic_pow(&eggalpha, pairValue, alpha,
                  publickey->ellipticCurve.fieldOrder);
   publickey->eggalpha = eggalpha;
   complex_destroy(pairValue);
@@ -201,6 +217,10 @@ CryptidStatus cryptid_abe_bsw_encrypt(
   bswChiphertextPolicyAttributeBasedEncryptionPublicKeyAsBinary_toBswChiphertextPolicyAttributeBasedEncryptionPublicKey(
       publickey, publickeyAsBinary);
 
+  // Every leaf of the access tree multiplies g.
+  bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+      publickey);
+
   bswCiphertextPolicyAttributeBasedEncryptionAccessTree *accessTree =
       malloc(sizeof(bswCiphertextPolicyAttributeBasedEncryptionAccessTree));
   bswChiphertextPolicyAttributeBasedEncryptionAccessTreeAsBinary_toBswChiphertextPolicyAttributeBasedEncryptionAccessTree(
@@ -212,13 +232,23 @@ CryptidStatus cryptid_abe_bsw_encrypt(
 
   mpz_t s;
   mpz_init(s);
-  random_mpzInRange(s, pMinusOne);
-  bswCiphertextPolicyAttributeBasedEncryptionAccessTreeCompute(accessTree, s,
-                                                               publickey);
+  CryptidStatus status = random_mpzInRange(s, pMinusOne);
+  if (!status) {
+    status = bswCiphertextPolicyAttributeBasedEncryptionAccessTreeCompute(
+        accessTree, s, publickey);
+  }
+
+  if (status) {
+    mpz_clears(pMinusOne, s, NULL);
+    bswCiphertextPolicyAttributeBasedEncryptionAccessTree_destroy(accessTree);
+    bswCiphertextPolicyAttributeBasedEncryptionPublicKey_destroy(publickey);
+    free(encrypted);
+    return status;
+  }
 
   encrypted->tree = accessTree;
   Complex eggalphas;
-  complex_modPow(&eggalphas, publickey->eggalpha, s,
+  cyclotomic_pow(&eggalphas, publickey->eggalpha, s,
                  publickey->ellipticCurve.fieldOrder);
 
   mpz_t M;
@@ -267,8 +297,8 @@ CryptidStatus cryptid_abe_bsw_encrypt(
   prevSet->cTildeSet = NULL;
   prevSet->last = ABE_CTILDE_SET_LAST;
 
-  CryptidStatus status = affine_wNAFMultiply(&encrypted->c, publickey->h, s,
-                                             publickey->ellipticCurve);
+  status = affine_wNAFMultiply(&encrypted->c, publickey->h, s,
+                               publickey->ellipticCurve);
   if (status) {
     mpz_clear(M);
     mpz_clears(pMinusOne, s, NULL);
@@ -309,14 +339,24 @@ CryptidStatus cryptid_abe_bsw_keygen(
   bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey =
       masterkey->publickey;
 
+  // g is multiplied once, then once for every attribute.
+  bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+      publickey);
+
   AffinePoint gR;
 
   mpz_t r;
   mpz_init(r);
-  bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(r, publickey);
-
   CryptidStatus status =
-      affine_wNAFMultiply(&gR, publickey->g, r, publickey->ellipticCurve);
+      bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(r, publickey);
+  if (status) {
+    mpz_clear(r);
+    return status;
+  }
+
+  status =
+      bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+          &gR, publickey, r);
   if (status) {
     return status;
   }
@@ -361,7 +401,12 @@ CryptidStatus cryptid_abe_bsw_keygen(
 
     mpz_t rj;
     mpz_init(rj);
-    bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(rj, publickey);
+    status =
+        bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(rj, publickey);
+    if (status) {
+      mpz_clear(rj);
+      return status;
+    }
 
     // H(j)
     AffinePoint Hj;
@@ -389,7 +434,8 @@ CryptidStatus cryptid_abe_bsw_keygen(
     // g^(rj) in CPABE publication
     AffinePoint dJa;
     status =
-        affine_wNAFMultiply(&dJa, publickey->g, rj, publickey->ellipticCurve);
+        bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+            &dJa, publickey, rj);
     if (status) {
       return status;
     }
@@ -444,20 +490,31 @@ CryptidStatus cryptid_abe_bsw_delegate(
   bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey =
       secretkey->publickey;
 
+  // g is multiplied once, then once for every attribute.
+  bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+      publickey);
+
   AffinePoint fR;
   AffinePoint gR;
 
   mpz_t r;
   mpz_init(r);
-  bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(r, publickey);
-
   CryptidStatus status =
+      bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(r, publickey);
+  if (status) {
+    mpz_clear(r);
+    return status;
+  }
+
+  status =
       affine_wNAFMultiply(&fR, publickey->f, r, publickey->ellipticCurve);
   if (status) {
     return status;
   }
 
-  status = affine_wNAFMultiply(&gR, publickey->g, r, publickey->ellipticCurve);
+  status =
+      bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+          &gR, publickey, r);
   if (status) {
     return status;
   }
@@ -486,7 +543,12 @@ CryptidStatus cryptid_abe_bsw_delegate(
 
     mpz_t rj;
     mpz_init(rj);
-    bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(rj, publickey);
+    status =
+        bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(rj, publickey);
+    if (status) {
+      mpz_clear(rj);
+      return status;
+    }
 
     // H(j)
     AffinePoint Hj;
@@ -516,7 +578,8 @@ CryptidStatus cryptid_abe_bsw_delegate(
 
     AffinePoint dJa;
     status =
-        affine_wNAFMultiply(&dJa, publickey->g, rj, publickey->ellipticCurve);
+        bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+            &dJa, publickey, rj);
     if (status) {
       return status;
     }
@@ -556,14 +619,64 @@ CryptidStatus cryptid_abe_bsw_delegate(
   return CRYPTID_SUCCESS;
 }
 
-// Subfunction of decrypt, calculating A value (result) of encrypted and
-// accessTree (node)
+// The arguments of a product of pairings. The first arguments are owned by
+// the product, the second ones point into the ciphertext.
+typedef struct bswCiphertextPolicyAttributeBasedEncryptionPairingProduct {
+  AffinePoint *ps;
+  AffinePoint *bs;
+  size_t count;
+} bswCiphertextPolicyAttributeBasedEncryptionPairingProduct;
+
+// Negates a point in place.
+static void bswCiphertextPolicyAttributeBasedEncryptionNegatePoint(
+    AffinePoint *point, const EllipticCurve ellipticCurve) {
+  if (!affine_isInfinity(*point)) {
+    mpz_sub(point->y, ellipticCurve.fieldOrder, point->y);
+    mpz_mod(point->y, point->y, ellipticCurve.fieldOrder);
+  }
+}
+
+static void bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_append(
+    bswCiphertextPolicyAttributeBasedEncryptionPairingProduct *product,
+    const AffinePoint p, const int negate, const AffinePoint b,
+    const EllipticCurve ellipticCurve) {
+  product->ps = (AffinePoint *)realloc(product->ps, (product->count + 1) *
+                                                       sizeof(AffinePoint));
+  product->bs = (AffinePoint *)realloc(product->bs, (product->count + 1) *
+                                                       sizeof(AffinePoint));
+
+  affine_init(&product->ps[product->count], p.x, p.y);
+  if (negate) {
+    bswCiphertextPolicyAttributeBasedEncryptionNegatePoint(
+        &product->ps[product->count], ellipticCurve);
+  }
+  product->bs[product->count] = b;
+  product->count++;
+}
+
+static void bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_destroy(
+    const bswCiphertextPolicyAttributeBasedEncryptionPairingProduct product) {
+  for (size_t i = 0; i < product.count; i++) {
+    affine_destroy(product.ps[i]);
+  }
+  free(product.ps);
+  free(product.bs);
+}
+
+// Subfunction of decrypt, collecting the pairings whose product is the A value
+// of encrypted and accessTree (node). By bilinearity
+// \f$e(D_j, C_y)^{\lambda} = e([\lambda]D_j, C_y)\f$, hence the Lagrange
+// coefficients are applied to the first arguments of the pairings, and the
+// whole tree is evaluated with a single multi-pairing.
 CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
-    Complex *result, int *statusCode,
+    bswCiphertextPolicyAttributeBasedEncryptionPairingProduct *product,
+    int *statusCode,
     const bswCiphertextPolicyAttributeBasedEncryptionEncryptedMessage
         *encrypted,
     const bswCiphertextPolicyAttributeBasedEncryptionSecretKey *secretkey,
     const bswCiphertextPolicyAttributeBasedEncryptionAccessTree *node) {
+  const EllipticCurve ellipticCurve = secretkey->publickey->ellipticCurve;
+
   if (bswCiphertextPolicyAttributeBasedEncryptionAccessTree_isLeaf(node)) {
     int found = -1;
     for (int i = 0; i < secretkey->numAttributes; i++) {
@@ -573,55 +686,31 @@ CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
       }
     }
     if (found >= 0) {
-      Complex pairValue;
-      CryptidStatus status = tate_performPairing(
-          &pairValue, secretkey->dJ[found], node->cY, 2,
-          secretkey->publickey->q, secretkey->publickey->ellipticCurve);
-      if (status) {
-        return status;
-      }
-
-      Complex pairValueA;
-      status = tate_performPairing(&pairValueA, secretkey->dJa[found],
-                                   node->cYa, 2, secretkey->publickey->q,
-                                   secretkey->publickey->ellipticCurve);
-      if (status) {
-        return status;
-      }
-
-      Complex pairValueAinverse;
-      status = complex_multiplicativeInverse(
-          &pairValueAinverse, pairValueA,
-          secretkey->publickey->ellipticCurve.fieldOrder);
-      if (status) {
-        return status;
-      }
-
-      complex_modMul(result, pairValue, pairValueAinverse,
-                     secretkey->publickey->ellipticCurve.fieldOrder);
-
-      complex_destroy(pairValue);
-      complex_destroy(pairValueA);
-      complex_destroy(pairValueAinverse);
+      // \f$\frac{e(D_j, C_y)}{e(D^{\prime}_j, C^{\prime}_y)} = e(D_j, C_y)
+      // \cdot e(-D^{\prime}_j, C^{\prime}_y)\f$
+      bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_append(
+          product, secretkey->dJ[found], 0, node->cY, ellipticCurve);
+      bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_append(
+          product, secretkey->dJa[found], 1, node->cYa, ellipticCurve);
 
       *statusCode = 1;
     }
   } else {
-    Complex Sx[node->numChildren];
+    size_t firstPairing[node->numChildren];
+    size_t lastPairing[node->numChildren];
     int Codes[node->numChildren];
     int num = 0;
     for (int i = 0; i < node->numChildren; i++) {
+      firstPairing[i] = product->count;
       if (node->children[i] && node->children[i] != NULL) {
-        Complex F;
         int code = 0;
         CryptidStatus status =
             bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
-                &F, &code, encrypted, secretkey, node->children[i]);
+                product, &code, encrypted, secretkey, node->children[i]);
         if (status) {
           return status;
         }
         if (code) {
-          Sx[i] = F;
           Codes[i] = 1;
           num++;
         } else {
@@ -630,6 +719,7 @@ CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
       } else {
         Codes[i] = 0;
       }
+      lastPairing[i] = product->count;
     }
 
     if (num > 0) {
@@ -642,40 +732,35 @@ CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
         }
       }
 
-      Complex fX;
-      complex_initLong(&fX, 1, 0);
+      mpz_t resultMpz;
+      mpz_init(resultMpz);
       for (int i = 0; i < num; i++) {
         int resultLagrange = Lagrange_coefficient(indexes[i], indexes, num, 0);
-        mpz_t resultMpz;
-        mpz_init_set_ui(resultMpz, abs(resultLagrange));
-        Complex res;
-        complex_modPow(&res, Sx[indexes[i] - 1], resultMpz,
-                       secretkey->publickey->ellipticCurve
-                           .fieldOrder); // Sx[indexes[c]] ^ resultLagrange
-        complex_destroy(Sx[indexes[i] - 1]);
-        Complex tmp;
-        if (resultLagrange < 0) {
-          // Workaround for a^(-b) = 1/(a^b)
-          CryptidStatus status = complex_multiplicativeInverse(
-              &tmp, res, secretkey->publickey->ellipticCurve.fieldOrder);
+        if (resultLagrange == 1) {
+          continue;
+        }
+
+        // Sx[indexes[c]] ^ resultLagrange
+        mpz_set_ui(resultMpz, abs(resultLagrange));
+        for (size_t j = firstPairing[indexes[i] - 1];
+             j < lastPairing[indexes[i] - 1]; j++) {
+          AffinePoint tmp;
+          CryptidStatus status = affine_wNAFMultiply(&tmp, product->ps[j],
+                                                     resultMpz, ellipticCurve);
           if (status) {
+            mpz_clear(resultMpz);
             return status;
           }
-          complex_destroy(res);
-        } else {
-          tmp = res;
+          affine_destroy(product->ps[j]);
+          product->ps[j] = tmp;
+          if (resultLagrange < 0) {
+            bswCiphertextPolicyAttributeBasedEncryptionNegatePoint(
+                &product->ps[j], ellipticCurve);
+          }
         }
-
-        Complex oldfX = fX;
-        // fX = fX * (Sx[indexes[c]] ^ resultLagrange)
-        complex_modMul(&fX, oldfX, tmp,
-                       secretkey->publickey->ellipticCurve.fieldOrder);
-
-        complex_destroy(oldfX);
-        complex_destroy(tmp);
-        mpz_clear(resultMpz);
       }
-      *result = fX;
+      mpz_clear(resultMpz);
+
       *statusCode = 1;
     }
   }
@@ -717,14 +802,17 @@ CryptidStatus cryptid_abe_bsw_decrypt(
         encrypted);
     return CRYPTID_ILLEGAL_PRIVATE_KEY_ERROR;
   }
-  Complex A;
+  bswCiphertextPolicyAttributeBasedEncryptionPairingProduct product = {
+      NULL, NULL, 0};
   int code = 0;
   CryptidStatus status = bswCiphertextPolicyAttributeBasedEncryptionDecryptNode(
-      &A, &code, encrypted, secretkey, encrypted->tree);
+      &product, &code, encrypted, secretkey, encrypted->tree);
   if (status) {
+    bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_destroy(product);
     return status;
   }
   if (code == 0) {
+    bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_destroy(product);
     bswCiphertextPolicyAttributeBasedEncryptionPublicKey_destroy(
         secretkey->publickey);
 
@@ -737,38 +825,31 @@ CryptidStatus cryptid_abe_bsw_decrypt(
     return CRYPTID_ILLEGAL_PRIVATE_KEY_ERROR;
   }
 
-  Complex eCD;
-  status = tate_performPairing(&eCD, encrypted->c, secretkey->d, 2,
-                               secretkey->publickey->q,
-                               secretkey->publickey->ellipticCurve);
-  if (status) {
-    return status;
-  }
-
-  Complex eCDinverse;
-  status = complex_multiplicativeInverse(
-      &eCDinverse, eCD, secretkey->publickey->ellipticCurve.fieldOrder);
+  // \f$\frac{A}{e(C, D)} = A \cdot e(-C, D)\f$ is computed together with
+  // \f$A\f$, so decryption needs a single final exponentiation.
+  bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_append(
+      &product, encrypted->c, 1, secretkey->d,
+      secretkey->publickey->ellipticCurve);
+
+  Complex AeCDinverse;
+  status = tate_performMultiPairing(
+      &AeCDinverse, product.ps, product.bs, product.count, 2,
+      secretkey->publickey->q, secretkey->publickey->ellipticCurve);
+  bswCiphertextPolicyAttributeBasedEncryptionPairingProduct_destroy(product);
   if (status) {
     return status;
   }
 
-  complex_destroy(eCD);
-
   bswCiphertextPolicyAttributeBasedEncryptionCtildeSet *lastSet =
       encrypted->cTildeSet;
   char *fullString = malloc(1);
   fullString[0] = '\0';
   // Iterating over sets of encrypted (splitted) messages
   while (lastSet->last == ABE_CTILDE_SET_NOT_LAST) {
-    Complex cTildeA;
-    complex_modMul(&cTildeA, lastSet->cTilde, A,
-                   secretkey->publickey->ellipticCurve.fieldOrder);
-
     // Finally equivalent to cTilde/(e(C, D)/A) = M
     Complex decrypted;
-    complex_modMul(&decrypted, cTildeA, eCDinverse,
+    complex_modMul(&decrypted, lastSet->cTilde, AeCDinverse,
                    secretkey->publickey->ellipticCurve.fieldOrder);
-    complex_destroy(cTildeA);
 
     size_t resultLength;
     char *tmpResult =
@@ -788,8 +869,7 @@ CryptidStatus cryptid_abe_bsw_decrypt(
     lastSet = lastSet->cTildeSet;
   }
 
-  complex_destroy(A);
-  complex_destroy(eCDinverse);
+  complex_destroy(AeCDinverse);
 
   *result = fullString;
 
@@ -67,22 +67,31 @@ CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionAccessTreeCompute(
     bswCiphertextPolicyAttributeBasedEncryptionPolynom *q =
         bswCiphertextPolicyAttributeBasedEncryptionPolynom_init(d, s,
                                                                 publickey);
+    if (!q) {
+      return CRYPTID_RANDOM_GENERATION_ERROR;
+    }
 
     int i;
     for (i = 0; i < accessTree->numChildren; i++) {
       mpz_t sum;
       mpz_init(sum);
       bswCiphertextPolicyAttributeBasedEncryptionPolynomSum(q, i + 1, sum);
-      bswCiphertextPolicyAttributeBasedEncryptionAccessTreeCompute(
-          accessTree->children[i], sum, publickey);
+      CryptidStatus status =
+          bswCiphertextPolicyAttributeBasedEncryptionAccessTreeCompute(
+              accessTree->children[i], sum, publickey);
       mpz_clear(sum);
+      if (status) {
+        bswCiphertextPolicyAttributeBasedEncryptionPolynom_destroy(q);
+        return status;
+      }
     }
 
     bswCiphertextPolicyAttributeBasedEncryptionPolynom_destroy(q);
   } else {
     AffinePoint cY;
     CryptidStatus status =
-        affine_wNAFMultiply(&cY, publickey->g, s, publickey->ellipticCurve);
+        bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+            &cY, publickey, s);
     if (status) {
       affine_destroy(cY);
       return status;
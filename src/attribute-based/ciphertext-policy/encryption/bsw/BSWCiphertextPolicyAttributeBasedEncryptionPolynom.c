@@ -1,7 +1,7 @@
 #include "attribute-based/ciphertext-policy/encryption/bsw/BSWCiphertextPolicyAttributeBasedEncryptionPolynom.h"
 
 // Returns a specified degree polinom with polynomSum(polynom, 0, sum) resulting
-// in zeroValue (qx(0) for ABE)
+// in zeroValue (qx(0) for ABE), or NULL if the random source failed
 bswCiphertextPolicyAttributeBasedEncryptionPolynom *
 bswCiphertextPolicyAttributeBasedEncryptionPolynom_init(
     const int degree, const mpz_t zeroValue,
@@ -22,8 +22,12 @@ bswCiphertextPolicyAttributeBasedEncryptionPolynom_init(
         sizeof(bswCiphertextPolicyAttributeBasedEncryptionPolynomExpression));
     polynom->children[i]->degree = i;
     mpz_init(polynom->children[i]->coeff);
-    bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
-        polynom->children[i]->coeff, publickey);
+    if (bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
+            polynom->children[i]->coeff, publickey)) {
+      polynom->degree = i;
+      bswCiphertextPolicyAttributeBasedEncryptionPolynom_destroy(polynom);
+      return NULL;
+    }
   }
   return polynom;
 }
@@ -9,5 +9,33 @@ void bswCiphertextPolicyAttributeBasedEncryptionPublicKey_destroy(
   affine_destroy(publickey->h);
   mpz_clear(publickey->q);
   complex_destroy(publickey->eggalpha);
+  if (publickey->gTable) {
+    fixedBase_destroy(*publickey->gTable);
+    free(publickey->gTable);
+  }
   free(publickey);
+}
+
+void bswCiphertextPolicyAttributeBasedEncryptionPublicKey_precomputeGenerator(
+    bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey) {
+  if (publickey->gTable) {
+    return;
+  }
+
+  publickey->gTable = malloc(sizeof(FixedBaseTable));
+  fixedBase_init(publickey->gTable, publickey->g, publickey->q,
+                 publickey->ellipticCurve);
+}
+
+CryptidStatus
+bswCiphertextPolicyAttributeBasedEncryptionPublicKey_multiplyGenerator(
+    AffinePoint *result,
+    const bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey,
+    const mpz_t s) {
+  if (publickey->gTable) {
+    return fixedBase_multiply(result, *publickey->gTable, s,
+                              publickey->ellipticCurve);
+  }
+
+  return affine_wNAFMultiply(result, publickey->g, s, publickey->ellipticCurve);
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ void bswChiphertextPolicyAttributeBasedEncryptionPublicKeyAsBinary_toBswChiphert
                             publickeyAsBinary->eggalpha);
   ellipticCurveAsBinary_toEllipticCurve(&(publickey->ellipticCurve),
                                         publickeyAsBinary->ellipticCurve);
+  publickey->gTable = NULL;
 }
 
 void bswChiphertextPolicyAttributeBasedEncryptionPublicKeyAsBinary_fromBswChiphertextPolicyAttributeBasedEncryptionPublicKey(
@@ -26,16 +26,18 @@ char *concat(const char *s1, const char *s2) {
 
 // Used for generating random numbers in the elliptic curve's fieldOrder of the
 // publickey
-void bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
+CryptidStatus bswCiphertextPolicyAttributeBasedEncryptionRandomNumber(
     mpz_t randElement,
     const bswCiphertextPolicyAttributeBasedEncryptionPublicKey *publickey) {
   mpz_t pMinusOne;
   mpz_init(pMinusOne);
   mpz_sub_ui(pMinusOne, publickey->ellipticCurve.fieldOrder, 1);
 
-  random_mpzInRange(randElement, pMinusOne);
+  CryptidStatus status = random_mpzInRange(randElement, pMinusOne);
 
   mpz_clear(pMinusOne);
+
+  return status;
 }
 
 // Returning whether an array of attributes contains a specific attribute
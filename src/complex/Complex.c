@@ -64,74 +64,247 @@ void complex_destroyMany(const size_t argumentCount, ...) {
   va_end(args);
 }
 
-void complex_modAdd(Complex *sum, const Complex augend, const Complex addend,
-                    const mpz_t modulus) {
+void complex_initScratch(ComplexScratch *scratchOutput) {
+  mpz_inits(scratchOutput->t0, scratchOutput->t1, scratchOutput->t2,
+            scratchOutput->t3, NULL);
+}
+
+void complex_destroyScratch(ComplexScratch scratch) {
+  mpz_clears(scratch.t0, scratch.t1, scratch.t2, scratch.t3, NULL);
+}
+
+void complex_set(Complex *destination, const Complex source) {
+  mpz_set(destination->real, source.real);
+  mpz_set(destination->imaginary, source.imaginary);
+}
+
+void complex_setLong(Complex *destination, const long real,
+                     const long imaginary) {
+  mpz_set_si(destination->real, real);
+  mpz_set_si(destination->imaginary, imaginary);
+}
+
+// A Complex passed by value shares its limbs with the instance of the caller,
+// but not its header, so GMP cannot tell that an operand aliases the result.
+// Should the result be reallocated, the copy would be left dangling, hence
+// such an operand is redirected to the result itself.
+static mpz_srcptr complex_unalias(const mpz_t operand, const mpz_t result) {
+  return mpz_limbs_read(operand) == mpz_limbs_read(result) ? result : operand;
+}
+
+void complex_modAddInto(Complex *sum, const Complex augend,
+                        const Complex addend, const mpz_t modulus) {
   // Calculated as
   // \f$(r_1 + r_2 \mod m, i_1 + i_2 \mod m)\f$.
-  mpz_t sumReal, sumImaginary;
-  mpz_inits(sumReal, sumImaginary, NULL);
-
-  mpz_add(sumReal, augend.real, addend.real);
-  mpz_mod(sumReal, sumReal, modulus);
+  mpz_add(sum->real, complex_unalias(augend.real, sum->real),
+          complex_unalias(addend.real, sum->real));
+  mpz_mod(sum->real, sum->real, modulus);
 
-  mpz_add(sumImaginary, augend.imaginary, addend.imaginary);
-  mpz_mod(sumImaginary, sumImaginary, modulus);
+  mpz_add(sum->imaginary, complex_unalias(augend.imaginary, sum->imaginary),
+          complex_unalias(addend.imaginary, sum->imaginary));
+  mpz_mod(sum->imaginary, sum->imaginary, modulus);
+}
 
-  complex_initMpz(sum, sumReal, sumImaginary);
-  mpz_clears(sumReal, sumImaginary, NULL);
+void complex_modSubInto(Complex *difference, const Complex minuend,
+                        const Complex subtrahend, const mpz_t modulus) {
+  // Calculated as
+  // \f$(r_1 - r_2 \mod m, i_1 - i_2 \mod m)\f$.
+  mpz_sub(difference->real, complex_unalias(minuend.real, difference->real),
+          complex_unalias(subtrahend.real, difference->real));
+  mpz_mod(difference->real, difference->real, modulus);
+
+  mpz_sub(difference->imaginary,
+          complex_unalias(minuend.imaginary, difference->imaginary),
+          complex_unalias(subtrahend.imaginary, difference->imaginary));
+  mpz_mod(difference->imaginary, difference->imaginary, modulus);
 }
 
-void complex_additiveInverse(Complex *inverse, const Complex operand,
-                             const mpz_t modulus) {
+void complex_additiveInverseInto(Complex *inverse, const Complex operand,
+                                 const mpz_t modulus) {
   // Calculated as
   // \f$(-r \mod m, -i \mod m)\f$.
-  mpz_t inverseReal, inverseImaginary;
-  mpz_inits(inverseReal, inverseImaginary, NULL);
+  mpz_neg(inverse->real, complex_unalias(operand.real, inverse->real));
+  mpz_mod(inverse->real, inverse->real, modulus);
 
-  mpz_neg(inverseReal, operand.real);
-  mpz_mod(inverseReal, inverseReal, modulus);
+  mpz_neg(inverse->imaginary,
+          complex_unalias(operand.imaginary, inverse->imaginary));
+  mpz_mod(inverse->imaginary, inverse->imaginary, modulus);
+}
 
-  mpz_neg(inverseImaginary, operand.imaginary);
-  mpz_mod(inverseImaginary, inverseImaginary, modulus);
+void complex_conjugateInto(Complex *conjugate, const Complex operand,
+                           const mpz_t modulus) {
+  // Calculated as
+  // \f$(r, -i \mod m)\f$.
+  mpz_set(conjugate->real, complex_unalias(operand.real, conjugate->real));
 
-  complex_initMpz(inverse, inverseReal, inverseImaginary);
-  mpz_clears(inverseReal, inverseImaginary, NULL);
+  mpz_neg(conjugate->imaginary,
+          complex_unalias(operand.imaginary, conjugate->imaginary));
+  mpz_mod(conjugate->imaginary, conjugate->imaginary, modulus);
 }
 
-void complex_modAddInteger(Complex *sum, const Complex augend,
-                           const mpz_t addend, const mpz_t modulus) {
+void complex_modAddIntegerInto(Complex *sum, const Complex augend,
+                               const mpz_t addend, const mpz_t modulus) {
   // Calculated as
   // \f$(r + a \mod m, i)\f$.
-  mpz_t sumReal;
-  mpz_init(sumReal);
+  mpz_add(sum->real, complex_unalias(augend.real, sum->real), addend);
+  mpz_mod(sum->real, sum->real, modulus);
 
-  mpz_add(sumReal, augend.real, addend);
-  mpz_mod(sumReal, sumReal, modulus);
+  mpz_set(sum->imaginary, complex_unalias(augend.imaginary, sum->imaginary));
+}
 
-  complex_initMpz(sum, sumReal, augend.imaginary);
-  mpz_clear(sumReal);
+void complex_modMulInto(Complex *product, const Complex multiplier,
+                        const Complex multiplicand, const mpz_t modulus,
+                        ComplexScratch *scratch) {
+  // Calculated as
+  // \f$((r_1 \cdot r_2 - i_1 \cdot i_2) \mod m, (i_1 \cdot r_2 + r_1 \cdot i_2)
+  // \mod m)\f$
+  // with three multiplications, where the imaginary part is obtained as
+  // \f$(r_1 + i_1)(r_2 + i_2) - r_1 \cdot r_2 - i_1 \cdot i_2\f$. The
+  // partial results are left unreduced, so there is a single reduction per
+  // coordinate.
+  //
+  // Every operand is read before the first write to product, which may
+  // therefore alias either operand.
+  mpz_mul(scratch->t0, multiplier.real, multiplicand.real);
+  mpz_mul(scratch->t1, multiplier.imaginary, multiplicand.imaginary);
+  mpz_add(scratch->t2, multiplier.real, multiplier.imaginary);
+  mpz_add(scratch->t3, multiplicand.real, multiplicand.imaginary);
+  mpz_mul(scratch->t2, scratch->t2, scratch->t3);
+
+  mpz_sub(scratch->t2, scratch->t2, scratch->t0);
+  mpz_sub(scratch->t2, scratch->t2, scratch->t1);
+  mpz_mod(product->imaginary, scratch->t2, modulus);
+
+  mpz_sub(scratch->t0, scratch->t0, scratch->t1);
+  mpz_mod(product->real, scratch->t0, modulus);
+}
+
+void complex_modSquareInto(Complex *square, const Complex operand,
+                           const mpz_t modulus, ComplexScratch *scratch) {
+  // Calculated as
+  // \f$((r + i)(r - i) \mod m, 2 \cdot r \cdot i \mod m)\f$
+  // with two multiplications and a single reduction per coordinate.
+  mpz_add(scratch->t0, operand.real, operand.imaginary);
+  mpz_sub(scratch->t1, operand.real, operand.imaginary);
+  mpz_mul(scratch->t0, scratch->t0, scratch->t1);
+  mpz_mul(scratch->t2, operand.real, operand.imaginary);
+
+  mpz_mod(square->real, scratch->t0, modulus);
+
+  mpz_mul_2exp(scratch->t2, scratch->t2, 1);
+  mpz_mod(square->imaginary, scratch->t2, modulus);
+}
+
+void complex_modMulIntegerInto(Complex *product, const mpz_t multiplier,
+                               const Complex multiplicand,
+                               const mpz_t modulus) {
+  // Calculated as
+  // \f$(r \cdot s \mod m, i \cdot s \mod m)\f$.
+  mpz_mul(product->real, multiplier,
+          complex_unalias(multiplicand.real, product->real));
+  mpz_mod(product->real, product->real, modulus);
+
+  mpz_mul(product->imaginary, multiplier,
+          complex_unalias(multiplicand.imaginary, product->imaginary));
+  mpz_mod(product->imaginary, product->imaginary, modulus);
+}
+
+CryptidStatus complex_multiplicativeInverseInto(Complex *inverse,
+                                                const Complex operand,
+                                                const mpz_t modulus,
+                                                ComplexScratch *scratch) {
+  // The inverse of z is z^{-1} = \frac{1}{z} =
+  // \frac{r}{r^2+i^2}-\frac{i}{r^2+i^2}
+
+  // (0, 0) has no multiplicative inverse.
+  if (!mpz_sgn(operand.real) && !mpz_sgn(operand.imaginary)) {
+    return CRYPTID_HAS_NO_MUL_INV_ERROR;
+  }
+
+  // If the Complex instance only holds a real value, we can fallback to
+  // simple inverse: \f$(r^{-1}, 0)\f$.
+  if (!mpz_sgn(operand.imaginary)) {
+    mpz_invert(inverse->real, complex_unalias(operand.real, inverse->real),
+               modulus);
+    mpz_set_ui(inverse->imaginary, 0);
+    return CRYPTID_SUCCESS;
+  }
+
+  // Likewise, if the Complex instance only holds an imaginary value, we
+  // can simplify things: \f$(0, -i^{-1})\f$.
+  if (!mpz_sgn(operand.real)) {
+    mpz_invert(inverse->imaginary,
+               complex_unalias(operand.imaginary, inverse->imaginary),
+               modulus);
+    mpz_neg(inverse->imaginary, inverse->imaginary);
+    mpz_mod(inverse->imaginary, inverse->imaginary, modulus);
+    mpz_set_ui(inverse->real, 0);
+    return CRYPTID_SUCCESS;
+  }
+
+  // \f$(r^2 + i^2)^{-1}\f$
+  mpz_mul(scratch->t0, operand.real, operand.real);
+  mpz_addmul(scratch->t0, operand.imaginary, operand.imaginary);
+  mpz_mod(scratch->t0, scratch->t0, modulus);
+  mpz_invert(scratch->t0, scratch->t0, modulus);
+
+  mpz_mul(inverse->real, complex_unalias(operand.real, inverse->real),
+          scratch->t0);
+  mpz_mod(inverse->real, inverse->real, modulus);
+
+  mpz_mul(inverse->imaginary,
+          complex_unalias(operand.imaginary, inverse->imaginary),
+          scratch->t0);
+  mpz_neg(inverse->imaginary, inverse->imaginary);
+  mpz_mod(inverse->imaginary, inverse->imaginary, modulus);
+
+  return CRYPTID_SUCCESS;
+}
+
+void complex_modAdd(Complex *sum, const Complex augend, const Complex addend,
+                    const mpz_t modulus) {
+  complex_init(sum);
+  complex_modAddInto(sum, augend, addend, modulus);
+}
+
+void complex_additiveInverse(Complex *inverse, const Complex operand,
+                             const mpz_t modulus) {
+  complex_init(inverse);
+  complex_additiveInverseInto(inverse, operand, modulus);
+}
+
+void complex_conjugate(Complex *conjugate, const Complex operand,
+                       const mpz_t modulus) {
+  complex_init(conjugate);
+  complex_conjugateInto(conjugate, operand, modulus);
+}
+
+void complex_modAddInteger(Complex *sum, const Complex augend,
+                           const mpz_t addend, const mpz_t modulus) {
+  complex_init(sum);
+  complex_modAddIntegerInto(sum, augend, addend, modulus);
 }
 
 void complex_modMul(Complex *product, const Complex multiplier,
                     const Complex multiplicand, const mpz_t modulus) {
-  // Calculated as
-  // \f$((r_1 \cdot r_2 - i_1 \cdot i_2) \mod m, (i_1 \cdot r_2 + r_1 \cdot i_2)
-  // \mod m)\f$.
-  mpz_t productReal, productImaginary, leftProduct, rightProduct;
-  mpz_inits(productReal, productImaginary, leftProduct, rightProduct, NULL);
-
-  mpz_mul(leftProduct, multiplier.real, multiplicand.real);
-  mpz_mul(rightProduct, multiplier.imaginary, multiplicand.imaginary);
-  mpz_sub(productReal, leftProduct, rightProduct);
-  mpz_mod(productReal, productReal, modulus);
-
-  mpz_mul(leftProduct, multiplier.imaginary, multiplicand.real);
-  mpz_mul(rightProduct, multiplier.real, multiplicand.imaginary);
-  mpz_add(productImaginary, leftProduct, rightProduct);
-  mpz_mod(productImaginary, productImaginary, modulus);
-
-  complex_initMpz(product, productReal, productImaginary);
-  mpz_clears(productReal, productImaginary, leftProduct, rightProduct, NULL);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+
+  complex_init(product);
+  complex_modMulInto(product, multiplier, multiplicand, modulus, &scratch);
+
+  complex_destroyScratch(scratch);
+}
+
+void complex_modSquare(Complex *square, const Complex operand,
+                       const mpz_t modulus) {
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+
+  complex_init(square);
+  complex_modSquareInto(square, operand, modulus, &scratch);
+
+  complex_destroyScratch(scratch);
 }
 
 void complex_modPow(Complex *power, const Complex base, const mpz_t exponent,
@@ -141,120 +314,56 @@ void complex_modPow(Complex *power, const Complex base, const mpz_t exponent,
     return;
   }
 
-  mpz_t baseRealCopy, baseImaginaryCopy, exponentCopy, exponentRemainder;
-  mpz_inits(baseRealCopy, baseImaginaryCopy, exponentCopy, exponentRemainder,
-            NULL);
-
   complex_initLong(power, 1, 0);
 
-  mpz_set(baseRealCopy, base.real);
-  mpz_mod(baseRealCopy, baseRealCopy, modulus);
-
-  mpz_set(baseImaginaryCopy, base.imaginary);
-  mpz_mod(baseImaginaryCopy, baseImaginaryCopy, modulus);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
 
   Complex baseCopy;
-  complex_initMpz(&baseCopy, baseRealCopy, baseImaginaryCopy);
-
-  mpz_set(exponentCopy, exponent);
-
-  while (mpz_cmp_ui(exponentCopy, 0) > 0) {
-    mpz_mod_ui(exponentRemainder, exponentCopy, 2);
-    if (!mpz_cmp_ui(exponentRemainder, 1)) {
-      Complex tmp;
-      complex_modMul(&tmp, baseCopy, *power, modulus);
-      complex_destroy(*power);
-      *power = tmp;
+  complex_init(&baseCopy);
+  mpz_mod(baseCopy.real, base.real, modulus);
+  mpz_mod(baseCopy.imaginary, base.imaginary, modulus);
+
+  // Right-to-left binary exponentiation.
+  const size_t bitCount = mpz_sgn(exponent) > 0 ? mpz_sizeinbase(exponent, 2)
+                                                : 0;
+  for (size_t i = 0; i < bitCount; i++) {
+    if (mpz_tstbit(exponent, i)) {
+      complex_modMulInto(power, baseCopy, *power, modulus, &scratch);
     }
 
-    mpz_fdiv_q_2exp(exponentCopy, exponentCopy, 1);
-
-    Complex tmp;
-    complex_modMul(&tmp, baseCopy, baseCopy, modulus);
-    complex_destroy(baseCopy);
-    baseCopy = tmp;
+    if (i + 1 < bitCount) {
+      complex_modSquareInto(&baseCopy, baseCopy, modulus, &scratch);
+    }
   }
 
   complex_destroy(baseCopy);
-  mpz_clears(baseRealCopy, baseImaginaryCopy, exponentCopy, exponentRemainder,
-             NULL);
+  complex_destroyScratch(scratch);
 }
 
 void complex_modMulInteger(Complex *product, const mpz_t multiplier,
                            const Complex multiplicand, const mpz_t modulus) {
-  // Calculated as
-  // \f$(r \cdot s \mod m, i \cdot s \mod m)\f$.
-  mpz_t productReal, productImaginary;
-  mpz_inits(productReal, productImaginary, NULL);
-
-  mpz_mul(productReal, multiplier, multiplicand.real);
-  mpz_mod(productReal, productReal, modulus);
-
-  mpz_mul(productImaginary, multiplier, multiplicand.imaginary);
-  mpz_mod(productImaginary, productImaginary, modulus);
-
-  complex_initMpz(product, productReal, productImaginary);
-  mpz_clears(productReal, productImaginary, NULL);
+  complex_init(product);
+  complex_modMulIntegerInto(product, multiplier, multiplicand, modulus);
 }
 
-// The inverse of z is z^{-1} = \frac{1}{z} =
-// \frac{r}{r^2+i^2}-\frac{i}{r^2+i^2}
 CryptidStatus complex_multiplicativeInverse(Complex *inverse,
                                             const Complex operand,
                                             const mpz_t modulus) {
-  mpz_t inverseReal, inverseImaginary, denominator, opRealSquare, opImagSquare,
-      denomInverse, negImaginary;
-
-  // (0, 0) has no multiplicative inverse.
-  if (!mpz_cmp_ui(operand.real, 0) && !mpz_cmp_ui(operand.imaginary, 0)) {
+  // (0, 0) has no multiplicative inverse, in which case inverse is left
+  // uninitialized.
+  if (!mpz_sgn(operand.real) && !mpz_sgn(operand.imaginary)) {
     return CRYPTID_HAS_NO_MUL_INV_ERROR;
   }
 
-  mpz_inits(inverseReal, inverseImaginary, denominator, opRealSquare,
-            opImagSquare, denomInverse, negImaginary, NULL);
-
-  // If the Complex instance only holds a real value, we can fallback to
-  // simple inverse: \f$(r^{-1}, 0)\f$.
-  if (!mpz_cmp_ui(operand.imaginary, 0)) {
-    mpz_invert(inverseReal, operand.real, modulus);
-    complex_initMpzLong(inverse, inverseReal, 0);
-
-    mpz_clears(inverseReal, inverseImaginary, denominator, opRealSquare,
-               opImagSquare, denomInverse, negImaginary, NULL);
-    return CRYPTID_SUCCESS;
-  }
-
-  // Likewise, if the Complex instance only holds an imaginary value, we
-  // can simplify things: \f$(0, -i^{-1})\f$.
-  if (!mpz_cmp_ui(operand.real, 0)) {
-    mpz_invert(inverseImaginary, operand.imaginary, modulus);
-    mpz_neg(inverseImaginary, inverseImaginary);
-    mpz_mod(inverseImaginary, inverseImaginary, modulus);
-    complex_initLongMpz(inverse, 0, inverseImaginary);
-
-    mpz_clears(inverseReal, inverseImaginary, denominator, opRealSquare,
-               opImagSquare, denomInverse, negImaginary, NULL);
-    return CRYPTID_SUCCESS;
-  }
-
-  mpz_pow_ui(opRealSquare, operand.real, 2);
-  mpz_pow_ui(opImagSquare, operand.imaginary, 2);
-  mpz_add(denominator, opRealSquare, opImagSquare);
-  mpz_mod(denominator, denominator, modulus);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
 
-  mpz_invert(denomInverse, denominator, modulus);
+  complex_init(inverse);
+  CryptidStatus status =
+      complex_multiplicativeInverseInto(inverse, operand, modulus, &scratch);
 
-  mpz_mul(inverseReal, operand.real, denomInverse);
-  mpz_mod(inverseReal, inverseReal, modulus);
+  complex_destroyScratch(scratch);
 
-  mpz_neg(negImaginary, operand.imaginary);
-  mpz_mod(negImaginary, negImaginary, modulus);
-
-  mpz_mul(inverseImaginary, negImaginary, denomInverse);
-  mpz_mod(inverseImaginary, inverseImaginary, modulus);
-
-  complex_initMpz(inverse, inverseReal, inverseImaginary);
-  mpz_clears(inverseReal, inverseImaginary, denominator, opRealSquare,
-             opImagSquare, denomInverse, negImaginary, NULL);
-  return CRYPTID_SUCCESS;
+  return status;
 }
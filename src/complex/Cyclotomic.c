@@ -0,0 +1,227 @@
+#include <stdlib.h>
+
+#include "complex/Cyclotomic.h"
+
+// References:
+//   * [Guide-to-ECC] Darrel Hankerson, Alfred J. Menezes, and Scott Vanstone.
+//   2010. Guide to Elliptic Curve Cryptography (1st ed.). Springer Publishing
+//   Company, Incorporated.
+
+// The number of NAF digits kept in automatic storage, enough for any exponent
+// below the modulus of the highest security level.
+#define CYCLOTOMIC_INLINE_NAF_LENGTH                                           \
+  (MONTGOMERY_FIELD_MAX_LEVEL_LIMB_COUNT * MONTGOMERY_FIELD_LIMB_BITS + 1)
+
+// Squares value in place. tmp is used as scratch space.
+static void cyclotomic_squareInPlace(Complex *value, mpz_t tmp,
+                                     const mpz_t modulus) {
+  // \f$(a + b)^2 - 1\f$
+  mpz_add(tmp, value->real, value->imaginary);
+  mpz_mul(tmp, tmp, tmp);
+  mpz_sub_ui(tmp, tmp, 1);
+  mpz_mod(value->imaginary, tmp, modulus);
+
+  // \f$2a^2 - 1\f$
+  mpz_mul(tmp, value->real, value->real);
+  mpz_mul_2exp(tmp, tmp, 1);
+  mpz_sub_ui(tmp, tmp, 1);
+  mpz_mod(value->real, tmp, modulus);
+}
+
+void cyclotomic_square(Complex *square, const Complex operand,
+                       const mpz_t modulus) {
+  mpz_t tmp;
+  mpz_init(tmp);
+
+  complex_initMpz(square, operand.real, operand.imaginary);
+  cyclotomic_squareInPlace(square, tmp, modulus);
+
+  mpz_clear(tmp);
+}
+
+void cyclotomic_inverse(Complex *inverse, const Complex operand,
+                        const mpz_t modulus) {
+  // \f$z \cdot \overline{z} = a^2 + b^2 = 1\f$
+  complex_conjugate(inverse, operand, modulus);
+}
+
+// The temporaries of the exponentiation in Montgomery representation.
+typedef struct CyclotomicScratch {
+  mp_limb_t *one;
+  mp_limb_t *ac;
+  mp_limb_t *bd;
+  mp_limb_t *t0;
+  mp_limb_t *t1;
+} CyclotomicScratch;
+
+// Squares value in place, as in cyclotomic_squareInPlace.
+static void cyclotomic_squareMontgomery(mp_limb_t *value,
+                                        CyclotomicScratch *scratch,
+                                        MontgomeryField *field) {
+  mp_limb_t *real = value;
+  mp_limb_t *imaginary = value + field->limbCount;
+
+  // \f$(a + b)^2 - 1\f$
+  montgomeryField_add(scratch->t0, real, imaginary, field);
+  montgomeryField_sqr(scratch->t0, scratch->t0, field);
+  montgomeryField_sub(imaginary, scratch->t0, scratch->one, field);
+
+  // \f$2a^2 - 1\f$
+  montgomeryField_sqr(scratch->t0, real, field);
+  montgomeryField_add(scratch->t0, scratch->t0, scratch->t0, field);
+  montgomeryField_sub(real, scratch->t0, scratch->one, field);
+}
+
+// Multiplies value by factor in place using three \f$F_p\f$ multiplications.
+static void cyclotomic_mulMontgomery(mp_limb_t *value,
+                                     const mp_limb_t *factor,
+                                     CyclotomicScratch *scratch,
+                                     MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+  mp_limb_t *real = value;
+  mp_limb_t *imaginary = value + n;
+
+  montgomeryField_mul(scratch->ac, real, factor, field);
+  montgomeryField_mul(scratch->bd, imaginary, factor + n, field);
+
+  // \f$(a + b)(c + d) - ac - bd = ad + bc\f$
+  montgomeryField_add(scratch->t0, real, imaginary, field);
+  montgomeryField_add(scratch->t1, factor, factor + n, field);
+  montgomeryField_mul(scratch->t0, scratch->t0, scratch->t1, field);
+  montgomeryField_sub(scratch->t0, scratch->t0, scratch->ac, field);
+  montgomeryField_sub(imaginary, scratch->t0, scratch->bd, field);
+
+  montgomeryField_sub(real, scratch->ac, scratch->bd, field);
+}
+
+// Computes the width-\f$w\f$ NAF of the absolute value of the exponent, least
+// significant digit first, with every digit negated for a negative exponent.
+// nafForm should have room for one digit more than the bit length of the
+// exponent. k is used as scratch space.
+static size_t cyclotomic_nafDigits(signed char *nafForm, const mpz_t exponent,
+                                   mpz_t k) {
+  const unsigned long twoPowW = 1UL << CYCLOTOMIC_WINDOW_WIDTH;
+  const unsigned long twoPowWSubOne = twoPowW >> 1;
+
+  // Implementation of Algorithm 3.35 in [Guide-to-ECC], applied to the
+  // absolute value of the exponent.
+  mpz_abs(k, exponent);
+  const int sign = mpz_sgn(exponent);
+
+  size_t nafLength = 0;
+  while (mpz_sgn(k) > 0) {
+    int digit = 0;
+    if (mpz_odd_p(k)) {
+      // \f$k mods 2^w\f$
+      const unsigned long mod = mpz_fdiv_ui(k, twoPowW);
+      if (mod >= twoPowWSubOne) {
+        digit = -(int)(twoPowW - mod);
+        mpz_add_ui(k, k, twoPowW - mod);
+      } else {
+        digit = (int)mod;
+        mpz_sub_ui(k, k, mod);
+      }
+    }
+    nafForm[nafLength++] = (signed char)(sign * digit);
+    mpz_fdiv_q_2exp(k, k, 1);
+  }
+
+  return nafLength;
+}
+
+void cyclotomic_powMontgomery(mp_limb_t *power, const mp_limb_t *base,
+                              const mpz_t exponent, mp_limb_t *limbs,
+                              MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+  const size_t tableSize = ((size_t)1 << CYCLOTOMIC_WINDOW_WIDTH) >> 2;
+
+  // The odd powers \f$g^{2j + 1}\f$, their inverses \f$\overline{g^{2j +
+  // 1}}\f$ and \f$g^2\f$, two \f$F_p\f$ elements each, then the scratch.
+  mp_limb_t *positivePowers = limbs;
+  mp_limb_t *negativePowers = positivePowers + 2 * n * tableSize;
+  mp_limb_t *baseSquared = negativePowers + 2 * n * tableSize;
+
+  CyclotomicScratch scratch;
+  scratch.one = baseSquared + 2 * n;
+  scratch.ac = scratch.one + n;
+  scratch.bd = scratch.ac + n;
+  scratch.t0 = scratch.bd + n;
+  scratch.t1 = scratch.t0 + n;
+  mpz_set_ui(field->conversion, 1);
+  montgomeryField_fromMpz(scratch.one, field->conversion, field);
+
+  mpn_copyi(positivePowers, base, 2 * n);
+  mpn_copyi(baseSquared, base, 2 * n);
+  cyclotomic_squareMontgomery(baseSquared, &scratch, field);
+  for (size_t i = 1; i < tableSize; i++) {
+    mp_limb_t *previous = positivePowers + 2 * n * (i - 1);
+    mpn_copyi(previous + 2 * n, previous, 2 * n);
+    cyclotomic_mulMontgomery(previous + 2 * n, baseSquared, &scratch, field);
+  }
+  for (size_t i = 0; i < tableSize; i++) {
+    mpn_copyi(negativePowers + 2 * n * i, positivePowers + 2 * n * i, n);
+    montgomeryField_neg(negativePowers + 2 * n * i + n,
+                        positivePowers + 2 * n * i + n, field);
+  }
+
+  signed char inlineNafForm[CYCLOTOMIC_INLINE_NAF_LENGTH];
+  signed char *nafForm = inlineNafForm;
+  const size_t maxNafLength = mpz_sizeinbase(exponent, 2) + 1;
+  if (maxNafLength > CYCLOTOMIC_INLINE_NAF_LENGTH) {
+    nafForm = (signed char *)malloc(maxNafLength);
+  }
+  const size_t nafLength =
+      cyclotomic_nafDigits(nafForm, exponent, field->conversion);
+
+  mpn_copyi(power, scratch.one, n);
+  mpn_zero(power + n, n);
+
+  // Implementation of Algorithm 3.36 in [Guide-to-ECC], with point doubling
+  // and addition replaced by squaring and multiplication.
+  int started = 0;
+  for (size_t j = nafLength; j > 0; j--) {
+    if (started) {
+      cyclotomic_squareMontgomery(power, &scratch, field);
+    }
+
+    const int digit = nafForm[j - 1];
+    if (digit != 0) {
+      const mp_limb_t *factor =
+          digit > 0 ? positivePowers + 2 * n * ((digit - 1) / 2)
+                    : negativePowers + 2 * n * ((-digit - 1) / 2);
+      if (started) {
+        cyclotomic_mulMontgomery(power, factor, &scratch, field);
+      } else {
+        mpn_copyi(power, factor, 2 * n);
+        started = 1;
+      }
+    }
+  }
+
+  if (nafForm != inlineNafForm) {
+    free(nafForm);
+  }
+}
+
+void cyclotomic_pow(Complex *power, const Complex base, const mpz_t exponent,
+                    const mpz_t modulus) {
+  MontgomeryField field;
+  montgomeryField_init(&field, modulus);
+  const mp_size_t n = field.limbCount;
+
+  mp_limb_t *element;
+  montgomeryField_initElements(
+      &element, 2 + CYCLOTOMIC_POW_SCRATCH_ELEMENT_COUNT, &field);
+  montgomeryField_fromMpz(element, base.real, &field);
+  montgomeryField_fromMpz(element + n, base.imaginary, &field);
+
+  cyclotomic_powMontgomery(element, element, exponent, element + 2 * n,
+                           &field);
+
+  complex_init(power);
+  montgomeryField_toMpz(power->real, element, &field);
+  montgomeryField_toMpz(power->imaginary, element + n, &field);
+
+  free(element);
+  montgomeryField_destroy(field);
+}
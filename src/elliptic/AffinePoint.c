@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "elliptic/AffinePoint.h"
+#include "elliptic/JacobianPoint.h"
 
 // References:
 //   * [Guide-to-ECC] Darrel Hankerson, Alfred J. Menezes, and Scott Vanstone.
@@ -47,12 +48,9 @@ int affine_isEquals(const AffinePoint affinePoint1,
 }
 
 int affine_isInfinity(const AffinePoint affinePoint) {
-  AffinePoint infty = affine_infinity();
-
-  int result = affine_isEquals(infty, affinePoint);
-  affine_destroy(infty);
-
-  return result;
+  // The infinity point is represented as \f$(-1, -1)\f$, see
+  // {@code affine_infinity}.
+  return !mpz_cmp_si(affinePoint.x, -1) && !mpz_cmp_si(affinePoint.y, -1);
 }
 
 CryptidStatus affine_double(AffinePoint *result, const AffinePoint affinePoint,
@@ -184,71 +182,6 @@ CryptidStatus affine_add(AffinePoint *result, const AffinePoint affinePoint1,
   return CRYPTID_SUCCESS;
 }
 
-static CryptidStatus affine_multiply(AffinePoint *result,
-                                     const AffinePoint affinePoint,
-                                     const mpz_t s,
-                                     const EllipticCurve ellipticCurve) {
-  // Implementation of Algorithm 3.26 in [Guide-to-ECC].
-
-  // Multiplication by zero yields infinity.
-  if (!mpz_cmp_ui(s, 0)) {
-    *result = affine_infinity();
-    return CRYPTID_SUCCESS;
-  }
-
-  // Multiplying infinity yields infinity.
-  if (affine_isInfinity(affinePoint)) {
-    *result = affine_infinity();
-    return CRYPTID_SUCCESS;
-  }
-
-  AffinePoint pointN;
-  affine_init(&pointN, affinePoint.x, affinePoint.y);
-  // \f$Q = \infty\f$
-  AffinePoint pointQ = affine_infinity();
-
-  // Binary expansion of the multiplier.
-  char *d = mpz_get_str(NULL, 2, s);
-
-  // Right-to-left iteration
-  for (int i = strlen(d) - 1; i >= 0; i--) {
-    CryptidStatus status;
-
-    // If \f$k_i = 1\f$ then \f$Q = Q + P\f$.
-    if (d[i] == '1') {
-      AffinePoint tmp;
-      status = affine_add(&tmp, pointQ, pointN, ellipticCurve);
-      if (status) {
-        affine_destroy(pointN);
-        affine_destroy(pointQ);
-        free(d);
-        return status;
-      }
-      affine_destroy(pointQ);
-      pointQ = tmp;
-    }
-
-    // \f$P = 2P\f$
-    AffinePoint tmp;
-    status = affine_double(&tmp, pointN, ellipticCurve);
-    if (status) {
-      affine_destroy(pointN);
-      affine_destroy(pointQ);
-      free(d);
-      return status;
-    }
-    affine_destroy(pointN);
-    pointN = tmp;
-  }
-
-  free(d);
-
-  affine_destroy(pointN);
-
-  *result = pointQ;
-  return CRYPTID_SUCCESS;
-}
-
 CryptidStatus affine_wNAFMultiply(AffinePoint *result,
                                   const AffinePoint affinePoint, const mpz_t s,
                                   const EllipticCurve ellipticCurve) {
@@ -263,51 +196,35 @@ CryptidStatus affine_wNAFMultiply(AffinePoint *result,
   // Defination of the window size.
   int twoPowW = 32;
   int twoPowWSubOne = 16;
-  AffinePoint preCalculatedPoints[16];
+  JacobianPoint preCalculatedPoints[16];
   int *nafForm = (int *)calloc(0, sizeof(int));
 
-  mpz_t yNegate, yNegateModP, tmpS;
-  mpz_inits(yNegate, yNegateModP, NULL);
-  mpz_neg(yNegate, affinePoint.y);
-  mpz_mod(yNegateModP, yNegate, ellipticCurve.fieldOrder);
-
-  // \f$-1 \cdot P = (x, -y) and 1 \cdot P = P\f$.
-  affine_init(&(preCalculatedPoints[0]), affinePoint.x, yNegateModP);
-  affine_init(&(preCalculatedPoints[1]), affinePoint.x, affinePoint.y);
-  mpz_clears(yNegate, yNegateModP, NULL);
-
-  int actualIndex = 2;
-
-  CryptidStatus status;
-
-  // The others need to be computed with small multiplications.
-  for (int i = 3; i < twoPowWSubOne; i += 2) {
-    mpz_init_set_ui(tmpS, i);
-
-    // The computation of \f$x \cdot P \f$
-    status = affine_multiply(&preCalculatedPoints[actualIndex + 1], affinePoint,
-                             tmpS, ellipticCurve);
-    if (status) {
-      mpz_clears(d, tmpS, NULL);
-      for (int j = 0; j < actualIndex; j++) {
-        affine_destroy(preCalculatedPoints[j]);
-      }
-      return status;
-    }
-
-    // If we negate the y-coordinate of the earlier computed mulitplication, we
-    // get \f$-x \cdot P\f$
-    mpz_inits(yNegate, yNegateModP, NULL);
-
-    mpz_neg(yNegate, preCalculatedPoints[actualIndex + 1].y);
-    mpz_mod(yNegateModP, yNegate, ellipticCurve.fieldOrder);
+  // Every point is kept in Jacobian coordinates over the Montgomery
+  // representation of the field, and converted back only at the end.
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ellipticCurve);
+
+  // The odd multiples \f$P, 3P, 5P, ..., 15P\f$ are computed as
+  // \f$(i + 2)P = iP + 2P\f$ and then normalized with a single inversion.
+  JacobianPoint oddMultiples[8], doubleP;
+  jacobian_initFromAffine(&oddMultiples[0], affinePoint, &curve);
+  jacobian_initInfinity(&doubleP, &curve);
+  jacobian_double(&doubleP, oddMultiples[0], &curve);
+  for (int i = 1; i < 8; i++) {
+    jacobian_initInfinity(&oddMultiples[i], &curve);
+    jacobian_add(&oddMultiples[i], oddMultiples[i - 1], doubleP, &curve);
+  }
+  jacobian_destroy(doubleP);
 
-    affine_init(&(preCalculatedPoints[actualIndex]),
-                preCalculatedPoints[actualIndex + 1].x, yNegateModP);
+  jacobian_normalizeMany(oddMultiples, 8, &curve);
 
-    actualIndex += 2;
+  // \f$-x \cdot P\f$ is computed by negating the y-coordinate of
+  // \f$x \cdot P\f$, the infinity point is its own negative.
+  for (int i = 0; i < 8; i++) {
+    preCalculatedPoints[2 * i + 1] = oddMultiples[i];
 
-    mpz_clears(yNegate, yNegateModP, tmpS, NULL);
+    jacobian_initInfinity(&preCalculatedPoints[2 * i], &curve);
+    jacobian_negate(&preCalculatedPoints[2 * i], oddMultiples[i], &curve);
   }
 
   mpz_t dModTwo, mod, dSub, dDivideTwo;
@@ -351,26 +268,17 @@ CryptidStatus affine_wNAFMultiply(AffinePoint *result,
   mpz_clear(d);
 
   // Implementation of Algorithm 3.36 in [Guide-to-ECC].
-  // Window NAF method for point multiplication
+  // Window NAF method for point multiplication. The accumulator is kept in
+  // Jacobian coordinates, so no inversion happens inside the loop.
 
   // \f$Q = \infty\f$
-  AffinePoint pointQ = affine_infinity();
+  JacobianPoint pointQ;
+  jacobian_initInfinity(&pointQ, &curve);
 
   // Iterate through the NAF form.
   for (int j = i - 1; j >= 0; j--) {
-    AffinePoint tmp;
     // \f$Q = 2 \cdot Q\f$
-    status = affine_double(&tmp, pointQ, ellipticCurve);
-    if (status) {
-      for (int o = 0; o < 16; o++) {
-        affine_destroy(preCalculatedPoints[o]);
-      }
-      affine_destroy(pointQ);
-      return status;
-    }
-    affine_destroy(pointQ);
-    affine_init(&pointQ, tmp.x, tmp.y);
-    affine_destroy(tmp);
+    jacobian_double(&pointQ, pointQ, &curve);
 
     // If the current value of the NAF form is not 0 continue with the body of
     // the if, else we jump to the next step of the iteration.
@@ -379,27 +287,20 @@ CryptidStatus affine_wNAFMultiply(AffinePoint *result,
       // Add the value of the precomputed point, which is corresponding to the
       // current NAF value, to Q.
       int index = chosen > 0 ? chosen : abs(chosen) - 1;
-      AffinePoint tmp2;
-      status =
-          affine_add(&tmp2, pointQ, preCalculatedPoints[index], ellipticCurve);
-      if (status) {
-        for (int o = 0; o < 16; o++) {
-          affine_destroy(preCalculatedPoints[o]);
-        }
-        affine_destroy(pointQ);
-        return status;
-      }
-      affine_destroy(pointQ);
-      affine_init(&pointQ, tmp2.x, tmp2.y);
-      affine_destroy(tmp2);
+      jacobian_addNormalized(&pointQ, pointQ, preCalculatedPoints[index],
+                             &curve);
     }
   }
 
   for (int o = 0; o < 16; o++) {
-    affine_destroy(preCalculatedPoints[o]);
+    jacobian_destroy(preCalculatedPoints[o]);
   }
   free(nafForm);
-  *result = pointQ;
+
+  jacobian_toAffine(result, pointQ, &curve);
+  jacobian_destroy(pointQ);
+  jacobian_destroyCurve(curve);
+
   return CRYPTID_SUCCESS;
 }
 
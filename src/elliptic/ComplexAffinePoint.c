@@ -43,12 +43,36 @@ int complexAffine_isEquals(const ComplexAffinePoint complexAffinePoint1,
 }
 
 int complexAffine_isInfinity(const ComplexAffinePoint complexAffinePoint) {
-  ComplexAffinePoint infty = complexAffine_infinity();
-
-  int result = complexAffine_isEquals(infty, complexAffinePoint);
-  complexAffine_destroy(infty);
+  // Compares against the coordinates of complexAffine_infinity without
+  // constructing it.
+  return !mpz_cmp_si(complexAffinePoint.x.real, -1) &&
+         !mpz_sgn(complexAffinePoint.x.imaginary) &&
+         !mpz_cmp_si(complexAffinePoint.y.real, -1) &&
+         !mpz_sgn(complexAffinePoint.y.imaginary);
+}
 
-  return result;
+// Completes the addition or doubling of Algorithm 3.1 in [Intro-to-IBE] once
+// the slope \f$m\f$ is known: \f$x_n = m^2 - x_1 - x_2\f$ and
+// \f$y_n = m(x_1 - x_n) - y_1\f$. m is overwritten.
+static void complexAffine_completeWithSlope(ComplexAffinePoint *result,
+                                            Complex *m,
+                                            const ComplexAffinePoint point1,
+                                            const Complex x2,
+                                            const EllipticCurve ellipticCurve,
+                                            ComplexScratch *scratch) {
+  complex_init(&result->x);
+  complex_init(&result->y);
+
+  // \f$x_n = m^{2} - x_1 - x_2\f$
+  complex_modSquareInto(&result->x, *m, ellipticCurve.fieldOrder, scratch);
+  complex_modSubInto(&result->x, result->x, point1.x, ellipticCurve.fieldOrder);
+  complex_modSubInto(&result->x, result->x, x2, ellipticCurve.fieldOrder);
+
+  // \f$y_n = m(x_1 - x_n) - y_1\f$
+  complex_modSubInto(&result->y, point1.x, result->x, ellipticCurve.fieldOrder);
+  complex_modMulInto(&result->y, *m, result->y, ellipticCurve.fieldOrder,
+                     scratch);
+  complex_modSubInto(&result->y, result->y, point1.y, ellipticCurve.fieldOrder);
 }
 
 CryptidStatus complexAffine_double(ComplexAffinePoint *result,
@@ -62,96 +86,56 @@ CryptidStatus complexAffine_double(ComplexAffinePoint *result,
     return CRYPTID_SUCCESS;
   }
 
-  Complex complexZero;
-  complex_initLong(&complexZero, 0, 0);
-
   // If the \f$y\f$ coordinate is equal to complex zero, then the result is
   // infinity.
-  if (complex_isEquals(complexAffinePoint.y, complexZero)) {
-    complex_destroy(complexZero);
+  if (!mpz_sgn(complexAffinePoint.y.real) &&
+      !mpz_sgn(complexAffinePoint.y.imaginary)) {
     *result = complexAffine_infinity();
     return CRYPTID_SUCCESS;
   }
 
-  complex_destroy(complexZero);
-
-  mpz_t tmp;
-  mpz_init_set_ui(tmp, 2);
-  Complex denom;
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+  Complex denom, num;
+  complex_init(&denom);
+  complex_init(&num);
 
   // See Equation 3.4 in [Intro-to-IBE].
   // \f$\frac{3x^{2} + a}{2y}
-  Complex twoTimesAp1y;
-  complex_modMulInteger(&twoTimesAp1y, tmp, complexAffinePoint.y,
-                        ellipticCurve.fieldOrder);
+  complex_modAddInto(&denom, complexAffinePoint.y, complexAffinePoint.y,
+                     ellipticCurve.fieldOrder);
 
   // If \f$2y\f$ has no multiplicative inverse, the above expression cannot be
   // calculated.
-  CryptidStatus status = complex_multiplicativeInverse(
-      &denom, twoTimesAp1y, ellipticCurve.fieldOrder);
+  CryptidStatus status = complex_multiplicativeInverseInto(
+      &denom, denom, ellipticCurve.fieldOrder, &scratch);
   if (status) {
-    complex_destroy(twoTimesAp1y);
-    mpz_clear(tmp);
+    complex_destroyMany(2, denom, num);
+    complex_destroyScratch(scratch);
     return status;
   }
 
-  complex_destroy(twoTimesAp1y);
-
-  mpz_set_ui(tmp, 3);
-
-  Complex ap1xSquared;
-  complex_modMul(&ap1xSquared, complexAffinePoint.x, complexAffinePoint.x,
-                 ellipticCurve.fieldOrder);
-  Complex threeTimesAp1xSquared;
-  complex_modMulInteger(&threeTimesAp1xSquared, tmp, ap1xSquared,
-                        ellipticCurve.fieldOrder);
-  Complex num;
-  complex_modAddInteger(&num, threeTimesAp1xSquared, ellipticCurve.a,
-                        ellipticCurve.fieldOrder);
-
-  Complex m;
-  complex_modMul(&m, num, denom, ellipticCurve.fieldOrder);
+  mpz_t three;
+  mpz_init_set_ui(three, 3);
 
-  complex_destroyMany(4, num, threeTimesAp1xSquared, ap1xSquared, denom);
-  mpz_clear(tmp);
+  complex_modSquareInto(&num, complexAffinePoint.x, ellipticCurve.fieldOrder,
+                        &scratch);
+  complex_modMulIntegerInto(&num, three, num, ellipticCurve.fieldOrder);
+  complex_modAddIntegerInto(&num, num, ellipticCurve.a,
+                            ellipticCurve.fieldOrder);
 
-  // Same as in {@code complexAffine_add}.
-  // \f$x_n = m^{2}-2x\f$
-  Complex x2AddInv;
-  complex_additiveInverse(&x2AddInv, complexAffinePoint.x,
-                          ellipticCurve.fieldOrder);
-  Complex mSquared;
-  complex_modMul(&mSquared, m, m, ellipticCurve.fieldOrder);
+  mpz_clear(three);
 
-  Complex x1AddInv;
-  complex_additiveInverse(&x1AddInv, complexAffinePoint.x,
-                          ellipticCurve.fieldOrder);
+  // The slope, stored in num.
+  complex_modMulInto(&num, num, denom, ellipticCurve.fieldOrder, &scratch);
 
-  Complex x1AddInvPlusx2AddInv;
-  complex_modAdd(&x1AddInvPlusx2AddInv, x1AddInv, x2AddInv,
-                 ellipticCurve.fieldOrder);
+  // Same as in {@code complexAffine_add}, with \f$x_1 = x_2 = x\f$.
+  complexAffine_completeWithSlope(result, &num, complexAffinePoint,
+                                  complexAffinePoint.x, ellipticCurve,
+                                  &scratch);
 
-  Complex xn;
-  complex_modAdd(&xn, mSquared, x1AddInvPlusx2AddInv, ellipticCurve.fieldOrder);
-
-  // \f$y_n = m(x - x_n) - y\f$
-  Complex xAddInv;
-  complex_additiveInverse(&xAddInv, xn, ellipticCurve.fieldOrder);
-  Complex q;
-  complex_modAdd(&q, complexAffinePoint.x, xAddInv, ellipticCurve.fieldOrder);
-  Complex r;
-  complex_modMul(&r, m, q, ellipticCurve.fieldOrder);
-
-  Complex y1AddInv;
-  complex_additiveInverse(&y1AddInv, complexAffinePoint.y,
-                          ellipticCurve.fieldOrder);
-  Complex yn;
-  complex_modAdd(&yn, r, y1AddInv, ellipticCurve.fieldOrder);
-
-  complexAffine_init(result, xn, yn);
-
-  complex_destroyMany(11, yn, r, q, xAddInv, xn, x1AddInvPlusx2AddInv, mSquared,
-                      x2AddInv, m, x1AddInv, y1AddInv);
+  complex_destroyMany(2, denom, num);
+  complex_destroyScratch(scratch);
 
   return CRYPTID_SUCCESS;
 }
@@ -176,8 +160,7 @@ CryptidStatus complexAffine_add(ComplexAffinePoint *result,
   // If the points are equal to each other, we can speed things up
   // by performing a point doubling instead of an addition.
   if (complexAffine_isEquals(complexAffinePoint1, complexAffinePoint2)) {
-    complexAffine_double(result, complexAffinePoint1, ellipticCurve);
-    return CRYPTID_SUCCESS;
+    return complexAffine_double(result, complexAffinePoint1, ellipticCurve);
   }
 
   // Having equal \f$x\f$ coordinates (and different points) a divide-by-zero
@@ -188,66 +171,36 @@ CryptidStatus complexAffine_add(ComplexAffinePoint *result,
     return CRYPTID_SUCCESS;
   }
 
-  Complex x1AddInv;
-  complex_additiveInverse(&x1AddInv, complexAffinePoint1.x,
-                          ellipticCurve.fieldOrder);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+  Complex denom, num;
+  complex_init(&denom);
+  complex_init(&num);
 
   // \f$\frac{y_2 - y_1}{x_2 - x_1}\f$
-  Complex ap2xPlusx1AddInv;
-  complex_modAdd(&ap2xPlusx1AddInv, complexAffinePoint2.x, x1AddInv,
-                 ellipticCurve.fieldOrder);
+  complex_modSubInto(&denom, complexAffinePoint2.x, complexAffinePoint1.x,
+                     ellipticCurve.fieldOrder);
 
-  Complex denom;
-  CryptidStatus status = complex_multiplicativeInverse(
-      &denom, ap2xPlusx1AddInv, ellipticCurve.fieldOrder);
+  CryptidStatus status = complex_multiplicativeInverseInto(
+      &denom, denom, ellipticCurve.fieldOrder, &scratch);
   if (status) {
-    complex_destroyMany(2, x1AddInv, ap2xPlusx1AddInv);
+    complex_destroyMany(2, denom, num);
+    complex_destroyScratch(scratch);
     return status;
   }
 
-  complex_destroy(ap2xPlusx1AddInv);
+  complex_modSubInto(&num, complexAffinePoint2.y, complexAffinePoint1.y,
+                     ellipticCurve.fieldOrder);
 
-  Complex y1AddInv;
-  complex_additiveInverse(&y1AddInv, complexAffinePoint1.y,
-                          ellipticCurve.fieldOrder);
-  Complex num;
-  complex_modAdd(&num, complexAffinePoint2.y, y1AddInv,
-                 ellipticCurve.fieldOrder);
+  // The slope, stored in num.
+  complex_modMulInto(&num, num, denom, ellipticCurve.fieldOrder, &scratch);
 
-  Complex m;
-  complex_modMul(&m, num, denom, ellipticCurve.fieldOrder);
+  complexAffine_completeWithSlope(result, &num, complexAffinePoint1,
+                                  complexAffinePoint2.x, ellipticCurve,
+                                  &scratch);
 
   complex_destroyMany(2, denom, num);
-
-  // \f$x_n = m^{2}-x_1-x_2\f$
-  Complex x2AddInv;
-  complex_additiveInverse(&x2AddInv, complexAffinePoint2.x,
-                          ellipticCurve.fieldOrder);
-  Complex mSquared;
-  complex_modMul(&mSquared, m, m, ellipticCurve.fieldOrder);
-
-  Complex x1AddInvPlusx2AddInv;
-  complex_modAdd(&x1AddInvPlusx2AddInv, x1AddInv, x2AddInv,
-                 ellipticCurve.fieldOrder);
-
-  Complex xn;
-  complex_modAdd(&xn, mSquared, x1AddInvPlusx2AddInv, ellipticCurve.fieldOrder);
-
-  // \f$y_n = m(x_1 - x_3) - y_n\f$
-  Complex xAddInv;
-  complex_additiveInverse(&xAddInv, xn, ellipticCurve.fieldOrder);
-  Complex q;
-  complex_modAdd(&q, complexAffinePoint1.x, xAddInv, ellipticCurve.fieldOrder);
-  Complex r;
-  complex_modMul(&r, m, q, ellipticCurve.fieldOrder);
-
-  Complex yn;
-  complex_modAdd(&yn, r, y1AddInv, ellipticCurve.fieldOrder);
-
-  complexAffine_init(result, xn, yn);
-
-  complex_destroyMany(11, yn, r, q, xAddInv, xn, x1AddInvPlusx2AddInv, mSquared,
-                      x2AddInv, m, x1AddInv, y1AddInv);
+  complex_destroyScratch(scratch);
 
   return CRYPTID_SUCCESS;
 }
@@ -331,33 +284,26 @@ int complexAffine_isOnCurve(ComplexAffinePoint point,
   // \f$y^2\f$
   // is equal to
   // \f$x^3 + ax + b\f$.
-  Complex ySquared;
-  complex_modMul(&ySquared, point.y, point.y, ellipticCurve.fieldOrder);
-  Complex xSquared;
-  complex_modMul(&xSquared, point.x, point.x, ellipticCurve.fieldOrder);
-  Complex xCubed;
-  complex_modMul(&xCubed, xSquared, point.x, ellipticCurve.fieldOrder);
-
-  Complex ax;
-  complex_modMulInteger(&ax, ellipticCurve.a, point.x,
-                        ellipticCurve.fieldOrder);
-
-  Complex xCubedPlusAx;
-  complex_modAdd(&xCubedPlusAx, xCubed, ax, ellipticCurve.fieldOrder);
-
-  mpz_t zero;
-  mpz_init_set_ui(zero, 0);
-
-  Complex b;
-  complex_initMpz(&b, ellipticCurve.b, zero);
-
-  Complex rhs;
-  complex_modAdd(&rhs, xCubedPlusAx, b, ellipticCurve.fieldOrder);
-
-  int result = complex_isEquals(ySquared, rhs);
-
-  mpz_clear(zero);
-  complex_destroyMany(7, ySquared, xSquared, xCubed, ax, xCubedPlusAx, b, rhs);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+  Complex lhs, rhs;
+  complex_init(&lhs);
+  complex_init(&rhs);
+
+  complex_modSquareInto(&lhs, point.y, ellipticCurve.fieldOrder, &scratch);
+
+  // \f$x^3 + ax + b = (x^2 + a)x + b\f$
+  complex_modSquareInto(&rhs, point.x, ellipticCurve.fieldOrder, &scratch);
+  complex_modAddIntegerInto(&rhs, rhs, ellipticCurve.a,
+                            ellipticCurve.fieldOrder);
+  complex_modMulInto(&rhs, rhs, point.x, ellipticCurve.fieldOrder, &scratch);
+  complex_modAddIntegerInto(&rhs, rhs, ellipticCurve.b,
+                            ellipticCurve.fieldOrder);
+
+  int result = complex_isEquals(lhs, rhs);
+
+  complex_destroyMany(2, lhs, rhs);
+  complex_destroyScratch(scratch);
 
   return result;
 }
@@ -30,6 +30,22 @@ void divisor_evaluateVertical(Complex *result, const AffinePoint a,
   mpz_clear(axAddInv);
 }
 
+// Evaluates \f$r = a \cdot x_B + b \cdot y_B + c\f$ at \f$B\f$, reducing once
+// per coordinate. result should be initialized.
+static void divisor_evaluateCoefficients(Complex *result, const mpz_t a,
+                                         const mpz_t b, const mpz_t c,
+                                         const ComplexAffinePoint point,
+                                         const EllipticCurve ec) {
+  mpz_mul(result->real, a, point.x.real);
+  mpz_mul(result->imaginary, a, point.x.imaginary);
+  mpz_addmul(result->real, b, point.y.real);
+  mpz_addmul(result->imaginary, b, point.y.imaginary);
+  mpz_add(result->real, result->real, c);
+
+  mpz_mod(result->real, result->real, ec.fieldOrder);
+  mpz_mod(result->imaginary, result->imaginary, ec.fieldOrder);
+}
+
 CryptidStatus divisor_evaluateTangent(Complex *result, const AffinePoint a,
                                       const ComplexAffinePoint b,
                                       const EllipticCurve ec) {
@@ -51,7 +67,6 @@ CryptidStatus divisor_evaluateTangent(Complex *result, const AffinePoint a,
     return CRYPTID_SUCCESS;
   }
 
-  Complex axB, byB, resultPart;
   mpz_t threeAddInv, minusThree, xasquared, aprime, bprime, bAddInv, bAddInvyA,
       axA, axAaddInv, c;
   mpz_inits(threeAddInv, minusThree, xasquared, aprime, bprime, bAddInv,
@@ -84,12 +99,9 @@ CryptidStatus divisor_evaluateTangent(Complex *result, const AffinePoint a,
   // Evaluation at \f$B\f$
   // Let \f$r\f$ denote the result:
   // \f$r = a^{\prime} \cdot x_B + b^{\prime} \cdot y_B + c\f$
-  complex_modMulInteger(&axB, aprime, b.x, ec.fieldOrder);
-  complex_modMulInteger(&byB, bprime, b.y, ec.fieldOrder);
-  complex_modAdd(&resultPart, axB, byB, ec.fieldOrder);
-  complex_modAddInteger(result, resultPart, c, ec.fieldOrder);
+  complex_init(result);
+  divisor_evaluateCoefficients(result, aprime, bprime, c, b, ec);
 
-  complex_destroyMany(3, axB, byB, resultPart);
   mpz_clears(threeAddInv, minusThree, xasquared, aprime, bprime, bAddInv,
              bAddInvyA, axA, axAaddInv, c, NULL);
   return CRYPTID_SUCCESS;
@@ -131,7 +143,6 @@ CryptidStatus divisor_evaluateLine(Complex *result, const AffinePoint a,
 
   mpz_t linea, lineb, linebaddinv, q, t, taddinv, linec;
   mpz_inits(linea, lineb, linebaddinv, q, t, taddinv, linec, NULL);
-  Complex axb, byb, resultPart;
 
   // Line computation
   // \f$a = y_A^{\prime} - y_A^{\prime\prime}\f$
@@ -157,13 +168,10 @@ CryptidStatus divisor_evaluateLine(Complex *result, const AffinePoint a,
   // Evaluation at B
   // Let \f$r\f$ denote the result:
   // \f$r = a \cdot x_B + b \cdot y_B + c\f$
-  complex_modMulInteger(&axb, linea, b.x, ec.fieldOrder);
-  complex_modMulInteger(&byb, lineb, b.y, ec.fieldOrder);
-  complex_modAddInteger(&resultPart, byb, linec, ec.fieldOrder);
-  complex_modAdd(result, axb, resultPart, ec.fieldOrder);
+  complex_init(result);
+  divisor_evaluateCoefficients(result, linea, lineb, linec, b, ec);
 
   mpz_clears(linea, lineb, linebaddinv, q, t, taddinv, linec, NULL);
-  complex_destroyMany(3, axb, byb, resultPart);
 
   return CRYPTID_SUCCESS;
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include "elliptic/EllipticCurve.h"
 #include "util/PrimalityTest.h"
+#include "util/ValidationCache.h"
 
 void ellipticCurve_init(EllipticCurve *ellipticCurveOutput, const mpz_t a,
                         const mpz_t b, const mpz_t fieldOrder) {
@@ -29,10 +30,29 @@ void ellipticCurve_destroy(EllipticCurve ellipticCurve) {
 
 CryptidValidationResult
 ellipticCurve_isTypeOne(const EllipticCurve ellipticCurve) {
-  if (!mpz_cmp_ui(ellipticCurve.a, 0) && !mpz_cmp_ui(ellipticCurve.b, 1) &&
-      primalityTest_isProbablePrime(ellipticCurve.fieldOrder)) {
+  if (mpz_cmp_ui(ellipticCurve.a, 0) || mpz_cmp_ui(ellipticCurve.b, 1)) {
+    return CRYPTID_VALIDATION_FAILURE;
+  }
+
+  // The primality test is skipped for curves validated before.
+  HashFunctionContext context;
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  validationCache_fingerprintInit(&context, "EllipticCurve");
+  validationCache_fingerprintAddInteger(&context, ellipticCurve.a);
+  validationCache_fingerprintAddInteger(&context, ellipticCurve.b);
+  validationCache_fingerprintAddInteger(&context, ellipticCurve.fieldOrder);
+  validationCache_fingerprintFinal(fingerprint, &context);
+
+  const unsigned long generation = validationCache_generation();
+  if (validationCache_contains(fingerprint)) {
+    return CRYPTID_VALIDATION_SUCCESS;
+  }
+
+  if (primalityTest_isProbablePrime(ellipticCurve.fieldOrder,
+                                    primalityTest_VALIDATION)) {
+    validationCache_add(fingerprint, generation);
     return CRYPTID_VALIDATION_SUCCESS;
   }
 
   return CRYPTID_VALIDATION_FAILURE;
-}
\ No newline at end of file
+}
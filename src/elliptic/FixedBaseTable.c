@@ -0,0 +1,112 @@
+#include <stdlib.h>
+
+#include "elliptic/FixedBaseTable.h"
+
+// References:
+//   * [Guide-to-ECC] Darrel Hankerson, Alfred J. Menezes, and Scott Vanstone.
+//   2010. Guide to Elliptic Curve Cryptography (1st ed.). Springer Publishing
+//   Company, Incorporated.
+
+// The number of teeth of the comb. The table holds \f$2^w\f$ points.
+static const size_t COMB_WIDTH = 6;
+
+void fixedBase_init(FixedBaseTable *tableOutput, const AffinePoint base,
+                    const mpz_t order, const EllipticCurve ellipticCurve) {
+  // Precomputation step of Algorithm 3.44 in [Guide-to-ECC].
+  const size_t width = COMB_WIDTH;
+  const size_t tableSize = (size_t)1 << width;
+  const size_t bitLength = mpz_sizeinbase(order, 2);
+
+  mpz_init_set(tableOutput->order, order);
+  tableOutput->width = width;
+  tableOutput->spacing = (bitLength + width - 1) / width;
+  tableOutput->points =
+      (JacobianPoint *)malloc(tableSize * sizeof(JacobianPoint));
+  JacobianPoint *jacobianPoints = tableOutput->points;
+
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ellipticCurve);
+
+  jacobian_initInfinity(&jacobianPoints[0], &curve);
+  jacobian_initFromAffine(&jacobianPoints[1], base, &curve);
+
+  // \f$P_j = 2^{jd}P\f$ is stored at index \f$2^j\f$, every other index is
+  // the sum of its highest power of two and the remainder.
+  for (size_t j = 1; j < width; j++) {
+    const size_t index = (size_t)1 << j;
+
+    jacobian_initInfinity(&jacobianPoints[index], &curve);
+    jacobian_set(&jacobianPoints[index], jacobianPoints[index >> 1], &curve);
+    for (size_t k = 0; k < tableOutput->spacing; k++) {
+      jacobian_double(&jacobianPoints[index], jacobianPoints[index], &curve);
+    }
+
+    for (size_t remainder = 1; remainder < index; remainder++) {
+      jacobian_initInfinity(&jacobianPoints[index + remainder], &curve);
+      jacobian_add(&jacobianPoints[index + remainder], jacobianPoints[index],
+                   jacobianPoints[remainder], &curve);
+    }
+  }
+
+  jacobian_normalizeMany(jacobianPoints, tableSize, &curve);
+
+  jacobian_destroyCurve(curve);
+}
+
+void fixedBase_destroy(FixedBaseTable table) {
+  const size_t tableSize = (size_t)1 << table.width;
+
+  for (size_t i = 0; i < tableSize; i++) {
+    jacobian_destroy(table.points[i]);
+  }
+  free(table.points);
+  mpz_clear(table.order);
+}
+
+CryptidStatus fixedBase_multiply(AffinePoint *result,
+                                 const FixedBaseTable table, const mpz_t s,
+                                 const EllipticCurve ellipticCurve) {
+  // Implementation of Algorithm 3.44 in [Guide-to-ECC].
+  // Fixed-base comb method for point multiplication.
+
+  // As the base has order \f$n\f$, \f$[s]P = [s \bmod n]P\f$.
+  mpz_t k;
+  mpz_init(k);
+  mpz_mod(k, s, table.order);
+
+  // The table is in the Montgomery representation of the field of the curve,
+  // which only depends on the field order.
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ellipticCurve);
+
+  // \f$Q = \infty\f$
+  JacobianPoint pointQ;
+  jacobian_initInfinity(&pointQ, &curve);
+
+  for (size_t i = table.spacing; i > 0; i--) {
+    const size_t column = i - 1;
+
+    // \f$Q = 2Q\f$
+    jacobian_double(&pointQ, pointQ, &curve);
+
+    // \f$Q = Q + [K_{w-1}^i, \ldots, K_0^i]P\f$, where \f$K_j^i\f$ is the
+    // bit of \f$k\f$ at position \f$jd + i\f$.
+    size_t index = 0;
+    for (size_t j = table.width; j > 0; j--) {
+      index = (index << 1) |
+              (size_t)mpz_tstbit(k, (j - 1) * table.spacing + column);
+    }
+
+    if (index) {
+      jacobian_addNormalized(&pointQ, pointQ, table.points[index], &curve);
+    }
+  }
+
+  jacobian_toAffine(result, pointQ, &curve);
+
+  jacobian_destroy(pointQ);
+  jacobian_destroyCurve(curve);
+  mpz_clear(k);
+
+  return CRYPTID_SUCCESS;
+}
@@ -0,0 +1,415 @@
+#include <stdlib.h>
+
+#include "elliptic/JacobianPoint.h"
+
+// References:
+//   * [Guide-to-ECC] Darrel Hankerson, Alfred J. Menezes, and Scott Vanstone.
+//   2010. Guide to Elliptic Curve Cryptography (1st ed.). Springer Publishing
+//   Company, Incorporated.
+
+// The number of \f$F_p\f$ temporaries of the group operations.
+#define JACOBIAN_TEMPORARY_COUNT 13
+
+// The ith temporary of a curve.
+static mp_limb_t *jacobian_temporary(const JacobianCurve *curve,
+                                     const size_t i) {
+  return curve->temporaries + i * curve->field.limbCount;
+}
+
+void jacobian_initCurve(JacobianCurve *curveOutput,
+                        const EllipticCurve ellipticCurve) {
+  montgomeryField_init(&curveOutput->field, ellipticCurve.fieldOrder);
+  const mp_size_t n = curveOutput->field.limbCount;
+
+  montgomeryField_initElements(&curveOutput->a, 2 + JACOBIAN_TEMPORARY_COUNT,
+                               &curveOutput->field);
+  curveOutput->one = curveOutput->a + n;
+  curveOutput->temporaries = curveOutput->one + n;
+
+  montgomeryField_fromMpz(curveOutput->a, ellipticCurve.a,
+                          &curveOutput->field);
+  mpz_set_ui(curveOutput->field.conversion, 1);
+  montgomeryField_fromMpz(curveOutput->one, curveOutput->field.conversion,
+                          &curveOutput->field);
+}
+
+void jacobian_destroyCurve(JacobianCurve curve) {
+  free(curve.a);
+  montgomeryField_destroy(curve.field);
+}
+
+// Allocates the coordinates of a point.
+static void jacobian_initCoordinates(JacobianPoint *jacobianPointOutput,
+                                     const JacobianCurve *curve) {
+  const mp_size_t n = curve->field.limbCount;
+
+  montgomeryField_initElements(&jacobianPointOutput->x, 3, &curve->field);
+  jacobianPointOutput->y = jacobianPointOutput->x + n;
+  jacobianPointOutput->z = jacobianPointOutput->x + 2 * n;
+}
+
+static void jacobian_setInfinity(JacobianPoint *jacobianPoint,
+                                 const JacobianCurve *curve) {
+  const mp_size_t n = curve->field.limbCount;
+
+  mpn_copyi(jacobianPoint->x, curve->one, n);
+  mpn_copyi(jacobianPoint->y, curve->one, n);
+  mpn_zero(jacobianPoint->z, n);
+}
+
+void jacobian_initInfinity(JacobianPoint *jacobianPointOutput,
+                           const JacobianCurve *curve) {
+  jacobian_initCoordinates(jacobianPointOutput, curve);
+  jacobian_setInfinity(jacobianPointOutput, curve);
+}
+
+void jacobian_initFromAffine(JacobianPoint *jacobianPointOutput,
+                             const AffinePoint affinePoint,
+                             JacobianCurve *curve) {
+  if (affine_isInfinity(affinePoint)) {
+    jacobian_initInfinity(jacobianPointOutput, curve);
+    return;
+  }
+
+  jacobian_initCoordinates(jacobianPointOutput, curve);
+  montgomeryField_fromMpz(jacobianPointOutput->x, affinePoint.x,
+                          &curve->field);
+  montgomeryField_fromMpz(jacobianPointOutput->y, affinePoint.y,
+                          &curve->field);
+  mpn_copyi(jacobianPointOutput->z, curve->one, curve->field.limbCount);
+}
+
+void jacobian_destroy(JacobianPoint jacobianPoint) { free(jacobianPoint.x); }
+
+void jacobian_set(JacobianPoint *destination, const JacobianPoint source,
+                  const JacobianCurve *curve) {
+  if (destination->x != source.x) {
+    mpn_copyi(destination->x, source.x, 3 * curve->field.limbCount);
+  }
+}
+
+int jacobian_isInfinity(const JacobianPoint jacobianPoint,
+                        const JacobianCurve *curve) {
+  return mpn_zero_p(jacobianPoint.z, curve->field.limbCount);
+}
+
+void jacobian_toAffine(AffinePoint *result, const JacobianPoint jacobianPoint,
+                       JacobianCurve *curve) {
+  if (jacobian_isInfinity(jacobianPoint, curve)) {
+    *result = affine_infinity();
+    return;
+  }
+
+  MontgomeryField *field = &curve->field;
+  mp_limb_t *zInverse = jacobian_temporary(curve, 0);
+  mp_limb_t *zInverseSquared = jacobian_temporary(curve, 1);
+  mp_limb_t *coordinate = jacobian_temporary(curve, 2);
+
+  // \f$x = \frac{X}{Z^2}, y = \frac{Y}{Z^3}\f$
+  montgomeryField_inverse(zInverse, jacobianPoint.z, field);
+  montgomeryField_sqr(zInverseSquared, zInverse, field);
+
+  mpz_inits(result->x, result->y, NULL);
+  montgomeryField_mul(coordinate, jacobianPoint.x, zInverseSquared, field);
+  montgomeryField_toMpz(result->x, coordinate, field);
+
+  montgomeryField_mul(coordinate, jacobianPoint.y, zInverseSquared, field);
+  montgomeryField_mul(coordinate, coordinate, zInverse, field);
+  montgomeryField_toMpz(result->y, coordinate, field);
+}
+
+void jacobian_normalizeMany(JacobianPoint *jacobianPoints, const size_t count,
+                            JacobianCurve *curve) {
+  // Montgomery's trick: with \f$c_i = Z_0 \cdot \ldots \cdot Z_i\f$, a single
+  // inversion of \f$c_{n-1}\f$ yields every \f$Z_i^{-1}\f$ by walking
+  // backwards. Points at infinity are skipped.
+  MontgomeryField *field = &curve->field;
+  const mp_size_t n = field->limbCount;
+
+  mp_limb_t *prefixProducts;
+  montgomeryField_initElements(&prefixProducts, count, field);
+  mp_limb_t *accumulator = jacobian_temporary(curve, 0);
+  mp_limb_t *zInverse = jacobian_temporary(curve, 1);
+  mp_limb_t *zInverseSquared = jacobian_temporary(curve, 2);
+
+  mpn_copyi(accumulator, curve->one, n);
+  for (size_t i = 0; i < count; i++) {
+    if (!jacobian_isInfinity(jacobianPoints[i], curve)) {
+      montgomeryField_mul(accumulator, accumulator, jacobianPoints[i].z,
+                          field);
+    }
+    mpn_copyi(prefixProducts + i * n, accumulator, n);
+  }
+
+  montgomeryField_inverse(accumulator, accumulator, field);
+
+  for (size_t j = count; j > 0; j--) {
+    size_t i = j - 1;
+
+    if (jacobian_isInfinity(jacobianPoints[i], curve)) {
+      continue;
+    }
+
+    // At this point the accumulator holds \f$c_i^{-1}\f$.
+    if (i > 0) {
+      montgomeryField_mul(zInverse, accumulator, prefixProducts + (i - 1) * n,
+                          field);
+    } else {
+      mpn_copyi(zInverse, accumulator, n);
+    }
+
+    montgomeryField_mul(accumulator, accumulator, jacobianPoints[i].z, field);
+
+    // \f$(X, Y, Z) \sim (\frac{X}{Z^2}, \frac{Y}{Z^3}, 1)\f$
+    montgomeryField_sqr(zInverseSquared, zInverse, field);
+    montgomeryField_mul(jacobianPoints[i].x, jacobianPoints[i].x,
+                        zInverseSquared, field);
+    montgomeryField_mul(jacobianPoints[i].y, jacobianPoints[i].y,
+                        zInverseSquared, field);
+    montgomeryField_mul(jacobianPoints[i].y, jacobianPoints[i].y, zInverse,
+                        field);
+    mpn_copyi(jacobianPoints[i].z, curve->one, n);
+  }
+
+  free(prefixProducts);
+}
+
+void jacobian_negate(JacobianPoint *result, const JacobianPoint jacobianPoint,
+                     const JacobianCurve *curve) {
+  const mp_size_t n = curve->field.limbCount;
+
+  // \f$-(X, Y, Z) = (X, -Y, Z)\f$, the infinity point is its own negative.
+  if (jacobian_isInfinity(jacobianPoint, curve)) {
+    jacobian_setInfinity(result, curve);
+    return;
+  }
+
+  mpn_copyi(result->x, jacobianPoint.x, n);
+  montgomeryField_neg(result->y, jacobianPoint.y, &curve->field);
+  mpn_copyi(result->z, jacobianPoint.z, n);
+}
+
+// Copies the coordinates computed into temporaries into the result.
+static void jacobian_setCoordinates(JacobianPoint *result, const mp_limb_t *x3,
+                                    const mp_limb_t *y3, const mp_limb_t *z3,
+                                    const JacobianCurve *curve) {
+  const mp_size_t n = curve->field.limbCount;
+
+  mpn_copyi(result->x, x3, n);
+  mpn_copyi(result->y, y3, n);
+  mpn_copyi(result->z, z3, n);
+}
+
+void jacobian_double(JacobianPoint *result, const JacobianPoint jacobianPoint,
+                     JacobianCurve *curve) {
+  // Doubling in Jacobian coordinates, see Section 3.2.2 in [Guide-to-ECC].
+  MontgomeryField *field = &curve->field;
+  const mp_size_t n = field->limbCount;
+
+  // Doubling infinity or a point with \f$Y = 0\f$ yields infinity.
+  if (jacobian_isInfinity(jacobianPoint, curve) ||
+      mpn_zero_p(jacobianPoint.y, n)) {
+    jacobian_setInfinity(result, curve);
+    return;
+  }
+
+  mp_limb_t *yy = jacobian_temporary(curve, 0);
+  mp_limb_t *s = jacobian_temporary(curve, 1);
+  mp_limb_t *m = jacobian_temporary(curve, 2);
+  mp_limb_t *t = jacobian_temporary(curve, 3);
+  mp_limb_t *x3 = jacobian_temporary(curve, 4);
+  mp_limb_t *y3 = jacobian_temporary(curve, 5);
+  mp_limb_t *z3 = jacobian_temporary(curve, 6);
+
+  // \f$Z_3 = 2YZ\f$
+  montgomeryField_mul(z3, jacobianPoint.y, jacobianPoint.z, field);
+  montgomeryField_add(z3, z3, z3, field);
+
+  // \f$M = 3X^2 + aZ^4\f$
+  montgomeryField_sqr(t, jacobianPoint.x, field);
+  montgomeryField_add(m, t, t, field);
+  montgomeryField_add(m, m, t, field);
+  if (!mpn_zero_p(curve->a, n)) {
+    montgomeryField_sqr(t, jacobianPoint.z, field);
+    montgomeryField_sqr(t, t, field);
+    montgomeryField_mul(t, t, curve->a, field);
+    montgomeryField_add(m, m, t, field);
+  }
+
+  // \f$S = 4XY^2\f$
+  montgomeryField_sqr(yy, jacobianPoint.y, field);
+  montgomeryField_mul(s, jacobianPoint.x, yy, field);
+  montgomeryField_add(s, s, s, field);
+  montgomeryField_add(s, s, s, field);
+
+  // \f$X_3 = M^2 - 2S\f$
+  montgomeryField_sqr(x3, m, field);
+  montgomeryField_sub(x3, x3, s, field);
+  montgomeryField_sub(x3, x3, s, field);
+
+  // \f$Y_3 = M(S - X_3) - 8Y^4\f$
+  montgomeryField_sub(t, s, x3, field);
+  montgomeryField_mul(y3, m, t, field);
+  montgomeryField_sqr(t, yy, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_sub(y3, y3, t, field);
+
+  jacobian_setCoordinates(result, x3, y3, z3, curve);
+}
+
+void jacobian_add(JacobianPoint *result, const JacobianPoint jacobianPoint1,
+                  const JacobianPoint jacobianPoint2, JacobianCurve *curve) {
+  // Addition in Jacobian coordinates, see Section 3.2.2 in [Guide-to-ECC].
+  MontgomeryField *field = &curve->field;
+  const mp_size_t n = field->limbCount;
+
+  // Adding infinity to a point does not change the point.
+  if (jacobian_isInfinity(jacobianPoint1, curve)) {
+    jacobian_set(result, jacobianPoint2, curve);
+    return;
+  }
+
+  if (jacobian_isInfinity(jacobianPoint2, curve)) {
+    jacobian_set(result, jacobianPoint1, curve);
+    return;
+  }
+
+  mp_limb_t *z1z1 = jacobian_temporary(curve, 0);
+  mp_limb_t *z2z2 = jacobian_temporary(curve, 1);
+  mp_limb_t *u1 = jacobian_temporary(curve, 2);
+  mp_limb_t *u2 = jacobian_temporary(curve, 3);
+  mp_limb_t *s1 = jacobian_temporary(curve, 4);
+  mp_limb_t *s2 = jacobian_temporary(curve, 5);
+  mp_limb_t *h = jacobian_temporary(curve, 6);
+  mp_limb_t *r = jacobian_temporary(curve, 7);
+  mp_limb_t *hh = jacobian_temporary(curve, 8);
+  mp_limb_t *hhh = jacobian_temporary(curve, 9);
+  mp_limb_t *x3 = jacobian_temporary(curve, 10);
+  mp_limb_t *y3 = jacobian_temporary(curve, 11);
+  mp_limb_t *z3 = jacobian_temporary(curve, 12);
+
+  // \f$U_1 = X_1Z_2^2, U_2 = X_2Z_1^2\f$
+  montgomeryField_sqr(z1z1, jacobianPoint1.z, field);
+  montgomeryField_sqr(z2z2, jacobianPoint2.z, field);
+  montgomeryField_mul(u1, jacobianPoint1.x, z2z2, field);
+  montgomeryField_mul(u2, jacobianPoint2.x, z1z1, field);
+
+  // \f$S_1 = Y_1Z_2^3, S_2 = Y_2Z_1^3\f$
+  montgomeryField_mul(s1, jacobianPoint1.y, jacobianPoint2.z, field);
+  montgomeryField_mul(s1, s1, z2z2, field);
+  montgomeryField_mul(s2, jacobianPoint2.y, jacobianPoint1.z, field);
+  montgomeryField_mul(s2, s2, z1z1, field);
+
+  // \f$H = U_2 - U_1, r = S_2 - S_1\f$
+  montgomeryField_sub(h, u2, u1, field);
+  montgomeryField_sub(r, s2, s1, field);
+
+  // Equal \f$x\f$ coordinates: either the points are equal (double) or they
+  // are inverses of each other (infinity).
+  if (mpn_zero_p(h, n)) {
+    if (mpn_zero_p(r, n)) {
+      jacobian_double(result, jacobianPoint1, curve);
+    } else {
+      jacobian_setInfinity(result, curve);
+    }
+    return;
+  }
+
+  montgomeryField_sqr(hh, h, field);
+  montgomeryField_mul(hhh, hh, h, field);
+
+  // \f$V = U_1H^2\f$, stored in \f$U_1\f$.
+  montgomeryField_mul(u1, u1, hh, field);
+
+  // \f$X_3 = r^2 - H^3 - 2V\f$
+  montgomeryField_sqr(x3, r, field);
+  montgomeryField_sub(x3, x3, hhh, field);
+  montgomeryField_sub(x3, x3, u1, field);
+  montgomeryField_sub(x3, x3, u1, field);
+
+  // \f$Y_3 = r(V - X_3) - S_1H^3\f$
+  montgomeryField_sub(u1, u1, x3, field);
+  montgomeryField_mul(y3, r, u1, field);
+  montgomeryField_mul(s1, s1, hhh, field);
+  montgomeryField_sub(y3, y3, s1, field);
+
+  // \f$Z_3 = Z_1Z_2H\f$
+  montgomeryField_mul(z3, jacobianPoint1.z, jacobianPoint2.z, field);
+  montgomeryField_mul(z3, z3, h, field);
+
+  jacobian_setCoordinates(result, x3, y3, z3, curve);
+}
+
+void jacobian_addNormalized(JacobianPoint *result,
+                            const JacobianPoint jacobianPoint,
+                            const JacobianPoint normalizedPoint,
+                            JacobianCurve *curve) {
+  // Mixed Jacobian-affine addition, see Algorithm 3.22 in [Guide-to-ECC].
+  MontgomeryField *field = &curve->field;
+  const mp_size_t n = field->limbCount;
+
+  if (jacobian_isInfinity(normalizedPoint, curve)) {
+    jacobian_set(result, jacobianPoint, curve);
+    return;
+  }
+
+  if (jacobian_isInfinity(jacobianPoint, curve)) {
+    jacobian_set(result, normalizedPoint, curve);
+    return;
+  }
+
+  mp_limb_t *z1z1 = jacobian_temporary(curve, 0);
+  mp_limb_t *u2 = jacobian_temporary(curve, 1);
+  mp_limb_t *s2 = jacobian_temporary(curve, 2);
+  mp_limb_t *h = jacobian_temporary(curve, 3);
+  mp_limb_t *r = jacobian_temporary(curve, 4);
+  mp_limb_t *hh = jacobian_temporary(curve, 5);
+  mp_limb_t *hhh = jacobian_temporary(curve, 6);
+  mp_limb_t *x3 = jacobian_temporary(curve, 7);
+  mp_limb_t *y3 = jacobian_temporary(curve, 8);
+  mp_limb_t *z3 = jacobian_temporary(curve, 9);
+
+  // \f$U_2 = x_2Z_1^2, S_2 = y_2Z_1^3\f$
+  montgomeryField_sqr(z1z1, jacobianPoint.z, field);
+  montgomeryField_mul(u2, normalizedPoint.x, z1z1, field);
+  montgomeryField_mul(s2, normalizedPoint.y, jacobianPoint.z, field);
+  montgomeryField_mul(s2, s2, z1z1, field);
+
+  // \f$H = U_2 - X_1, r = S_2 - Y_1\f$
+  montgomeryField_sub(h, u2, jacobianPoint.x, field);
+  montgomeryField_sub(r, s2, jacobianPoint.y, field);
+
+  if (mpn_zero_p(h, n)) {
+    if (mpn_zero_p(r, n)) {
+      jacobian_double(result, jacobianPoint, curve);
+    } else {
+      jacobian_setInfinity(result, curve);
+    }
+    return;
+  }
+
+  montgomeryField_sqr(hh, h, field);
+  montgomeryField_mul(hhh, hh, h, field);
+
+  // \f$V = X_1H^2\f$, stored in \f$U_2\f$.
+  montgomeryField_mul(u2, jacobianPoint.x, hh, field);
+
+  // \f$X_3 = r^2 - H^3 - 2V\f$
+  montgomeryField_sqr(x3, r, field);
+  montgomeryField_sub(x3, x3, hhh, field);
+  montgomeryField_sub(x3, x3, u2, field);
+  montgomeryField_sub(x3, x3, u2, field);
+
+  // \f$Y_3 = r(V - X_3) - Y_1H^3\f$
+  montgomeryField_sub(u2, u2, x3, field);
+  montgomeryField_mul(y3, r, u2, field);
+  montgomeryField_mul(s2, jacobianPoint.y, hhh, field);
+  montgomeryField_sub(y3, y3, s2, field);
+
+  // \f$Z_3 = Z_1H\f$
+  montgomeryField_mul(z3, jacobianPoint.z, h, field);
+
+  jacobian_setCoordinates(result, x3, y3, z3, curve);
+}
@@ -1,189 +1,857 @@
+#include <stdlib.h>
+
 #include "elliptic/TatePairing.h"
-#include "elliptic/Divisor.h"
+#include "complex/Cyclotomic.h"
+#include "util/MontgomeryField.h"
 
 // References:
 //   * [Intro-to-IBE] Luther Martin. 2008. Introduction to Identity-Based
 //   Encryption (Information Security and Privacy Series) (1 ed.). Artech House,
 //   Inc., Norwood, MA, USA.
+//   * [RFC-5091] Xavier Boyen, Luther Martin. 2007. RFC 5091. Identity-Based
+//   Cryptography Standard (IBCS) #1: Supersingular Curve Implementations of the
+//   BF and BB1 Cryptosystems
+
+void tate_initPrecomputation(TatePairingPrecomputation *precomputationOutput,
+                             const int embeddingDegree,
+                             const mpz_t subgroupOrder,
+                             const EllipticCurve ellipticCurve) {
+  // Here we use a Xi distortion map, which involves calculating a \f$\xi\f$
+  // value. For Type-1 elliptic curves, this is calculated as follows: \f$\xi =
+  // \frac{p - 1}{2}(1 + 3^{\frac{p + 1}{4}}i)\f$ where \f$p\f$ is the field
+  // order of the elliptic curve field.
+  mpz_t axi, bxi, three, one, addition, quotient, difference;
+  mpz_inits(axi, bxi, three, one, addition, quotient, difference, NULL);
+  Complex tmp;
+
+  mpz_sub_ui(difference, ellipticCurve.fieldOrder, 1);
+  mpz_cdiv_q_ui(axi, difference, 2);
+
+  mpz_set_ui(three, 3);
+  mpz_add_ui(addition, ellipticCurve.fieldOrder, 1);
+  mpz_cdiv_q_ui(quotient, addition, 4);
+  mpz_powm(bxi, three, quotient, ellipticCurve.fieldOrder);
+
+  mpz_set_ui(one, 1);
+  complex_initMpz(&tmp, one, bxi);
+  complex_modMulInteger(&precomputationOutput->xi, axi, tmp,
+                        ellipticCurve.fieldOrder);
+
+  mpz_clears(axi, bxi, three, one, addition, quotient, difference, NULL);
+  complex_destroy(tmp);
+
+  precomputationOutput->embeddingDegree = embeddingDegree;
+  mpz_init(precomputationOutput->finalExponent);
+
+  if (embeddingDegree == 2) {
+    // \f$\frac{p^2 - 1}{q} = (p - 1) \cdot \frac{p + 1}{q}\f$, only the
+    // second factor needs an actual exponentiation.
+    mpz_add_ui(precomputationOutput->finalExponent, ellipticCurve.fieldOrder,
+               1);
+    mpz_cdiv_q(precomputationOutput->finalExponent,
+               precomputationOutput->finalExponent, subgroupOrder);
+    return;
+  }
+
+  // The exponent of the final exponentiation: \f$\frac{p^k - 1}{q}\f$.
+  mpz_t pPow, exponentPart;
+  mpz_inits(pPow, exponentPart, NULL);
+
+  mpz_pow_ui(pPow, ellipticCurve.fieldOrder, embeddingDegree);
+  mpz_sub_ui(exponentPart, pPow, 1);
+  mpz_cdiv_q(precomputationOutput->finalExponent, exponentPart, subgroupOrder);
+
+  mpz_clears(pPow, exponentPart, NULL);
+}
+
+void tate_destroyPrecomputation(TatePairingPrecomputation precomputation) {
+  complex_destroy(precomputation.xi);
+  mpz_clear(precomputation.finalExponent);
+}
 
 CryptidStatus tate_performPairing(Complex *result, const AffinePoint p,
                                   const AffinePoint b,
                                   const int embeddingDegree,
                                   const mpz_t subgroupOrder,
                                   const EllipticCurve ellipticCurve) {
-  // Implementation of Miller's algorithm as it's written on this page:
-  // https://crypto.stanford.edu/pbc/notes/ep/miller.html
-  ComplexAffinePoint q;
+  TatePairingPrecomputation precomputation;
+  tate_initPrecomputation(&precomputation, embeddingDegree, subgroupOrder,
+                          ellipticCurve);
+
+  CryptidStatus status = tate_performPairingWithPrecomputation(
+      result, p, b, precomputation, subgroupOrder, ellipticCurve);
 
+  tate_destroyPrecomputation(precomputation);
+
+  return status;
+}
+
+CryptidStatus tate_performPairingWithPrecomputation(
+    Complex *result, const AffinePoint p, const AffinePoint b,
+    const TatePairingPrecomputation precomputation, const mpz_t subgroupOrder,
+    const EllipticCurve ellipticCurve) {
+  return tate_performMultiPairingWithPrecomputation(
+      result, &p, &b, 1, precomputation, subgroupOrder, ellipticCurve);
+}
+
+CryptidStatus tate_performMultiPairing(Complex *result,
+                                       const AffinePoint *const ps,
+                                       const AffinePoint *const bs,
+                                       const size_t count,
+                                       const int embeddingDegree,
+                                       const mpz_t subgroupOrder,
+                                       const EllipticCurve ellipticCurve) {
+  TatePairingPrecomputation precomputation;
+  tate_initPrecomputation(&precomputation, embeddingDegree, subgroupOrder,
+                          ellipticCurve);
+
+  CryptidStatus status = tate_performMultiPairingWithPrecomputation(
+      result, ps, bs, count, precomputation, subgroupOrder, ellipticCurve);
+
+  tate_destroyPrecomputation(precomputation);
+
+  return status;
+}
+
+// Applies the distortion map to b, which must not be infinity.
+static void tate_distort(ComplexAffinePoint *q, const AffinePoint b,
+                         const TatePairingPrecomputation precomputation,
+                         const EllipticCurve ellipticCurve) {
   // Distortion map - Creates linearly independent points
   // For examples on distortion maps, see [Intro-to-IBE p63.].
   //
-  // Here we use a Xi distortion map, which involves calculating a \f$\xi\f$
-  // value. For Type-1 elliptic curves, this is calculated as follows: \f$\xi =
-  // \frac{p - 1}{2}(1 + 3^{\frac{p + 1}{4}}i)\f$ where \f$p\f$ is the field
-  // order of the elliptic curve field.
-  if (affine_isInfinity(b)) {
-    q = complexAffine_infinity();
+  // The \f$\xi\f$ value of the map comes from the precomputation.
+  Complex xprime;
+
+  // \f$x^{\prime} = x \cdot xi\f$
+  // \f$x \in \f$F_p\f$ | \f$xi\f$ \in \f$F_p^2\f$
+  //
+  // Here we assume, that we have to convert \f$x\f$ to \f$F_p^2\f$ and then
+  // perform the multiplication according to the complex multiplication rules.
+  complex_modMulInteger(&xprime, b.x, precomputation.xi,
+                        ellipticCurve.fieldOrder);
+
+  Complex bY;
+  complex_initMpzLong(&bY, b.y, 0);
+
+  complexAffine_init(q, xprime, bY);
+
+  complex_destroyMany(2, bY, xprime);
+}
+
+// An element of \f$F_p^2\f$ in Montgomery representation.
+typedef struct TatePairingElement {
+  mp_limb_t *real;
+  mp_limb_t *imaginary;
+} TatePairingElement;
+
+// A distorted point in Montgomery representation. The y coordinate of a
+// distorted point lies in \f$F_p\f$.
+typedef struct TatePairingPoint {
+  TatePairingElement x;
+  mp_limb_t *y;
+} TatePairingPoint;
+
+// The running point \f$v\f$ of a Miller loop in Jacobian coordinates, and the
+// first pairing argument \f$p\f$ added to it, in Montgomery representation.
+// \f$v\f$ is infinity if and only if \f$Z = 0\f$.
+typedef struct TatePairingRunningPoint {
+  mp_limb_t *x;
+  mp_limb_t *y;
+  mp_limb_t *z;
+  mp_limb_t *px;
+  mp_limb_t *py;
+} TatePairingRunningPoint;
+
+// The number of \f$F_p\f$ elements of a step of the Miller loop: the
+// coefficients \f$a, b, c\f$ of the numerator line \f$ax + by + c\f$, followed
+// by those of the denominator line.
+#define TATE_STEP_ELEMENT_COUNT 6
+
+// The number of \f$F_p\f$ temporaries of the point arithmetic.
+#define TATE_POINT_TEMPORARY_COUNT 9
+
+// The number of \f$F_p\f$ elements of a pair: its point \f$q\f$, followed by
+// its running point \f$v\f$.
+#define TATE_PAIR_ELEMENT_COUNT 8
+
+// The number of pairs whose points are stored in the scratch itself.
+#define TATE_INLINE_PAIR_COUNT 2
+
+// The number of \f$F_p\f$ elements of a scratch used throughout the pairing:
+// f, one, curveA and t0 to t3.
+#define TATE_FIXED_ELEMENT_COUNT 8
+
+// The number of \f$F_p\f$ elements of a scratch used by the Miller loop only:
+// the values of the lines, the lines, the temporaries and the inline pairs.
+#define TATE_LOOP_ELEMENT_COUNT                                                \
+  (4 + TATE_STEP_ELEMENT_COUNT + TATE_POINT_TEMPORARY_COUNT +                  \
+   TATE_INLINE_PAIR_COUNT * TATE_PAIR_ELEMENT_COUNT)
+
+// The number of \f$F_p\f$ elements of a scratch. The final exponentiation
+// reuses the elements of the Miller loop.
+#define TATE_SCRATCH_ELEMENT_COUNT                                             \
+  (TATE_FIXED_ELEMENT_COUNT +                                                  \
+   (TATE_LOOP_ELEMENT_COUNT > CYCLOTOMIC_POW_SCRATCH_ELEMENT_COUNT             \
+        ? TATE_LOOP_ELEMENT_COUNT                                              \
+        : CYCLOTOMIC_POW_SCRATCH_ELEMENT_COUNT))
+
+// The state of a Miller loop. The accumulator, the running points, the lines
+// and every temporary is kept in Montgomery representation, so neither the
+// point arithmetic nor the evaluation of the lines needs a division, and the
+// accumulator is converted back only after the final exponentiation.
+//
+// For the fields of the security levels, the elements are stored contiguously
+// in the scratch itself, so a pairing of at most TATE_INLINE_PAIR_COUNT pairs
+// allocates memory only for the field and the conversions at its boundary.
+typedef struct TatePairingScratch {
+  MontgomeryField field;
+  mp_limb_t inlineLimbs[TATE_SCRATCH_ELEMENT_COUNT *
+                        MONTGOMERY_FIELD_MAX_LEVEL_LIMB_COUNT];
+  mp_limb_t *limbs;
+  // The imaginary part of f follows its real part, as
+  // cyclotomic_powMontgomery expects.
+  TatePairingElement f;
+  mp_limb_t *one;
+  mp_limb_t *curveA;
+  mp_limb_t *t0;
+  mp_limb_t *t1;
+  mp_limb_t *t2;
+  mp_limb_t *t3;
+  TatePairingElement numeratorValue;
+  TatePairingElement denominatorValue;
+  mp_limb_t *lines;
+  mp_limb_t *temporaries[TATE_POINT_TEMPORARY_COUNT];
+  mp_limb_t *pairs;
+  // The scratch of the final exponentiation, overlapping the elements of the
+  // Miller loop.
+  mp_limb_t *exponentiation;
+} TatePairingScratch;
+
+// Initializes a scratch with \f$f = 1\f$.
+static void tate_initScratch(TatePairingScratch *scratchOutput,
+                             const EllipticCurve ellipticCurve) {
+  montgomeryField_init(&scratchOutput->field, ellipticCurve.fieldOrder);
+
+  const mp_size_t n = scratchOutput->field.limbCount;
+  if ((size_t)n <= MONTGOMERY_FIELD_MAX_LEVEL_LIMB_COUNT) {
+    scratchOutput->limbs = scratchOutput->inlineLimbs;
+    mpn_zero(scratchOutput->limbs, TATE_SCRATCH_ELEMENT_COUNT * n);
   } else {
-    mpz_t axi, bxi, three, one, addition, quotient, difference;
-    mpz_inits(axi, bxi, three, one, addition, quotient, difference, NULL);
-    Complex xi, tmp, xprime;
+    montgomeryField_initElements(&scratchOutput->limbs,
+                                 TATE_SCRATCH_ELEMENT_COUNT,
+                                 &scratchOutput->field);
+  }
+
+  mp_limb_t *next = scratchOutput->limbs;
+  mp_limb_t **elements[] = {&scratchOutput->f.real,
+                            &scratchOutput->f.imaginary,
+                            &scratchOutput->one,
+                            &scratchOutput->curveA,
+                            &scratchOutput->t0,
+                            &scratchOutput->t1,
+                            &scratchOutput->t2,
+                            &scratchOutput->t3,
+                            &scratchOutput->numeratorValue.real,
+                            &scratchOutput->numeratorValue.imaginary,
+                            &scratchOutput->denominatorValue.real,
+                            &scratchOutput->denominatorValue.imaginary};
+  for (size_t i = 0; i < sizeof(elements) / sizeof(elements[0]); i++) {
+    *elements[i] = next;
+    next += n;
+  }
 
-    mpz_sub_ui(difference, ellipticCurve.fieldOrder, 1);
-    mpz_cdiv_q_ui(axi, difference, 2);
+  scratchOutput->lines = next;
+  next += TATE_STEP_ELEMENT_COUNT * n;
 
-    mpz_set_ui(three, 3);
-    mpz_add_ui(addition, ellipticCurve.fieldOrder, 1);
-    mpz_cdiv_q_ui(quotient, addition, 4);
-    mpz_powm(bxi, three, quotient, ellipticCurve.fieldOrder);
+  for (size_t i = 0; i < TATE_POINT_TEMPORARY_COUNT; i++) {
+    scratchOutput->temporaries[i] = next;
+    next += n;
+  }
 
-    mpz_set_ui(one, 1);
-    complex_initMpz(&tmp, one, bxi);
-    complex_modMulInteger(&xi, axi, tmp, ellipticCurve.fieldOrder);
+  scratchOutput->pairs = next;
+  scratchOutput->exponentiation =
+      scratchOutput->limbs + TATE_FIXED_ELEMENT_COUNT * n;
 
-    // \f$x^{\prime} = x \cdot xi\f$
-    // \f$x \in \f$F_p\f$ | \f$xi\f$ \in \f$F_p^2\f$
-    //
-    // Here we assume, that we have to convert \f$x\f$ to \f$F_p^2\f$ and then
-    // perform the multiplication according to the complex multiplication rules.
-    complex_modMulInteger(&xprime, b.x, xi, ellipticCurve.fieldOrder);
+  mpz_set_ui(scratchOutput->field.conversion, 1);
+  montgomeryField_fromMpz(scratchOutput->one, scratchOutput->field.conversion,
+                          &scratchOutput->field);
+  mpn_copyi(scratchOutput->f.real, scratchOutput->one, n);
 
-    mpz_t zero;
-    mpz_init_set_ui(zero, 0);
-    Complex bY;
-    complex_initMpz(&bY, b.y, zero);
+  montgomeryField_fromMpz(scratchOutput->curveA, ellipticCurve.a,
+                          &scratchOutput->field);
+}
 
-    complexAffine_init(&q, xprime, bY);
+static void tate_destroyScratch(TatePairingScratch *scratch) {
+  if (scratch->limbs != scratch->inlineLimbs) {
+    free(scratch->limbs);
+  }
+  montgomeryField_destroy(scratch->field);
+}
+
+// Applies the distortion map to b and converts the result into Montgomery
+// representation, stored in the first three elements of limbs.
+static void tate_initPoint(TatePairingPoint *pointOutput, mp_limb_t *limbs,
+                           const AffinePoint b,
+                           const TatePairingPrecomputation precomputation,
+                           const EllipticCurve ellipticCurve,
+                           TatePairingScratch *scratch) {
+  const mp_size_t n = scratch->field.limbCount;
+  pointOutput->x.real = limbs;
+  pointOutput->x.imaginary = pointOutput->x.real + n;
+  pointOutput->y = pointOutput->x.real + 2 * n;
+
+  ComplexAffinePoint q;
+  tate_distort(&q, b, precomputation, ellipticCurve);
+
+  montgomeryField_fromMpz(pointOutput->x.real, q.x.real, &scratch->field);
+  montgomeryField_fromMpz(pointOutput->x.imaginary, q.x.imaginary,
+                          &scratch->field);
+  montgomeryField_fromMpz(pointOutput->y, q.y.real, &scratch->field);
+
+  complexAffine_destroy(q);
+}
+
+// Initializes the running point \f$v = p\f$ of a finite p, stored in the
+// first five elements of limbs.
+static void tate_initRunningPoint(TatePairingRunningPoint *pointOutput,
+                                  mp_limb_t *limbs, const AffinePoint p,
+                                  TatePairingScratch *scratch) {
+  const mp_size_t n = scratch->field.limbCount;
+  pointOutput->x = limbs;
+  pointOutput->y = pointOutput->x + n;
+  pointOutput->z = pointOutput->x + 2 * n;
+  pointOutput->px = pointOutput->x + 3 * n;
+  pointOutput->py = pointOutput->x + 4 * n;
+
+  montgomeryField_fromMpz(pointOutput->px, p.x, &scratch->field);
+  montgomeryField_fromMpz(pointOutput->py, p.y, &scratch->field);
+  mpn_copyi(pointOutput->x, pointOutput->px, n);
+  mpn_copyi(pointOutput->y, pointOutput->py, n);
+  mpn_copyi(pointOutput->z, scratch->one, n);
+}
 
-    complex_destroy(bY);
-    mpz_clear(zero);
+// Sets line to the constant 1, the vertical line through infinity.
+static void tate_constantLine(mp_limb_t *line, TatePairingScratch *scratch) {
+  const mp_size_t n = scratch->field.limbCount;
 
-    mpz_clears(axi, bxi, three, one, addition, quotient, difference, NULL);
-    complex_destroyMany(3, xi, tmp, xprime);
+  mpn_zero(line, 2 * n);
+  mpn_copyi(line + 2 * n, scratch->one, n);
+}
+
+// Sets line to the vertical line through v, which is Algorithm 3.4.1 in
+// [RFC-5091] multiplied by \f$Z^2\f$: \f$Z^2 \cdot x - X\f$.
+static void tate_verticalLine(mp_limb_t *line,
+                              const TatePairingRunningPoint v,
+                              TatePairingScratch *scratch) {
+  const mp_size_t n = scratch->field.limbCount;
+
+  if (mpn_zero_p(v.z, n)) {
+    tate_constantLine(line, scratch);
+    return;
   }
 
-  if (complexAffine_isInfinity(q)) {
-    complexAffine_destroy(q);
-    complex_initLong(result, 1, 0);
+  montgomeryField_sqr(line, v.z, &scratch->field);
+  mpn_zero(line + n, n);
+  montgomeryField_neg(line + 2 * n, v.x, &scratch->field);
+}
+
+// Double step of the Miller loop: computes the tangent at \f$v\f$, then sets
+// \f$v = 2v\f$ and computes the vertical line through the new \f$v\f$.
+//
+// The tangent is Algorithm 3.4.2 in [RFC-5091] multiplied by \f$Z^6\f$:
+// \f$-MZ^2 \cdot x + 2YZ^3 \cdot y + (MX - 2Y^2)\f$ with
+// \f$M = 3X^2 + aZ^4\f$. The doubling is the Jacobian one, sharing \f$M\f$:
+// \f$X_3 = M^2 - 2S\f$, \f$Y_3 = M(S - X_3) - 8Y^4\f$, \f$Z_3 = 2YZ\f$,
+// where \f$S = 4XY^2\f$.
+static void tate_doubleStep(mp_limb_t *lines, const TatePairingRunningPoint v,
+                            TatePairingScratch *scratch) {
+  MontgomeryField *field = &scratch->field;
+  const mp_size_t n = field->limbCount;
+  mp_limb_t *numerator = lines;
+  mp_limb_t *denominator = lines + 3 * n;
+
+  if (mpn_zero_p(v.z, n)) {
+    tate_constantLine(numerator, scratch);
+    tate_constantLine(denominator, scratch);
+    return;
+  }
+
+  // The tangent at a point with \f$Y = 0\f$ is vertical, and its double is
+  // infinity.
+  if (mpn_zero_p(v.y, n)) {
+    tate_verticalLine(numerator, v, scratch);
+    mpn_zero(v.z, n);
+    tate_constantLine(denominator, scratch);
+    return;
+  }
+
+  mp_limb_t *zSquared = scratch->temporaries[0];
+  mp_limb_t *m = scratch->temporaries[1];
+  mp_limb_t *yy = scratch->temporaries[2];
+  mp_limb_t *yz = scratch->temporaries[3];
+  mp_limb_t *s = scratch->temporaries[4];
+  mp_limb_t *x3 = scratch->temporaries[5];
+  mp_limb_t *y3 = scratch->temporaries[6];
+  mp_limb_t *t = scratch->temporaries[7];
+
+  montgomeryField_sqr(zSquared, v.z, field);
+
+  // \f$M = 3X^2 + aZ^4\f$
+  montgomeryField_sqr(t, v.x, field);
+  montgomeryField_add(m, t, t, field);
+  montgomeryField_add(m, m, t, field);
+  if (!mpn_zero_p(scratch->curveA, n)) {
+    montgomeryField_sqr(t, zSquared, field);
+    montgomeryField_mul(t, t, scratch->curveA, field);
+    montgomeryField_add(m, m, t, field);
+  }
+
+  montgomeryField_sqr(yy, v.y, field);
+  montgomeryField_mul(yz, v.y, v.z, field);
+
+  // The tangent \f$-MZ^2 \cdot x + 2YZ^3 \cdot y + (MX - 2Y^2)\f$.
+  montgomeryField_mul(numerator, m, zSquared, field);
+  montgomeryField_neg(numerator, numerator, field);
+  montgomeryField_mul(numerator + n, yz, zSquared, field);
+  montgomeryField_add(numerator + n, numerator + n, numerator + n, field);
+  montgomeryField_mul(numerator + 2 * n, m, v.x, field);
+  montgomeryField_sub(numerator + 2 * n, numerator + 2 * n, yy, field);
+  montgomeryField_sub(numerator + 2 * n, numerator + 2 * n, yy, field);
+
+  // \f$S = 4XY^2\f$
+  montgomeryField_mul(s, v.x, yy, field);
+  montgomeryField_add(s, s, s, field);
+  montgomeryField_add(s, s, s, field);
+
+  // \f$X_3 = M^2 - 2S\f$
+  montgomeryField_sqr(x3, m, field);
+  montgomeryField_sub(x3, x3, s, field);
+  montgomeryField_sub(x3, x3, s, field);
+
+  // \f$Y_3 = M(S - X_3) - 8Y^4\f$
+  montgomeryField_sub(t, s, x3, field);
+  montgomeryField_mul(y3, m, t, field);
+  montgomeryField_sqr(t, yy, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_add(t, t, t, field);
+  montgomeryField_sub(y3, y3, t, field);
+
+  // \f$Z_3 = 2YZ\f$
+  mpn_copyi(v.x, x3, n);
+  mpn_copyi(v.y, y3, n);
+  montgomeryField_add(v.z, yz, yz, field);
+
+  tate_verticalLine(denominator, v, scratch);
+}
+
+// Add step of the Miller loop: computes the line through \f$v\f$ and
+// \f$p\f$, then sets \f$v = v + p\f$ and computes the vertical line through
+// the new \f$v\f$.
+//
+// With \f$U = x_p Z^2 - X\f$ and \f$S = y_p Z^3 - Y\f$, the chord is
+// Algorithm 3.4.3 in [RFC-5091] multiplied by \f$Z^3\f$:
+// \f$-S \cdot x + UZ \cdot y + (S x_p - UZ y_p)\f$. The mixed addition
+// shares \f$U\f$ and \f$S\f$: \f$X_3 = S^2 - U^3 - 2XU^2\f$,
+// \f$Y_3 = S(XU^2 - X_3) - YU^3\f$, \f$Z_3 = ZU\f$.
+static void tate_addStep(mp_limb_t *lines, const TatePairingRunningPoint v,
+                         TatePairingScratch *scratch) {
+  MontgomeryField *field = &scratch->field;
+  const mp_size_t n = field->limbCount;
+  mp_limb_t *numerator = lines;
+  mp_limb_t *denominator = lines + 3 * n;
+
+  // The vertical line through \f$p\f$, which becomes the new \f$v\f$.
+  if (mpn_zero_p(v.z, n)) {
+    mpn_copyi(numerator, scratch->one, n);
+    mpn_zero(numerator + n, n);
+    montgomeryField_neg(numerator + 2 * n, v.px, field);
+
+    mpn_copyi(v.x, v.px, n);
+    mpn_copyi(v.y, v.py, n);
+    mpn_copyi(v.z, scratch->one, n);
+    tate_verticalLine(denominator, v, scratch);
+    return;
+  }
+
+  mp_limb_t *zSquared = scratch->temporaries[0];
+  mp_limb_t *u = scratch->temporaries[1];
+  mp_limb_t *s = scratch->temporaries[2];
+  mp_limb_t *hh = scratch->temporaries[3];
+  mp_limb_t *hhh = scratch->temporaries[4];
+  mp_limb_t *w = scratch->temporaries[5];
+  mp_limb_t *x3 = scratch->temporaries[6];
+  mp_limb_t *y3 = scratch->temporaries[7];
+  mp_limb_t *t = scratch->temporaries[8];
+
+  // \f$U = x_p Z^2 - X\f$ and \f$S = y_p Z^3 - Y\f$ are zero if and only if
+  // the two points share their \f$x\f$ or \f$y\f$ coordinates, respectively.
+  montgomeryField_sqr(zSquared, v.z, field);
+  montgomeryField_mul(u, v.px, zSquared, field);
+  montgomeryField_sub(u, u, v.x, field);
+  montgomeryField_mul(s, v.py, zSquared, field);
+  montgomeryField_mul(s, s, v.z, field);
+  montgomeryField_sub(s, s, v.y, field);
+
+  if (mpn_zero_p(u, n)) {
+    // \f$v = p\f$ yields the tangent, while \f$v = -p\f$ yields the vertical
+    // line and infinity.
+    if (mpn_zero_p(s, n)) {
+      tate_doubleStep(lines, v, scratch);
+      return;
+    }
+
+    tate_verticalLine(numerator, v, scratch);
+    mpn_zero(v.z, n);
+    tate_constantLine(denominator, scratch);
+    return;
+  }
+
+  // The chord \f$-S \cdot x + UZ \cdot y - (UZ \cdot y_p - S \cdot x_p)\f$.
+  montgomeryField_neg(numerator, s, field);
+  montgomeryField_mul(numerator + n, u, v.z, field);
+  montgomeryField_mul(numerator + 2 * n, numerator + n, v.py, field);
+  montgomeryField_mul(t, numerator, v.px, field);
+  montgomeryField_add(numerator + 2 * n, numerator + 2 * n, t, field);
+  montgomeryField_neg(numerator + 2 * n, numerator + 2 * n, field);
+
+  montgomeryField_sqr(hh, u, field);
+  montgomeryField_mul(hhh, hh, u, field);
+
+  // \f$V = XH^2\f$
+  montgomeryField_mul(w, v.x, hh, field);
+
+  // \f$X_3 = S^2 - H^3 - 2V\f$
+  montgomeryField_sqr(x3, s, field);
+  montgomeryField_sub(x3, x3, hhh, field);
+  montgomeryField_sub(x3, x3, w, field);
+  montgomeryField_sub(x3, x3, w, field);
+
+  // \f$Y_3 = S(V - X_3) - YH^3\f$
+  montgomeryField_sub(t, w, x3, field);
+  montgomeryField_mul(y3, s, t, field);
+  montgomeryField_mul(t, v.y, hhh, field);
+  montgomeryField_sub(y3, y3, t, field);
+
+  // \f$Z_3 = ZH\f$, the \f$y\f$ coefficient of the chord.
+  mpn_copyi(v.x, x3, n);
+  mpn_copyi(v.y, y3, n);
+  mpn_copyi(v.z, numerator + n, n);
+
+  tate_verticalLine(denominator, v, scratch);
+}
+
+// Converts f out of Montgomery representation.
+static void tate_finishAccumulator(Complex *f, TatePairingScratch *scratch) {
+  complex_init(f);
+  montgomeryField_toMpz(f->real, scratch->f.real, &scratch->field);
+  montgomeryField_toMpz(f->imaginary, scratch->f.imaginary, &scratch->field);
+}
+
+// Karatsuba multiplication in \f$F_p^2\f$, as in complex_modMulInto. The
+// product may be the same as any of the operands.
+static void tate_mul(const TatePairingElement product,
+                     const TatePairingElement multiplier,
+                     const TatePairingElement multiplicand,
+                     TatePairingScratch *scratch) {
+  MontgomeryField *field = &scratch->field;
+
+  montgomeryField_mul(scratch->t0, multiplier.real, multiplicand.real, field);
+  montgomeryField_mul(scratch->t1, multiplier.imaginary,
+                      multiplicand.imaginary, field);
+  montgomeryField_add(scratch->t2, multiplier.real, multiplier.imaginary,
+                      field);
+  montgomeryField_add(scratch->t3, multiplicand.real, multiplicand.imaginary,
+                      field);
+  montgomeryField_mul(scratch->t2, scratch->t2, scratch->t3, field);
+
+  montgomeryField_sub(scratch->t2, scratch->t2, scratch->t0, field);
+  montgomeryField_sub(product.imaginary, scratch->t2, scratch->t1, field);
+  montgomeryField_sub(product.real, scratch->t0, scratch->t1, field);
+}
+
+// Evaluates the line \f$ax + by + c\f$ at q.
+static void tate_evaluateLine(const TatePairingElement value,
+                              const mp_limb_t *line, const TatePairingPoint q,
+                              TatePairingScratch *scratch) {
+  MontgomeryField *field = &scratch->field;
+  const mp_size_t n = field->limbCount;
+
+  montgomeryField_mul(value.imaginary, line, q.x.imaginary, field);
+  montgomeryField_mul(value.real, line, q.x.real, field);
+  montgomeryField_add(value.real, value.real, line + 2 * n, field);
+
+  // The vertical lines have no y term.
+  if (!mpn_zero_p(line + n, n)) {
+    montgomeryField_mul(scratch->t0, line + n, q.y, field);
+    montgomeryField_add(value.real, value.real, scratch->t0, field);
+  }
+}
+
+// Multiplies f by the quotient of the two lines of a step evaluated at q. The
+// denominator is replaced by its conjugate, see below.
+static void tate_multiplyByLineQuotient(const mp_limb_t *lines,
+                                        const TatePairingPoint q,
+                                        TatePairingScratch *scratch) {
+  tate_evaluateLine(scratch->numeratorValue, lines, q, scratch);
+  tate_evaluateLine(scratch->denominatorValue,
+                    lines + 3 * scratch->field.limbCount, q, scratch);
+  montgomeryField_neg(scratch->denominatorValue.imaginary,
+                      scratch->denominatorValue.imaginary, &scratch->field);
+
+  tate_mul(scratch->numeratorValue, scratch->numeratorValue,
+           scratch->denominatorValue, scratch);
+  tate_mul(scratch->f, scratch->f, scratch->numeratorValue, scratch);
+}
+
+// Squares f in place as \f$((r + i)(r - i), 2ri)\f$.
+static void tate_square(TatePairingScratch *scratch) {
+  MontgomeryField *field = &scratch->field;
+
+  montgomeryField_add(scratch->t0, scratch->f.real, scratch->f.imaginary,
+                      field);
+  montgomeryField_sub(scratch->t1, scratch->f.real, scratch->f.imaginary,
+                      field);
+  montgomeryField_mul(scratch->t2, scratch->f.real, scratch->f.imaginary,
+                      field);
+
+  montgomeryField_mul(scratch->f.real, scratch->t0, scratch->t1, field);
+  montgomeryField_add(scratch->f.imaginary, scratch->t2, scratch->t2, field);
+}
+
+// Raises f to the exponent \f$\frac{p^k - 1}{q}\f$ and converts it out of
+// Montgomery representation.
+static CryptidStatus
+tate_finalExponentiation(Complex *result,
+                         const TatePairingPrecomputation precomputation,
+                         const mpz_t fieldOrder, TatePairingScratch *scratch) {
+  if (precomputation.embeddingDegree != 2) {
+    Complex f;
+    tate_finishAccumulator(&f, scratch);
+    complex_modPow(result, f, precomputation.finalExponent, fieldOrder);
+    complex_destroy(f);
     return CRYPTID_SUCCESS;
   }
 
+  MontgomeryField *field = &scratch->field;
+
+  // Easy part: \f$f^{p - 1} = \frac{f^p}{f} = \frac{\overline{f}}{f} =
+  // \frac{\overline{f}^2}{r^2 + i^2}\f$, as the Frobenius map of \f$F_p^2\f$
+  // is the conjugation.
+  montgomeryField_sqr(scratch->t0, scratch->f.real, field);
+  montgomeryField_sqr(scratch->t1, scratch->f.imaginary, field);
+  montgomeryField_add(scratch->t2, scratch->t0, scratch->t1, field);
+  CryptidStatus status =
+      montgomeryField_inverse(scratch->t2, scratch->t2, field);
+  if (status) {
+    return status;
+  }
+
+  montgomeryField_mul(scratch->t3, scratch->f.real, scratch->f.imaginary,
+                      field);
+  montgomeryField_add(scratch->t3, scratch->t3, scratch->t3, field);
+  montgomeryField_neg(scratch->t3, scratch->t3, field);
+  montgomeryField_sub(scratch->t0, scratch->t0, scratch->t1, field);
+  montgomeryField_mul(scratch->f.real, scratch->t0, scratch->t2, field);
+  montgomeryField_mul(scratch->f.imaginary, scratch->t3, scratch->t2, field);
+
+  // Hard part: raising to \f$\frac{p + 1}{q}\f$.
+  // \f$f^{p - 1}\f$ lies in the cyclotomic subgroup of order \f$p + 1\f$.
+  cyclotomic_powMontgomery(scratch->f.real, scratch->f.real,
+                           precomputation.finalExponent,
+                           scratch->exponentiation, field);
+
+  tate_finishAccumulator(result, scratch);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus tate_performMultiPairingWithPrecomputation(
+    Complex *result, const AffinePoint *const ps, const AffinePoint *const bs,
+    const size_t count, const TatePairingPrecomputation precomputation,
+    const mpz_t subgroupOrder, const EllipticCurve ellipticCurve) {
+  // Implementation of Miller's algorithm as it's written on this page:
+  // https://crypto.stanford.edu/pbc/notes/ep/miller.html
+  //
+  // The Miller loops of all the pairs share the squarings of \f$f\f$ and the
+  // single final exponentiation, as
+  // \f$\prod_j e(p_j, b_j) = (\prod_j f_j)^{\frac{p^k - 1}{q}}\f$.
+  //
+  // Pairs with an infinite argument evaluate to 1, hence they are skipped.
+  TatePairingScratch scratch;
+  tate_initScratch(&scratch, ellipticCurve);
+  const mp_size_t n = scratch.field.limbCount;
+
+  TatePairingPoint inlineQs[TATE_INLINE_PAIR_COUNT];
+  TatePairingRunningPoint inlineVs[TATE_INLINE_PAIR_COUNT];
+  TatePairingPoint *qs = inlineQs;
+  TatePairingRunningPoint *vs = inlineVs;
+  mp_limb_t *pairs = scratch.pairs;
+  if (count > TATE_INLINE_PAIR_COUNT) {
+    qs = (TatePairingPoint *)malloc(count * sizeof(TatePairingPoint));
+    vs = (TatePairingRunningPoint *)malloc(count *
+                                           sizeof(TatePairingRunningPoint));
+    montgomeryField_initElements(&pairs, count * TATE_PAIR_ELEMENT_COUNT,
+                                 &scratch.field);
+  }
+  size_t activeCount = 0;
+
+  for (size_t j = 0; j < count; j++) {
+    if (affine_isInfinity(ps[j]) || affine_isInfinity(bs[j])) {
+      continue;
+    }
+
+    mp_limb_t *pair = pairs + activeCount * TATE_PAIR_ELEMENT_COUNT * n;
+    tate_initPoint(&qs[activeCount], pair, bs[j], precomputation,
+                   ellipticCurve, &scratch);
+
+    // 1. Set \f$v\f$ = \f$p\f$
+    tate_initRunningPoint(&vs[activeCount], pair + 3 * n, ps[j], &scratch);
+    activeCount++;
+  }
+
   // Now p and q are linearly indenependent.
   // Here we start the actual Miller's algorithm.
-  Complex f, gVVQ, g2VMinus2VQ, g2VMinus2VQInv, frac, tmpF, gVPQ, gVPlusQ,
-      gVPlusQInv;
-  AffinePoint v, doubleV, vPlusP;
-
-  // 1. Set \f$f\f$ = 1 and \f$v\f$ = \f$p\f$
-  complex_initLong(&f, 1, 0);
-  affine_init(&v, p.x, p.y);
+  //
+  // The running point \f$v\f$ is kept in Jacobian coordinates. The lines
+  // evaluated at such a point differ from the affine ones only by factors in
+  // \f$F_p^*\f$, which are eliminated by the final exponentiation, because
+  // \f$p - 1\f$ divides \f$\frac{p^2 - 1}{q}\f$.
+  //
+  // For the same reason the vertical lines in the denominators need not be
+  // inverted: \f$\frac{1}{g} = \frac{\overline{g}}{g\overline{g}}\f$ and
+  // \f$g\overline{g} \in F_p^*\f$, hence dividing by \f$g\f$ can be replaced
+  // by multiplying with its conjugate. The loop is therefore inversion-free.
+  //
+  // 1. Set \f$f\f$ = 1, which is done by tate_initScratch.
 
   // 2. {@code for i = t - 1 to 0 do:}
   // where \f$t\f$ is the bitcount of the subgroup order.
   // Note, that we have to subtract 2 because of the allocation behavior
   // of GMP (please refer to
   // https://gmplib.org/manual/Miscellaneous-Integer-Functions.html).
-  for (int i = mpz_sizeinbase(subgroupOrder, 2) - 2; i >= 0; --i) {
+  for (int i = mpz_sizeinbase(subgroupOrder, 2) - 2; activeCount > 0 && i >= 0;
+       --i) {
     // Double step
-    // \f$f = f^{2} \frac{g_{v, v}(q)}{g_{2v, -2v}(q)}\f$
-    CryptidStatus status = affine_add(&doubleV, v, v, ellipticCurve);
-    if (status) {
-      complexAffine_destroy(q);
-      complex_destroy(f);
-      affine_destroy(v);
-      return status;
-    }
-    status = divisor_evaluateTangent(&gVVQ, v, q, ellipticCurve);
-    if (status) {
-      complexAffine_destroy(q);
-      complex_destroy(f);
-      affine_destroy(v);
-      affine_destroy(doubleV);
-      return status;
+    // \f$f = f^{2} \prod_j \frac{g_{v_j, v_j}(q_j)}{g_{2v_j, -2v_j}(q_j)}\f$
+    tate_square(&scratch);
+
+    for (size_t j = 0; j < activeCount; j++) {
+      tate_doubleStep(scratch.lines, vs[j], &scratch);
+      tate_multiplyByLineQuotient(scratch.lines, qs[j], &scratch);
     }
-    divisor_evaluateVertical(&g2VMinus2VQ, doubleV, q, ellipticCurve);
-    status = complex_multiplicativeInverse(&g2VMinus2VQInv, g2VMinus2VQ,
-                                           ellipticCurve.fieldOrder);
-    if (status) {
-      complexAffine_destroy(q);
-      affine_destroy(v);
-      affine_destroy(doubleV);
-      complex_destroyMany(3, f, gVVQ, g2VMinus2VQ);
-      return status;
+
+    if (mpz_tstbit(subgroupOrder, i)) {
+      // Add step
+      // \f$f = f \prod_j \frac{g_{v_j, p_j}(q_j)}{g_{v_j + p_j, -(v_j +
+      // p_j)}(q_j)}\f$
+      for (size_t j = 0; j < activeCount; j++) {
+        tate_addStep(scratch.lines, vs[j], &scratch);
+        tate_multiplyByLineQuotient(scratch.lines, qs[j], &scratch);
+      }
     }
-    complex_modMul(&frac, gVVQ, g2VMinus2VQInv, ellipticCurve.fieldOrder);
-    complex_modMul(&tmpF, f, f, ellipticCurve.fieldOrder);
+  }
 
-    complex_destroy(f);
-    complex_modMul(&f, tmpF, frac, ellipticCurve.fieldOrder);
+  if (count > TATE_INLINE_PAIR_COUNT) {
+    free(pairs);
+    free(vs);
+    free(qs);
+  }
 
-    affine_destroy(v);
-    // \f$v = 2v\f$
-    affine_init(&v, doubleV.x, doubleV.y);
+  CryptidStatus status = CRYPTID_SUCCESS;
+  if (activeCount == 0) {
+    tate_finishAccumulator(result, &scratch);
+  } else {
+    // Final Exponentiation
+    status = tate_finalExponentiation(result, precomputation,
+                                      ellipticCurve.fieldOrder, &scratch);
+  }
 
-    complex_destroyMany(5, gVVQ, g2VMinus2VQ, g2VMinus2VQInv, frac, tmpF);
-    affine_destroy(doubleV);
+  tate_destroyScratch(&scratch);
 
-    if (mpz_tstbit(subgroupOrder, i)) {
-      // Add step
-      // \f$f = f \frac{g_{v, p}(q)}{g_{v + p, -(b + p)}(q)}\f$
-      status = affine_add(&vPlusP, v, p, ellipticCurve);
-      if (status) {
-        complexAffine_destroy(q);
-        complex_destroy(f);
-        affine_destroy(v);
-        return status;
-      }
+  return status;
+}
 
-      status = divisor_evaluateLine(&gVPQ, v, p, q, ellipticCurve);
-      if (status) {
-        complexAffine_destroy(q);
-        complex_destroy(f);
-        affine_destroy(v);
-        affine_destroy(vPlusP);
-        return status;
-      }
+void tate_initLines(TatePairingLines *linesOutput, const AffinePoint p,
+                    const mpz_t subgroupOrder,
+                    const EllipticCurve ellipticCurve) {
+  // The same loop as in tate_performMultiPairingWithPrecomputation, but the
+  // lines are stored instead of being evaluated.
+  linesOutput->length = 0;
+  linesOutput->coefficients = NULL;
 
-      divisor_evaluateVertical(&gVPlusQ, vPlusP, q, ellipticCurve);
+  if (affine_isInfinity(p)) {
+    return;
+  }
 
-      status = complex_multiplicativeInverse(&gVPlusQInv, gVPlusQ,
-                                             ellipticCurve.fieldOrder);
-      if (status) {
-        complexAffine_destroy(q);
-        affine_destroy(v);
-        affine_destroy(vPlusP);
-        complex_destroyMany(3, f, gVPQ, gVPlusQ);
-        return status;
-      }
-      complex_modMul(&frac, gVPQ, gVPlusQInv, ellipticCurve.fieldOrder);
-      complex_modMul(&tmpF, f, frac, ellipticCurve.fieldOrder);
+  TatePairingScratch scratch;
+  tate_initScratch(&scratch, ellipticCurve);
+  const mp_size_t n = scratch.field.limbCount;
+
+  const int topBit = mpz_sizeinbase(subgroupOrder, 2) - 2;
+  const size_t maxLength = 2 * (size_t)(topBit + 1);
+  montgomeryField_initElements(&linesOutput->coefficients,
+                               maxLength * TATE_STEP_ELEMENT_COUNT,
+                               &scratch.field);
 
-      complex_destroy(f);
-      complex_initMpz(&f, tmpF.real, tmpF.imaginary);
+  TatePairingRunningPoint v;
+  tate_initRunningPoint(&v, scratch.pairs, p, &scratch);
 
-      affine_destroy(v);
-      // \f$v = v + p\f$
-      affine_init(&v, vPlusP.x, vPlusP.y);
+  for (int i = topBit; i >= 0; --i) {
+    tate_doubleStep(linesOutput->coefficients +
+                        linesOutput->length * TATE_STEP_ELEMENT_COUNT * n,
+                    v, &scratch);
+    linesOutput->length++;
 
-      complex_destroyMany(5, gVPQ, gVPlusQ, gVPlusQInv, frac, tmpF);
-      affine_destroy(vPlusP);
+    if (mpz_tstbit(subgroupOrder, i)) {
+      tate_addStep(linesOutput->coefficients +
+                       linesOutput->length * TATE_STEP_ELEMENT_COUNT * n,
+                   v, &scratch);
+      linesOutput->length++;
     }
   }
-  affine_destroy(v);
-  complexAffine_destroy(q);
 
-  // Final Exponentiation
-  mpz_t exponent, pPow, exponentPart;
-  mpz_inits(exponent, pPow, exponentPart, NULL);
+  tate_destroyScratch(&scratch);
+}
+
+void tate_destroyLines(TatePairingLines lines) { free(lines.coefficients); }
 
-  mpz_pow_ui(pPow, ellipticCurve.fieldOrder, embeddingDegree);
-  mpz_sub_ui(exponentPart, pPow, 1);
-  mpz_cdiv_q(exponent, exponentPart, subgroupOrder);
+CryptidStatus tate_performPairingWithLines(
+    Complex *result, const TatePairingLines lines, const AffinePoint b,
+    const TatePairingPrecomputation precomputation, const mpz_t subgroupOrder,
+    const EllipticCurve ellipticCurve) {
+  // The Miller loop of tate_performMultiPairingWithPrecomputation, where only
+  // the evaluation of the stored lines is left.
+  if (lines.length == 0 || affine_isInfinity(b)) {
+    complex_initLong(result, 1, 0);
+    return CRYPTID_SUCCESS;
+  }
 
-  complex_modPow(result, f, exponent, ellipticCurve.fieldOrder);
+  TatePairingScratch scratch;
+  tate_initScratch(&scratch, ellipticCurve);
+  const mp_size_t n = scratch.field.limbCount;
 
-  mpz_clears(exponent, pPow, exponentPart, NULL);
-  complex_destroy(f);
+  TatePairingPoint q;
+  tate_initPoint(&q, scratch.pairs, b, precomputation, ellipticCurve,
+                 &scratch);
 
-  return CRYPTID_SUCCESS;
+  const mp_limb_t *line = lines.coefficients;
+  for (int i = mpz_sizeinbase(subgroupOrder, 2) - 2; i >= 0; --i) {
+    tate_square(&scratch);
+    tate_multiplyByLineQuotient(line, q, &scratch);
+    line += TATE_STEP_ELEMENT_COUNT * n;
+
+    if (mpz_tstbit(subgroupOrder, i)) {
+      tate_multiplyByLineQuotient(line, q, &scratch);
+      line += TATE_STEP_ELEMENT_COUNT * n;
+    }
+  }
+
+  CryptidStatus status = tate_finalExponentiation(
+      result, precomputation, ellipticCurve.fieldOrder, &scratch);
+
+  tate_destroyScratch(&scratch);
+
+  return status;
 }
@@ -1,10 +1,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "complex/Cyclotomic.h"
 #include "elliptic/TatePairing.h"
 #include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryption.h"
-#include "util/PrimalityTest.h"
-#include "util/RandBytes.h"
 #include "util/Random.h"
 #include "util/Utils.h"
 
@@ -56,12 +55,12 @@ CryptidStatus cryptid_ibe_bonehFranklin_setup(
                            Q_LENGTH_MAPPING[(int)securityLevel] - 3;
   mpz_t r, p;
   mpz_inits(r, p, NULL);
-  do {
-    random_mpzOfLength(r, lengthOfR);
-    mpz_mul_ui(p, r, 12);
-    mpz_mul(p, p, q);
-    mpz_sub_ui(p, p, 1);
-  } while (!primalityTest_isProbablePrime(p));
+  status = random_pairingPrime(p, r, q, lengthOfR);
+
+  if (status) {
+    mpz_clears(p, q, r, NULL);
+    return status;
+  }
 
   mpz_t zero, one;
   mpz_init_set_ui(zero, 0);
@@ -108,10 +107,18 @@ CryptidStatus cryptid_ibe_bonehFranklin_setup(
   mpz_init_set(qMinusTwo, q);
   mpz_sub_ui(qMinusTwo, qMinusTwo, 2);
 
-  random_mpzInRange(s, qMinusTwo);
-  mpz_add_ui(s, s, 2);
+  status = random_mpzInRange(s, qMinusTwo);
   mpz_clear(qMinusTwo);
 
+  if (status) {
+    mpz_clears(p, q, r, s, NULL);
+    affine_destroy(pointP);
+    ellipticCurve_destroy(ec);
+    return status;
+  }
+
+  mpz_add_ui(s, s, 2);
+
   // Determine the public parameters.
   AffinePoint pointPpublic;
 
@@ -147,13 +154,12 @@ CryptidStatus cryptid_ibe_bonehFranklin_setup(
   return CRYPTID_SUCCESS;
 }
 
-CryptidStatus cryptid_ibe_bonehFranklin_extract(
+CryptidStatus cryptid_ibe_bonehFranklin_extractWithContext(
     AffinePointAsBinary *result, const char *const identity,
     const size_t identityLength,
     const BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary
         masterSecretAsBinary,
-    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
-        publicParametersAsBinary) {
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
   // Implementation of Algorithm 5.3.1 (BFextractPriv) in [RFC-5091].
 
   /*if (!result)
@@ -165,27 +171,17 @@ CryptidStatus cryptid_ibe_bonehFranklin_extract(
     return CRYPTID_IDENTITY_LENGTH_ERROR;
   }
 
-  BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters;
-  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_toBonehFranklinIdentityBasedEncryptionPublicParameters(
-      &publicParameters, publicParametersAsBinary);
-
-  if (!bonehFranklinIdentityBasedEncryptionPublicParameters_isValid(
-          publicParameters)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
-    return CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR;
-  }
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
 
   AffinePoint qId;
 
   // Let \f$Q_{id} = \mathrm{HashToPoint}(E, p, q, id, \mathrm{hashfcn})\f$.
-  CryptidStatus status = hashToPoint(
-      &qId, identity, identityLength, publicParameters.q,
+  CryptidStatus status = hashToPointWithCofactor(
+      &qId, identity, identityLength, context->cofactor,
       publicParameters.ellipticCurve, publicParameters.hashFunction);
 
   if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     return status;
   }
 
@@ -202,8 +198,6 @@ CryptidStatus cryptid_ibe_bonehFranklin_extract(
 
   affineAsBinary_fromAffine(result, affineResult);
 
-  bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-      publicParameters);
   affine_destroy(qId);
   affine_destroy(affineResult);
   mpz_clear(masterSecret);
@@ -211,12 +205,169 @@ CryptidStatus cryptid_ibe_bonehFranklin_extract(
   return status;
 }
 
-CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
+// Computes \f$\mathrm{theta} = \mathrm{Pairing}(E, p, q, P_{pub}, Q_{id})\f$,
+// which depends only on the identity, so it is taken from the identity cache
+// of the context, if there is one.
+static CryptidStatus bonehFranklinIdentityBasedEncryption_identityPairing(
+    Complex *thetaOutput, const char *const identity,
+    const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
+
+  if (context->identityCache &&
+      bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+          thetaOutput, context->identityCache, identity, identityLength)) {
+    return CRYPTID_SUCCESS;
+  }
+
+  // \f$Q_{id} = \mathrm{HashToPoint}(E, p, q, id, \mathrm{hashfcn})\f$
+  // which results in a point of order \f$q\f$ in \f$E(F_p)\f$.
+  AffinePoint pointQId;
+  CryptidStatus status = hashToPointWithCofactor(
+      &pointQId, identity, identityLength, context->cofactor,
+      publicParameters.ellipticCurve, publicParameters.hashFunction);
+  if (status) {
+    return status;
+  }
+
+  // Let \f$\mathrm{theta} = \mathrm{Pairing}(E, p, q, P_{pub}, Q_{id})\f$,
+  // which is an element of the extension field \f$F_p^2\f$ obtained using
+  // the modified Tate pairing.
+  if (context->pointPpublicLines) {
+    status = tate_performPairingWithLines(
+        thetaOutput, *context->pointPpublicLines, pointQId,
+        context->pairingPrecomputation, publicParameters.q,
+        publicParameters.ellipticCurve);
+  } else {
+    status = tate_performPairingWithPrecomputation(
+        thetaOutput, publicParameters.pointPpublic, pointQId,
+        context->pairingPrecomputation, publicParameters.q,
+        publicParameters.ellipticCurve);
+  }
+  affine_destroy(pointQId);
+  if (status) {
+    return status;
+  }
+
+  if (context->identityCache) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+        context->identityCache, identity, identityLength, *thetaOutput);
+  }
+
+  return CRYPTID_SUCCESS;
+}
+
+// Computes \f$[l]P\f$, with the fixed-base table of the context if it has one.
+static CryptidStatus bonehFranklinIdentityBasedEncryption_multiplyPointP(
+    AffinePoint *result, const mpz_t l,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  if (context->pointPTable) {
+    return fixedBase_multiply(result, *context->pointPTable, l,
+                              context->publicParameters.ellipticCurve);
+  }
+
+  return affine_wNAFMultiply(result, context->publicParameters.pointP, l,
+                             context->publicParameters.ellipticCurve);
+}
+
+// Computes \f$U = [l]P\f$ and \f$V = \mathrm{hashfcn}(\mathrm{Canonical}(p, k,
+// 0, \mathrm{theta}^l)) \oplus rho\f$. cipherV must have room for {@code
+// hashlen} octets.
+static CryptidStatus bonehFranklinIdentityBasedEncryption_encapsulate(
+    AffinePoint *cipherPointUOutput, unsigned char *cipherV,
+    const Complex theta, const mpz_t l, const unsigned char *const rho,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
+  const int hashLen = context->hashLength;
+
+  // Let \f$U = [l]P\f$, which is a point of order \f$q\f$ in \f$E(F_p)\f$.
+  CryptidStatus status = bonehFranklinIdentityBasedEncryption_multiplyPointP(
+      cipherPointUOutput, l, context);
+  if (status) {
+    return status;
+  }
+
+  // Let \f$\mathrm{theta}^{\prime} = \mathrm{theta}^l\f$, which is theta raised
+  // to the power of \f$l\f$ in \f$F_p^2\f$.
+  Complex thetaPrime;
+  cyclotomic_pow(&thetaPrime, theta, l,
+                 publicParameters.ellipticCurve.fieldOrder);
+
+  // Let \f$z = \mathrm{Canonical}(p, k, 0, \mathrm{theta}^{\prime})\f$, a
+  // canonical string representation of {@code theta'}.
+  int zLength;
+  unsigned char *z;
+  canonical(&z, &zLength, thetaPrime, publicParameters.ellipticCurve.fieldOrder,
+            1);
+
+  // Let \f$w = \mathrm{hashfcn}(z)\f$ using the {@code hashfcn} hashing
+  // algorithm, the result of which is a {@code hashlen}-octet string.
+  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
+
+  // Let \f$V = w \oplus rho\f$, which is the {@code hashlen}-octet long
+  // bit-wise XOR of \f$w\f$ and {@code rho}.
+  for (int i = 0; i < hashLen; i++) {
+    cipherV[i] = w[i] ^ rho[i];
+  }
+
+  complex_destroy(thetaPrime);
+  free(z);
+  free(w);
+
+  return CRYPTID_SUCCESS;
+}
+
+// Recovers {@code rho} from \f$(U, V)\f$ using the private key \f$S_{id}\f$.
+// rho must have room for {@code hashlen} octets.
+static CryptidStatus bonehFranklinIdentityBasedEncryption_decapsulate(
+    unsigned char *rho, const AffinePoint cipherPointU,
+    const unsigned char *const cipherV, const AffinePoint privateKey,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
+  const int hashLen = context->hashLength;
+
+  // Let \f$theta = \mathrm{Pairing}(E, p ,q, U, S_{id})\f$ by applying the
+  // modified Tate pairing.
+  Complex theta;
+  CryptidStatus status = tate_performPairingWithPrecomputation(
+      &theta, cipherPointU, privateKey, context->pairingPrecomputation,
+      publicParameters.q, publicParameters.ellipticCurve);
+  if (status) {
+    return status;
+  }
+
+  // Let \f$z = \mathrm{Canonical}(p, k, 0, theta)\f$ a canonical string
+  // representation of {@code theta}.
+  int zLength;
+  unsigned char *z;
+  canonical(&z, &zLength, theta, publicParameters.ellipticCurve.fieldOrder, 1);
+
+  // Let \f$w = \mathrm{hashfcn}(z)$ using the {@code hashfcn} hashing
+  // algorithm, the result of which is a {@code hashlen}-octet string.
+  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
+
+  // Let \f$rho = w \oplus V\f$, the bit-wise XOR of \f$w\f$ and \f$V\f$.
+  for (int i = 0; i < hashLen; i++) {
+    rho[i] = w[i] ^ cipherV[i];
+  }
+
+  complex_destroy(theta);
+  free(z);
+  free(w);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_encryptWithContext(
     BonehFranklinIdentityBasedEncryptionCiphertextAsBinary *result,
     const char *const message, const size_t messageLength,
     const char *const identity, const size_t identityLength,
-    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
-        publicParametersAsBinary) {
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
   // Implementation of Algorithm 5.4.1 (BFencrypt) in [RFC-5091].
 
   if (!message) {
@@ -235,48 +386,42 @@ CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
     return CRYPTID_IDENTITY_LENGTH_ERROR;
   }
 
-  BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters;
-  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_toBonehFranklinIdentityBasedEncryptionPublicParameters(
-      &publicParameters, publicParametersAsBinary);
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
 
-  if (!bonehFranklinIdentityBasedEncryptionPublicParameters_isValid(
-          publicParameters)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
-    return CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR;
+  // Let {@code hashlen} be the length of the output of the cryptographic hash
+  // function hashfcn from the public parameters.
+  const int hashLen = context->hashLength;
+
+  Complex theta;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryption_identityPairing(
+      &theta, identity, identityLength, context);
+  if (status) {
+    return status;
   }
 
   mpz_t l;
   mpz_init(l);
 
-  // Let {@code hashlen} be the length of the output of the cryptographic hash
-  // function hashfcn from the public parameters.
-  int hashLen;
-  hashFunction_getHashSize(&hashLen, publicParameters.hashFunction);
+  // The concatenation \f$rho || t\f$, both parts of which are produced in
+  // place.
+  unsigned char *rhoT =
+      (unsigned char *)calloc(2 * hashLen + 1, sizeof(unsigned char));
 
-  // \f$Q_{id} = \mathrm{HashToPoint}(E, p, q, id, \mathrm{hashfcn})\f$
-  // which results in a point of order \f$q\f$ in \f$E(F_p)\f$.
-  AffinePoint pointQId;
-  CryptidStatus status = hashToPoint(
-      &pointQId, identity, identityLength, publicParameters.q,
-      publicParameters.ellipticCurve, publicParameters.hashFunction);
+  // Select a random {@code hashlen}-bit vector {@code rho}, represented as
+  // (\f$\frac{\mathrm{hashlen}}{8}\f$)-octet string in big-endian convention.
+  unsigned char *rho = rhoT;
+  status = random_bytes(rho, hashLen);
   if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
+    free(rhoT);
     mpz_clear(l);
+    complex_destroy(theta);
     return status;
   }
 
-  // Select a random {@code hashlen}-bit vector {@code rho}, represented as
-  // (\f$\frac{\mathrm{hashlen}}{8}\f$)-octet string in big-endian convention.
-  unsigned char *rho =
-      (unsigned char *)calloc(hashLen + 1, sizeof(unsigned char));
-  cryptid_randomBytes(rho, hashLen);
-  rho[hashLen] = '\0';
-
   // Let \f$t = \mathrm{hashfcn}(m)\f$, a {@code hashlen}-octet string resulting
   // from applying the {@code hashfcn} algorithm to the input \f$m\f$.
-  unsigned char *t = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  unsigned char *t = rhoT + hashLen;
   hashFunction_hash(t, (unsigned char *)message, messageLength,
                     publicParameters.hashFunction);
 
@@ -284,78 +429,23 @@ CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
   // integer in the range \f$0\f$ to \f$q - 1\f$ resulting from applying {@code
   // HashToRange} to the \f$(2 * \mathrm{hashlen})\f$-octet concatenation of
   // {@code rho} and \f$t\f$.
-  unsigned char *concat =
-      (unsigned char *)calloc(2 * hashLen + 1, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    concat[i] = rho[i];
-  }
-  for (int i = 0; i < hashLen; i++) {
-    concat[hashLen + i] = t[i];
-  }
-  concat[2 * hashLen] = '\0';
-
-  hashToRange(l, concat, 2 * hashLen, publicParameters.q,
+  hashToRange(l, rhoT, 2 * hashLen, publicParameters.q,
               publicParameters.hashFunction);
 
-  // Let \f$U = [l]P\f$, which is a point of order \f$q\f$ in \f$E(F_p)\f$.
+  // Let \f$U = [l]P\f$ and \f$V = \mathrm{hashfcn}(\mathrm{Canonical}(p, k, 0,
+  // \mathrm{theta}^l)) \oplus rho\f$.
   AffinePoint cipherPointU;
-  status = affine_wNAFMultiply(&cipherPointU, publicParameters.pointP, l,
-                               publicParameters.ellipticCurve);
+  unsigned char *cipherV =
+      (unsigned char *)calloc(hashLen + 1, sizeof(unsigned char));
+  status = bonehFranklinIdentityBasedEncryption_encapsulate(
+      &cipherPointU, cipherV, theta, l, rho, context);
   if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     mpz_clear(l);
-    affine_destroy(pointQId);
-    free(rho);
-    free(t);
-    free(concat);
+    complex_destroy(theta);
+    free(rhoT);
+    free(cipherV);
     return status;
   }
-
-  // Let \f$\mathrm{theta} = \mathrm{Pairing}(E, p, q, P_{pub}, Q_{id})\f$,
-  // which is an element of the extension field \f$F_p^2\f$ obtained using the
-  // modified Tate pairing.
-  Complex theta;
-  status =
-      tate_performPairing(&theta, publicParameters.pointPpublic, pointQId, 2,
-                          publicParameters.q, publicParameters.ellipticCurve);
-  if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
-    mpz_clear(l);
-    affine_destroy(pointQId);
-    free(rho);
-    free(t);
-    free(concat);
-    affine_destroy(cipherPointU);
-    return status;
-  }
-
-  // Let \f$\mathrm{theta}^{\prime} = \mathrm{theta}^l\f$, which is theta raised
-  // to the power of \f$l\f$ in \f$F_p^2\f$.
-  Complex thetaPrime;
-  complex_modPow(&thetaPrime, theta, l,
-                 publicParameters.ellipticCurve.fieldOrder);
-
-  // Let \f$z = \mathrm{Canonical}(p, k, 0, \mathrm{theta}^{\prime})\f$, a
-  // canonical string representation of {@code theta'}.
-  int zLength;
-  unsigned char *z;
-  canonical(&z, &zLength, thetaPrime, publicParameters.ellipticCurve.fieldOrder,
-            1);
-
-  // Let \f$w = \mathrm{hashfcn}(z)\f$ using the {@code hashfcn} hashing
-  // algorithm, the result of which is a {@code hashlen}-octet string.
-  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
-
-  // Let \f$V = w \oplus rho\f$, which is the {@code hashlen}-octet long
-  // bit-wise XOR of \f$w\f$ and {@code rho}.
-  unsigned char *cipherV =
-      (unsigned char *)calloc(hashLen + 1, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    cipherV[i] = w[i] ^ rho[i];
-  }
   cipherV[hashLen] = '\0';
 
   // Let W = \mathrm{HashBytes}(|m|, rho, \mathrm{hashfcn}) \oplus m\f$, which
@@ -380,17 +470,10 @@ CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
       result, ciphertext);
 
   bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
-  bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-      publicParameters);
   mpz_clear(l);
-  affine_destroy(pointQId);
   affine_destroy(cipherPointU);
-  complex_destroyMany(2, theta, thetaPrime);
-  free(rho);
-  free(concat);
-  free(z);
-  free(t);
-  free(w);
+  complex_destroy(theta);
+  free(rhoT);
   free(cipherV);
   free(cipherW);
   free(hashedBytes);
@@ -398,32 +481,21 @@ CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
   return CRYPTID_SUCCESS;
 }
 
-CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
+CryptidStatus cryptid_ibe_bonehFranklin_decryptWithContext(
     char **result,
     const BonehFranklinIdentityBasedEncryptionCiphertextAsBinary
         ciphertextAsBinary,
     const AffinePointAsBinary privateKeyAsBinary,
-    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
-        publicParametersAsBinary) {
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
   // Implementation of Algorithm 5.5.1 (BFdecrypt) in [RFC-5091].
 
-  BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters;
-  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_toBonehFranklinIdentityBasedEncryptionPublicParameters(
-      &publicParameters, publicParametersAsBinary);
-
-  if (!bonehFranklinIdentityBasedEncryptionPublicParameters_isValid(
-          publicParameters)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
-    return CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR;
-  }
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
 
   AffinePoint privateKey;
   affineAsBinary_toAffine(&privateKey, privateKeyAsBinary);
 
   if (!affine_isValid(privateKey, publicParameters.ellipticCurve)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     affine_destroy(privateKey);
     return CRYPTID_ILLEGAL_PRIVATE_KEY_ERROR;
   }
@@ -434,54 +506,34 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
 
   if (!bonehFranklinIdentityBasedEncryptionCiphertext_isValid(
           ciphertext, publicParameters.ellipticCurve)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     affine_destroy(privateKey);
     bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
     return CRYPTID_ILLEGAL_CIPHERTEXT_ERROR;
   }
 
-  mpz_t l;
-  mpz_init(l);
-
   // Let {@code hashlen} be the length of the output of the hash function
   // {@code hashfcn} measured in octets.
-  int hashLen;
-  hashFunction_getHashSize(&hashLen, publicParameters.hashFunction);
+  const int hashLen = context->hashLength;
 
-  // Let \f$theta = \mathrm{Pairing}(E, p ,q, U, S_{id})\f$ by applying the
-  // modified Tate pairing.
-  Complex theta;
-  CryptidStatus status =
-      tate_performPairing(&theta, ciphertext.cipherU, privateKey, 2,
-                          publicParameters.q, publicParameters.ellipticCurve);
+  // The concatenation \f$rho || t\f$, both parts of which are produced in
+  // place.
+  unsigned char *rhoT =
+      (unsigned char *)calloc(2 * hashLen + 1, sizeof(unsigned char));
+
+  // Let \f$rho = \mathrm{hashfcn}(\mathrm{Canonical}(p, k, 0,
+  // \mathrm{Pairing}(E, p, q, U, S_{id}))) \oplus V\f$.
+  unsigned char *rho = rhoT;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryption_decapsulate(
+      rho, ciphertext.cipherU, ciphertext.cipherV, privateKey, context);
   if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     affine_destroy(privateKey);
     bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
-    mpz_clear(l);
+    free(rhoT);
     return status;
   }
 
-  // Let \f$z = \mathrm{Canonical}(p, k, 0, theta)\f$ a canonical string
-  // representation of {@code theta}.
-  int zLength;
-  unsigned char *z;
-  canonical(&z, &zLength, theta, publicParameters.ellipticCurve.fieldOrder, 1);
-
-  // Let \f$w = \mathrm{hashfcn}(z)$ using the {@code hashfcn} hashing
-  // algorithm, the result of which is a {@code hashlen}-octet string.
-  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
-
-  // Let \f$rho = w \oplus V\f$, the bit-wise XOR of \f$w\f$ and \f$V\f$.
-  unsigned char *rho =
-      (unsigned char *)calloc(hashLen + 1, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    rho[i] = w[i] ^ ciphertext.cipherV[i];
-  }
-  rho[hashLen] = '\0';
+  mpz_t l;
+  mpz_init(l);
 
   // Let \f$m = \mathrm{HashBytes}(|W|, rho, \mathrm{hashfcn}) \oplus W\f$,
   // which is the bit-wise XOR of \f$m\f$ with the first \f$|W|\f$ octets of the
@@ -496,41 +548,24 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
   m[ciphertext.cipherWLength] = '\0';
 
   // Let \f$t = \mathrm{hashfcn}(m)\f$ using the \f$hashfcn\f$ algorithm.
-  unsigned char *t = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  unsigned char *t = rhoT + hashLen;
   hashFunction_hash(t, (unsigned char *)m, ciphertext.cipherWLength,
                     publicParameters.hashFunction);
 
   // Let \f$l = \mathrm{HashToRange}(rho || t, q, \mathrm{hashfcn}) using
   // HashToRange on the \f$(2 * \mathrm{hashlen})\f$-octet concatenation of
   // {@code rho} and \f$t\f$.
-  unsigned char *concat =
-      (unsigned char *)calloc(2 * hashLen + 1, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    concat[i] = rho[i];
-  }
-  for (int i = 0; i < hashLen; i++) {
-    concat[hashLen + i] = t[i];
-  }
-  concat[2 * hashLen] = '\0';
-
-  hashToRange(l, concat, 2 * hashLen, publicParameters.q,
+  hashToRange(l, rhoT, 2 * hashLen, publicParameters.q,
               publicParameters.hashFunction);
 
-  complex_destroy(theta);
-  free(z);
-  free(t);
-  free(w);
-  free(rho);
+  free(rhoT);
   free(hashedBytes);
-  free(concat);
 
   // Verify that \f$U = [l]P\f$.
   AffinePoint testPoint;
-  status = affine_wNAFMultiply(&testPoint, publicParameters.pointP, l,
-                               publicParameters.ellipticCurve);
+  status = bonehFranklinIdentityBasedEncryption_multiplyPointP(&testPoint, l,
+                                                               context);
   if (status) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     affine_destroy(privateKey);
     bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
     mpz_clear(l);
@@ -540,8 +575,6 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
 
   // If this is the case, then the decrypted plaintext \f$m\f$ is returned.
   if (affine_isEquals(ciphertext.cipherU, testPoint)) {
-    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-        publicParameters);
     affine_destroy(privateKey);
     bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
     affine_destroy(testPoint);
@@ -551,8 +584,6 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
   }
 
   // Otherwise, the ciphertext is rejected and no plaintext is returned.
-  bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
-      publicParameters);
   affine_destroy(privateKey);
   bonehFranklinIdentityBasedEncryptionCiphertext_destroy(ciphertext);
   affine_destroy(testPoint);
@@ -560,3 +591,330 @@ CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
   free(m);
   return CRYPTID_DECRYPTION_FAILED_ERROR;
 }
+
+// Derives the key material of the stream from {@code rho}. Let \f$K =
+// \mathrm{HashBytes}(2 \cdot \mathrm{hashlen}, rho, \mathrm{hashfcn})\f$, the
+// first half of which seeds the keystream, while the second half is the
+// authentication key.
+static void bonehFranklinIdentityBasedEncryption_initStream(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    const unsigned char *const rho,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  const int hashLen = context->hashLength;
+
+  unsigned char *keyMaterial;
+  hashBytes(&keyMaterial, 2 * hashLen, rho, hashLen,
+            context->publicParameters.hashFunction);
+
+  bonehFranklinIdentityBasedEncryptionStream_init(
+      streamOutput, keyMaterial, context->publicParameters.hashFunction);
+
+  memset(keyMaterial, 0, 2 * hashLen);
+  free(keyMaterial);
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_encryptInit(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        *encapsulationOutput,
+    const char *const identity, const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  // The key encapsulation follows Algorithm 5.4.1 (BFencrypt) in [RFC-5091],
+  // with \f$l\f$ derived from {@code rho} alone, as there is no message to
+  // hash at this point.
+
+  if (!identity) {
+    return CRYPTID_IDENTITY_NULL_ERROR;
+  }
+
+  if (identityLength == 0) {
+    return CRYPTID_IDENTITY_LENGTH_ERROR;
+  }
+
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
+  const int hashLen = context->hashLength;
+
+  Complex theta;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryption_identityPairing(
+      &theta, identity, identityLength, context);
+  if (status) {
+    return status;
+  }
+
+  // Select a random {@code hashlen}-octet string {@code rho}.
+  unsigned char *rho = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  status = random_bytes(rho, hashLen);
+  if (status) {
+    free(rho);
+    complex_destroy(theta);
+    return status;
+  }
+
+  // Let \f$l = \mathrm{HashToRange}(rho, q, \mathrm{hashfcn})\f$.
+  mpz_t l;
+  mpz_init(l);
+  hashToRange(l, rho, hashLen, publicParameters.q,
+              publicParameters.hashFunction);
+
+  AffinePoint cipherPointU;
+  unsigned char *cipherV =
+      (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  status = bonehFranklinIdentityBasedEncryption_encapsulate(
+      &cipherPointU, cipherV, theta, l, rho, context);
+  complex_destroy(theta);
+  mpz_clear(l);
+  if (status) {
+    free(rho);
+    free(cipherV);
+    return status;
+  }
+
+  // The encapsulation takes ownership of cipherV.
+  affineAsBinary_fromAffine(&encapsulationOutput->cipherU, cipherPointU);
+  encapsulationOutput->cipherV = cipherV;
+  encapsulationOutput->cipherVLength = hashLen;
+
+  bonehFranklinIdentityBasedEncryption_initStream(streamOutput, rho, context);
+
+  affine_destroy(cipherPointU);
+  memset(rho, 0, hashLen);
+  free(rho);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_encryptUpdate(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length) {
+  if (!input && length != 0) {
+    return CRYPTID_MESSAGE_NULL_ERROR;
+  }
+
+  bonehFranklinIdentityBasedEncryptionStream_update(stream, output, input,
+                                                    length, 1);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_encryptFinal(
+    unsigned char *tagOutput,
+    BonehFranklinIdentityBasedEncryptionStream *stream) {
+  bonehFranklinIdentityBasedEncryptionStream_tag(tagOutput, stream);
+  bonehFranklinIdentityBasedEncryptionStream_destroy(stream);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_decryptInit(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    const BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        encapsulationAsBinary,
+    const AffinePointAsBinary privateKeyAsBinary,
+    const BonehFranklinIdentityBasedEncryptionContext *const context) {
+  const BonehFranklinIdentityBasedEncryptionPublicParameters publicParameters =
+      context->publicParameters;
+  const int hashLen = context->hashLength;
+
+  if (!encapsulationAsBinary.cipherV ||
+      encapsulationAsBinary.cipherVLength != (size_t)hashLen) {
+    return CRYPTID_ILLEGAL_CIPHERTEXT_ERROR;
+  }
+
+  AffinePoint privateKey;
+  affineAsBinary_toAffine(&privateKey, privateKeyAsBinary);
+
+  if (!affine_isValid(privateKey, publicParameters.ellipticCurve)) {
+    affine_destroy(privateKey);
+    return CRYPTID_ILLEGAL_PRIVATE_KEY_ERROR;
+  }
+
+  AffinePoint cipherPointU;
+  affineAsBinary_toAffine(&cipherPointU, encapsulationAsBinary.cipherU);
+
+  if (!affine_isValid(cipherPointU, publicParameters.ellipticCurve)) {
+    affine_destroy(privateKey);
+    affine_destroy(cipherPointU);
+    return CRYPTID_ILLEGAL_CIPHERTEXT_ERROR;
+  }
+
+  unsigned char *rho = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  CryptidStatus status = bonehFranklinIdentityBasedEncryption_decapsulate(
+      rho, cipherPointU, encapsulationAsBinary.cipherV, privateKey, context);
+  affine_destroy(privateKey);
+  if (status) {
+    affine_destroy(cipherPointU);
+    free(rho);
+    return status;
+  }
+
+  // Let \f$l = \mathrm{HashToRange}(rho, q, \mathrm{hashfcn})\f$ and verify
+  // that \f$U = [l]P\f$.
+  mpz_t l;
+  mpz_init(l);
+  hashToRange(l, rho, hashLen, publicParameters.q,
+              publicParameters.hashFunction);
+
+  AffinePoint testPoint;
+  status = bonehFranklinIdentityBasedEncryption_multiplyPointP(&testPoint, l,
+                                                               context);
+  mpz_clear(l);
+  if (status) {
+    affine_destroy(cipherPointU);
+    free(rho);
+    return status;
+  }
+
+  if (!affine_isEquals(cipherPointU, testPoint)) {
+    status = CRYPTID_DECRYPTION_FAILED_ERROR;
+  } else {
+    bonehFranklinIdentityBasedEncryption_initStream(streamOutput, rho,
+                                                    context);
+  }
+
+  affine_destroy(cipherPointU);
+  affine_destroy(testPoint);
+  memset(rho, 0, hashLen);
+  free(rho);
+
+  return status;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_decryptUpdate(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length) {
+  if (!input && length != 0) {
+    return CRYPTID_MESSAGE_NULL_ERROR;
+  }
+
+  bonehFranklinIdentityBasedEncryptionStream_update(stream, output, input,
+                                                    length, 0);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_decryptFinal(
+    BonehFranklinIdentityBasedEncryptionStream *stream,
+    const unsigned char *const tag, const size_t tagLength) {
+  const int hashLen = stream->hashLength;
+
+  unsigned char *expectedTag =
+      (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  bonehFranklinIdentityBasedEncryptionStream_tag(expectedTag, stream);
+  bonehFranklinIdentityBasedEncryptionStream_destroy(stream);
+
+  if (!tag || tagLength != (size_t)hashLen) {
+    free(expectedTag);
+    return CRYPTID_DECRYPTION_FAILED_ERROR;
+  }
+
+  // Compare every octet, so that the time taken does not reveal the position
+  // of the first mismatch.
+  unsigned char difference = 0;
+  for (int i = 0; i < hashLen; i++) {
+    difference |= expectedTag[i] ^ tag[i];
+  }
+
+  free(expectedTag);
+
+  return difference ? CRYPTID_DECRYPTION_FAILED_ERROR : CRYPTID_SUCCESS;
+}
+
+void cryptid_ibe_bonehFranklin_destroyStream(
+    BonehFranklinIdentityBasedEncryptionStream *stream) {
+  bonehFranklinIdentityBasedEncryptionStream_destroy(stream);
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_createContext(
+    BonehFranklinIdentityBasedEncryptionContext *contextOutput,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary) {
+  CryptidStatus status = bonehFranklinIdentityBasedEncryptionContext_init(
+      contextOutput, publicParametersAsBinary);
+
+  if (!status) {
+    bonehFranklinIdentityBasedEncryptionContext_precompute(contextOutput);
+  }
+
+  return status;
+}
+
+void cryptid_ibe_bonehFranklin_destroyContext(
+    BonehFranklinIdentityBasedEncryptionContext *context) {
+  bonehFranklinIdentityBasedEncryptionContext_destroy(context);
+}
+
+void cryptid_ibe_bonehFranklin_enableIdentityCache(
+    BonehFranklinIdentityBasedEncryptionContext *context,
+    const size_t capacity) {
+  bonehFranklinIdentityBasedEncryptionContext_enableIdentityCache(context,
+                                                                  capacity);
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_extract(
+    AffinePointAsBinary *result, const char *const identity,
+    const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary
+        masterSecretAsBinary,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary) {
+  BonehFranklinIdentityBasedEncryptionContext context;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryptionContext_init(
+      &context, publicParametersAsBinary);
+
+  if (status) {
+    return status;
+  }
+
+  status = cryptid_ibe_bonehFranklin_extractWithContext(
+      result, identity, identityLength, masterSecretAsBinary, &context);
+
+  bonehFranklinIdentityBasedEncryptionContext_destroy(&context);
+
+  return status;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_encrypt(
+    BonehFranklinIdentityBasedEncryptionCiphertextAsBinary *result,
+    const char *const message, const size_t messageLength,
+    const char *const identity, const size_t identityLength,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary) {
+  BonehFranklinIdentityBasedEncryptionContext context;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryptionContext_init(
+      &context, publicParametersAsBinary);
+
+  if (status) {
+    return status;
+  }
+
+  status = cryptid_ibe_bonehFranklin_encryptWithContext(
+      result, message, messageLength, identity, identityLength, &context);
+
+  bonehFranklinIdentityBasedEncryptionContext_destroy(&context);
+
+  return status;
+}
+
+CryptidStatus cryptid_ibe_bonehFranklin_decrypt(
+    char **result,
+    const BonehFranklinIdentityBasedEncryptionCiphertextAsBinary
+        ciphertextAsBinary,
+    const AffinePointAsBinary privateKeyAsBinary,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary) {
+  BonehFranklinIdentityBasedEncryptionContext context;
+  CryptidStatus status = bonehFranklinIdentityBasedEncryptionContext_init(
+      &context, publicParametersAsBinary);
+
+  if (status) {
+    return status;
+  }
+
+  status = cryptid_ibe_bonehFranklin_decryptWithContext(
+      result, ciphertextAsBinary, privateKeyAsBinary, &context);
+
+  bonehFranklinIdentityBasedEncryptionContext_destroy(&context);
+
+  return status;
+}
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionContext.h"
+
+CryptidStatus bonehFranklinIdentityBasedEncryptionContext_init(
+    BonehFranklinIdentityBasedEncryptionContext *contextOutput,
+    const BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary
+        publicParametersAsBinary) {
+  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_toBonehFranklinIdentityBasedEncryptionPublicParameters(
+      &contextOutput->publicParameters, publicParametersAsBinary);
+
+  if (!bonehFranklinIdentityBasedEncryptionPublicParameters_isValid(
+          contextOutput->publicParameters)) {
+    bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
+        contextOutput->publicParameters);
+    return CRYPTID_ILLEGAL_PUBLIC_PARAMETERS_ERROR;
+  }
+
+  hashFunction_getHashSize(&contextOutput->hashLength,
+                           contextOutput->publicParameters.hashFunction);
+
+  // \f$\frac{p + 1}{q}\f$, used by {@code HashToPoint}.
+  mpz_init(contextOutput->cofactor);
+  mpz_add_ui(contextOutput->cofactor,
+             contextOutput->publicParameters.ellipticCurve.fieldOrder, 1);
+  mpz_cdiv_q(contextOutput->cofactor, contextOutput->cofactor,
+             contextOutput->publicParameters.q);
+
+  tate_initPrecomputation(&contextOutput->pairingPrecomputation, 2,
+                          contextOutput->publicParameters.q,
+                          contextOutput->publicParameters.ellipticCurve);
+
+  contextOutput->pointPTable = NULL;
+  contextOutput->pointPpublicLines = NULL;
+  contextOutput->identityCache = NULL;
+
+  return CRYPTID_SUCCESS;
+}
+
+void bonehFranklinIdentityBasedEncryptionContext_precompute(
+    BonehFranklinIdentityBasedEncryptionContext *context) {
+  if (!context->pointPTable) {
+    context->pointPTable = (FixedBaseTable *)malloc(sizeof(FixedBaseTable));
+    fixedBase_init(context->pointPTable, context->publicParameters.pointP,
+                   context->publicParameters.q,
+                   context->publicParameters.ellipticCurve);
+  }
+
+  if (!context->pointPpublicLines) {
+    context->pointPpublicLines =
+        (TatePairingLines *)malloc(sizeof(TatePairingLines));
+    tate_initLines(context->pointPpublicLines,
+                   context->publicParameters.pointPpublic,
+                   context->publicParameters.q,
+                   context->publicParameters.ellipticCurve);
+  }
+}
+
+void bonehFranklinIdentityBasedEncryptionContext_enableIdentityCache(
+    BonehFranklinIdentityBasedEncryptionContext *context,
+    const size_t capacity) {
+  // Encryptions may be using the cache, so it is emptied in place.
+  if (context->identityCache) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_reset(
+        context->identityCache, capacity);
+    return;
+  }
+
+  BonehFranklinIdentityBasedEncryptionIdentityCache *identityCache =
+      (BonehFranklinIdentityBasedEncryptionIdentityCache *)malloc(
+          sizeof(BonehFranklinIdentityBasedEncryptionIdentityCache));
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(identityCache,
+                                                         capacity);
+  context->identityCache = identityCache;
+}
+
+void bonehFranklinIdentityBasedEncryptionContext_destroy(
+    BonehFranklinIdentityBasedEncryptionContext *context) {
+  bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
+      context->publicParameters);
+  mpz_clear(context->cofactor);
+  tate_destroyPrecomputation(context->pairingPrecomputation);
+
+  if (context->pointPTable) {
+    fixedBase_destroy(*context->pointPTable);
+    free(context->pointPTable);
+  }
+
+  if (context->pointPpublicLines) {
+    tate_destroyLines(*context->pointPpublicLines);
+    free(context->pointPpublicLines);
+  }
+
+  if (context->identityCache) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(
+        context->identityCache);
+    free(context->identityCache);
+  }
+}
@@ -0,0 +1,25 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary.h"
+
+void bonehFranklinIdentityBasedEncryptionEncapsulationAsBinary_init(
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        *encapsulationAsBinaryOutput,
+    const AffinePointAsBinary cipherU, const void *const cipherV,
+    const size_t cipherVLength) {
+  affineAsBinary_init(&encapsulationAsBinaryOutput->cipherU, cipherU.x,
+                      cipherU.xLength, cipherU.y, cipherU.yLength);
+
+  encapsulationAsBinaryOutput->cipherV = malloc(cipherVLength);
+  memcpy(encapsulationAsBinaryOutput->cipherV, cipherV, cipherVLength);
+
+  encapsulationAsBinaryOutput->cipherVLength = cipherVLength;
+}
+
+void bonehFranklinIdentityBasedEncryptionEncapsulationAsBinary_destroy(
+    BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary
+        encapsulationAsBinary) {
+  affineAsBinary_destroy(encapsulationAsBinary.cipherU);
+  free(encapsulationAsBinary.cipherV);
+}
@@ -0,0 +1,254 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionIdentityCache.h"
+
+// 64-bit FNV-1a hash of the identity.
+static size_t bonehFranklinIdentityBasedEncryptionIdentityCache_hash(
+    const char *const identity, const size_t length) {
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= (unsigned char)identity[i];
+    hash *= 1099511628211ULL;
+  }
+  return (size_t)hash;
+}
+
+static BonehFranklinIdentityBasedEncryptionIdentityCacheEntry **
+bonehFranklinIdentityBasedEncryptionIdentityCache_bucket(
+    const BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength) {
+  const size_t hash = bonehFranklinIdentityBasedEncryptionIdentityCache_hash(
+      identity, identityLength);
+  return &cache->buckets[hash & (cache->bucketCount - 1)];
+}
+
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_lock(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&cache->lock);
+#else
+  (void)cache;
+#endif
+}
+
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_unlock(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_unlock(&cache->lock);
+#else
+  (void)cache;
+#endif
+}
+
+// Removes an entry from the recency list.
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_unlink(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry) {
+  if (entry->moreRecent) {
+    entry->moreRecent->lessRecent = entry->lessRecent;
+  } else {
+    cache->mostRecent = entry->lessRecent;
+  }
+
+  if (entry->lessRecent) {
+    entry->lessRecent->moreRecent = entry->moreRecent;
+  } else {
+    cache->leastRecent = entry->moreRecent;
+  }
+
+  entry->moreRecent = NULL;
+  entry->lessRecent = NULL;
+}
+
+// Inserts an entry at the front of the recency list.
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_pushFront(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry) {
+  entry->moreRecent = NULL;
+  entry->lessRecent = cache->mostRecent;
+
+  if (cache->mostRecent) {
+    cache->mostRecent->moreRecent = entry;
+  } else {
+    cache->leastRecent = entry;
+  }
+  cache->mostRecent = entry;
+}
+
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_evict(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache) {
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+      cache->leastRecent;
+
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry **link =
+      bonehFranklinIdentityBasedEncryptionIdentityCache_bucket(
+          cache, entry->identity, entry->identityLength);
+  while (*link != entry) {
+    link = &(*link)->nextInBucket;
+  }
+  *link = entry->nextInBucket;
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_unlink(cache, entry);
+
+  complex_destroy(entry->pairingValue);
+  free(entry->identity);
+  free(entry);
+  cache->size--;
+}
+
+// Allocates the buckets of an empty cache. If they cannot be allocated, the
+// capacity becomes zero, so the cache stores nothing.
+static void bonehFranklinIdentityBasedEncryptionIdentityCache_allocateBuckets(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    size_t capacity) {
+  const size_t maxCapacity =
+      BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_MAX_CAPACITY;
+  if (capacity > maxCapacity) {
+    capacity = maxCapacity;
+  }
+
+  // At least twice as many buckets as entries, to keep the chains short.
+  size_t bucketCount = 1;
+  while (bucketCount < 2 * capacity) {
+    bucketCount <<= 1;
+  }
+
+  cache->buckets =
+      (BonehFranklinIdentityBasedEncryptionIdentityCacheEntry **)calloc(
+          bucketCount,
+          sizeof(BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *));
+  if (!cache->buckets) {
+    capacity = 0;
+    bucketCount = 0;
+  }
+
+  cache->capacity = capacity;
+  cache->bucketCount = bucketCount;
+}
+
+void bonehFranklinIdentityBasedEncryptionIdentityCache_init(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cacheOutput,
+    const size_t capacity) {
+  cacheOutput->size = 0;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_allocateBuckets(
+      cacheOutput, capacity);
+
+  cacheOutput->mostRecent = NULL;
+  cacheOutput->leastRecent = NULL;
+
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_init(&cacheOutput->lock, NULL);
+#endif
+}
+
+void bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache) {
+  while (cache->size > 0) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_evict(cache);
+  }
+  free(cache->buckets);
+
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_destroy(&cache->lock);
+#endif
+}
+
+void bonehFranklinIdentityBasedEncryptionIdentityCache_reset(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const size_t capacity) {
+  bonehFranklinIdentityBasedEncryptionIdentityCache_lock(cache);
+
+  while (cache->size > 0) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_evict(cache);
+  }
+  free(cache->buckets);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_allocateBuckets(cache,
+                                                                    capacity);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_unlock(cache);
+}
+
+// Finds the entry of an identity and marks it as the most recently used one.
+// The lock must be held.
+static BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *
+bonehFranklinIdentityBasedEncryptionIdentityCache_find(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength) {
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+      *bonehFranklinIdentityBasedEncryptionIdentityCache_bucket(
+          cache, identity, identityLength);
+
+  while (entry) {
+    if (entry->identityLength == identityLength &&
+        !memcmp(entry->identity, identity, identityLength)) {
+      bonehFranklinIdentityBasedEncryptionIdentityCache_unlink(cache, entry);
+      bonehFranklinIdentityBasedEncryptionIdentityCache_pushFront(cache,
+                                                                  entry);
+      return entry;
+    }
+    entry = entry->nextInBucket;
+  }
+
+  return NULL;
+}
+
+int bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+    Complex *pairingValueOutput,
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength) {
+  bonehFranklinIdentityBasedEncryptionIdentityCache_lock(cache);
+
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+      cache->capacity == 0
+          ? NULL
+          : bonehFranklinIdentityBasedEncryptionIdentityCache_find(
+                cache, identity, identityLength);
+  if (entry) {
+    complex_initMpz(pairingValueOutput, entry->pairingValue.real,
+                    entry->pairingValue.imaginary);
+  }
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_unlock(cache);
+
+  return entry != NULL;
+}
+
+void bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+    BonehFranklinIdentityBasedEncryptionIdentityCache *cache,
+    const char *const identity, const size_t identityLength,
+    const Complex pairingValue) {
+  bonehFranklinIdentityBasedEncryptionIdentityCache_lock(cache);
+
+  // The pairing value of an identity never changes.
+  if (cache->capacity == 0 ||
+      bonehFranklinIdentityBasedEncryptionIdentityCache_find(cache, identity,
+                                                             identityLength)) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_unlock(cache);
+    return;
+  }
+
+  if (cache->size == cache->capacity) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_evict(cache);
+  }
+
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+      (BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *)malloc(
+          sizeof(BonehFranklinIdentityBasedEncryptionIdentityCacheEntry));
+  entry->identity = (char *)malloc(identityLength);
+  memcpy(entry->identity, identity, identityLength);
+  entry->identityLength = identityLength;
+  complex_initMpz(&entry->pairingValue, pairingValue.real,
+                  pairingValue.imaginary);
+
+  BonehFranklinIdentityBasedEncryptionIdentityCacheEntry **bucket =
+      bonehFranklinIdentityBasedEncryptionIdentityCache_bucket(
+          cache, identity, identityLength);
+  entry->nextInBucket = *bucket;
+  *bucket = entry;
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_pushFront(cache, entry);
+  cache->size++;
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_unlock(cache);
+}
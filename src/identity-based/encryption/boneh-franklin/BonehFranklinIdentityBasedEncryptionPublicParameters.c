@@ -3,6 +3,7 @@
 
 #include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionPublicParameters.h"
 #include "util/PrimalityTest.h"
+#include "util/ValidationCache.h"
 
 void bonehFranklinIdentityBasedEncryptionPublicParameters_init(
     BonehFranklinIdentityBasedEncryptionPublicParameters
@@ -26,16 +27,53 @@ void bonehFranklinIdentityBasedEncryptionPublicParameters_destroy(
   affine_destroy(publicParameters.pointPpublic);
 }
 
+static void bonehFranklinIdentityBasedEncryptionPublicParameters_fingerprint(
+    unsigned char *fingerprintOutput,
+    const BonehFranklinIdentityBasedEncryptionPublicParameters
+        publicParameters) {
+  HashFunctionContext context;
+  validationCache_fingerprintInit(
+      &context, "BonehFranklinIdentityBasedEncryptionPublicParameters");
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.ellipticCurve.a);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.ellipticCurve.b);
+  validationCache_fingerprintAddInteger(
+      &context, publicParameters.ellipticCurve.fieldOrder);
+  validationCache_fingerprintAddInteger(&context, publicParameters.q);
+  validationCache_fingerprintAddInteger(&context, publicParameters.pointP.x);
+  validationCache_fingerprintAddInteger(&context, publicParameters.pointP.y);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.pointPpublic.x);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.pointPpublic.y);
+  validationCache_fingerprintAddUnsigned(&context,
+                                         publicParameters.hashFunction);
+  validationCache_fingerprintFinal(fingerprintOutput, &context);
+}
+
 CryptidValidationResult
 bonehFranklinIdentityBasedEncryptionPublicParameters_isValid(
     const BonehFranklinIdentityBasedEncryptionPublicParameters
         publicParameters) {
+  // Parameters validated before are not validated again.
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  bonehFranklinIdentityBasedEncryptionPublicParameters_fingerprint(
+      fingerprint, publicParameters);
+
+  const unsigned long generation = validationCache_generation();
+  if (validationCache_contains(fingerprint)) {
+    return CRYPTID_VALIDATION_SUCCESS;
+  }
+
   if (ellipticCurve_isTypeOne(publicParameters.ellipticCurve) &&
-      primalityTest_isProbablePrime(publicParameters.q) &&
+      primalityTest_isProbablePrime(publicParameters.q,
+                                    primalityTest_VALIDATION) &&
       affine_isValid(publicParameters.pointP, publicParameters.ellipticCurve) &&
       affine_isValid(publicParameters.pointPpublic,
                      publicParameters.ellipticCurve) &&
       hashFunction_isValid(publicParameters.hashFunction)) {
+    validationCache_add(fingerprint, generation);
     return CRYPTID_VALIDATION_SUCCESS;
   }
 
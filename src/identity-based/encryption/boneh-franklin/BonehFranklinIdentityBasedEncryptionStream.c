@@ -0,0 +1,112 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionStream.h"
+
+// References
+//  * [RFC-5091] Xavier Boyen, Luther Martin. 2007. RFC 5091. Identity-Based
+//  Cryptography Standard (IBCS) #1: Supersingular Curve Implementations of the
+//  BF and BB1 Cryptosystems
+//  * [RFC-2104] Hugo Krawczyk, Mihir Bellare, Ran Canetti. 1997. RFC 2104.
+//  HMAC: Keyed-Hashing for Message Authentication
+
+// The number of octets encoding the payload length appended to the
+// authenticated ciphertext.
+static const size_t LENGTH_ENCODING_LENGTH = 8;
+
+// Produces the next block \f$r_i\f$ of Algorithm 4.2.1 (HashBytes) in
+// [RFC-5091].
+static void bonehFranklinIdentityBasedEncryptionStream_nextKeystreamBlock(
+    BonehFranklinIdentityBasedEncryptionStream *stream) {
+  // Let \f$h_i = \mathrm{hashfcn}(h_{i - 1})\f$.
+  hashFunction_hash(stream->keystreamState, stream->keystreamState,
+                    stream->hashLength, stream->hashFunction);
+
+  // Let \f$r_i = \mathrm{hashfcn}(h_i || k)\f$.
+  hashFunction_hash(stream->keystreamBlock, stream->keystreamState,
+                    2 * stream->hashLength, stream->hashFunction);
+
+  stream->keystreamOffset = 0;
+}
+
+void bonehFranklinIdentityBasedEncryptionStream_init(
+    BonehFranklinIdentityBasedEncryptionStream *streamOutput,
+    const unsigned char *const keyMaterial, const HashFunction hashFunction) {
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+
+  streamOutput->hashFunction = hashFunction;
+  streamOutput->hashLength = hashLength;
+
+  // Let \f$h_0 = 00...00\f$ and \f$k = \mathrm{hashfcn}(p)\f$, where \f$p\f$
+  // is the keystream seed.
+  streamOutput->keystreamState =
+      (unsigned char *)calloc(2 * hashLength, sizeof(unsigned char));
+  hashFunction_hash(streamOutput->keystreamState + hashLength, keyMaterial,
+                    hashLength, hashFunction);
+
+  streamOutput->keystreamBlock =
+      (unsigned char *)calloc(hashLength, sizeof(unsigned char));
+  streamOutput->keystreamOffset = hashLength;
+
+  // The ciphertext is authenticated with \f$\mathrm{HMAC}(K_{mac}, \cdot)\f$
+  // of [RFC-2104] over hashfcn.
+  hmac_initKey(&streamOutput->macKey, keyMaterial + hashLength, hashLength,
+               hashFunction);
+  hmac_init(&streamOutput->macContext, &streamOutput->macKey);
+
+  streamOutput->processedLength = 0;
+}
+
+void bonehFranklinIdentityBasedEncryptionStream_destroy(
+    BonehFranklinIdentityBasedEncryptionStream *stream) {
+  // The key material must not outlive the stream.
+  memset(stream->keystreamState, 0, 2 * stream->hashLength);
+  memset(stream->keystreamBlock, 0, stream->hashLength);
+  hmac_destroyKey(&stream->macKey);
+  memset(&stream->macContext, 0, sizeof(stream->macContext));
+
+  free(stream->keystreamState);
+  free(stream->keystreamBlock);
+}
+
+void bonehFranklinIdentityBasedEncryptionStream_update(
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length,
+    const int isEncryption) {
+  if (!isEncryption) {
+    hashFunction_update(&stream->macContext, input, length);
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    if (stream->keystreamOffset == stream->hashLength) {
+      bonehFranklinIdentityBasedEncryptionStream_nextKeystreamBlock(stream);
+    }
+
+    output[i] = input[i] ^ stream->keystreamBlock[stream->keystreamOffset++];
+  }
+
+  if (isEncryption) {
+    hashFunction_update(&stream->macContext, output, length);
+  }
+
+  stream->processedLength += length;
+}
+
+void bonehFranklinIdentityBasedEncryptionStream_tag(
+    unsigned char *tagOutput,
+    BonehFranklinIdentityBasedEncryptionStream *stream) {
+  // Let \f$T = \mathrm{HMAC}(K_{mac}, C || |C|)\f$, where \f$|C|\f$ is the
+  // total length of the ciphertext in big-endian convention.
+  // The HMAC computation is copied, so more ciphertext may follow.
+  HashFunctionContext context = stream->macContext;
+
+  unsigned char encodedLength[LENGTH_ENCODING_LENGTH];
+  for (size_t i = 0; i < LENGTH_ENCODING_LENGTH; i++) {
+    encodedLength[i] = (unsigned char)(stream->processedLength >>
+                                       (8 * (LENGTH_ENCODING_LENGTH - 1 - i)));
+  }
+  hashFunction_update(&context, encodedLength, LENGTH_ENCODING_LENGTH);
+
+  hmac_final(tagOutput, &context, &stream->macKey);
+}
@@ -1,9 +1,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "complex/Cyclotomic.h"
 #include "elliptic/TatePairing.h"
 #include "identity-based/signature/hess/HessIdentityBasedSignature.h"
-#include "util/PrimalityTest.h"
 #include "util/RandBytes.h"
 #include "util/Random.h"
 #include "util/Utils.h"
@@ -57,12 +57,12 @@ CryptidStatus cryptid_ibs_hess_setup(
                            Q_LENGTH_MAPPING[(int)securityLevel] - 3;
   mpz_t r, p;
   mpz_inits(r, p, NULL);
-  do {
-    random_mpzOfLength(r, lengthOfR);
-    mpz_mul_ui(p, r, 12);
-    mpz_mul(p, p, q);
-    mpz_sub_ui(p, p, 1);
-  } while (!primalityTest_isProbablePrime(p));
+  status = random_pairingPrime(p, r, q, lengthOfR);
+
+  if (status) {
+    mpz_clears(p, q, r, NULL);
+    return status;
+  }
 
   mpz_t zero, one;
   mpz_init_set_ui(zero, 0);
@@ -109,10 +109,18 @@ CryptidStatus cryptid_ibs_hess_setup(
   mpz_init_set(qMinusTwo, q);
   mpz_sub_ui(qMinusTwo, qMinusTwo, 2);
 
-  random_mpzInRange(s, qMinusTwo);
-  mpz_add_ui(s, s, 2);
+  status = random_mpzInRange(s, qMinusTwo);
   mpz_clear(qMinusTwo);
 
+  if (status) {
+    mpz_clears(p, q, r, s, NULL);
+    affine_destroy(pointP);
+    ellipticCurve_destroy(ec);
+    return status;
+  }
+
+  mpz_add_ui(s, s, 2);
+
   // Determine the public parameters
   AffinePoint pointPpublic;
 
@@ -243,7 +251,12 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
   mpz_t k;
   mpz_init(k);
   // Let (@code k) be a random number in range of (@code publicParameters.q).
-  random_mpzInRange(k, publicParameters.q);
+  CryptidStatus status = random_mpzInRange(k, publicParameters.q);
+  if (status) {
+    hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
+    mpz_clear(k);
+    return status;
+  }
 
   // Let {@code hashlen} be the length of the output of the cryptographic hash
   // function hashfcn from the public parameters.
@@ -253,7 +266,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
   // \f$Q_{id} = \mathrm{HashToPoint}(E, p, q, id, \mathrm{hashfcn})\f$
   // which results in a point of order \f$q\f$ in \f$E(F_p)\f$.
   AffinePoint pointQId;
-  CryptidStatus status = hashToPoint(
+  status = hashToPoint(
       &pointQId, identity, identityLength, publicParameters.q,
       publicParameters.ellipticCurve, publicParameters.hashFunction);
   if (status) {
@@ -279,7 +292,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
   // Let \f$\mathrm{r} = \mathrm{theta}^k\f$, which is theta raised to the power
   // of \f$k\f$ in \f$F_p^2\f$.
   Complex r;
-  complex_modPow(&r, theta, k, publicParameters.ellipticCurve.fieldOrder);
+  cyclotomic_pow(&r, theta, k, publicParameters.ellipticCurve.fieldOrder);
 
   // Let \f$z = \mathrm{Canonical}(p, k, 0, \mathrm{r})\f$, a canonical string
   // representation of {@code r}.
@@ -287,31 +300,25 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
   unsigned char *z;
   canonical(&z, &zLength, r, publicParameters.ellipticCurve.fieldOrder, 1);
 
+  // The concatenation \f$w || t\f$, both parts of which are produced in
+  // place.
+  unsigned char *wT =
+      (unsigned char *)calloc(2 * hashLen, sizeof(unsigned char));
+
   // Let \f$w = \mathrm{hashfcn}(z)\f$ using the {@code hashfcn} hashing
   // algorithm, the result of which is a {@code hashlen}-octet string.
-  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
+  hashFunction_hash(wT, z, zLength, publicParameters.hashFunction);
 
   // Let \f$t = \mathrm{hashfcn}(message)\f$ using the \f$hashfcn\f$ algorithm.
-  unsigned char *t = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(t, (unsigned char *)message, messageLength,
+  hashFunction_hash(wT + hashLen, (unsigned char *)message, messageLength,
                     publicParameters.hashFunction);
 
   // Let \f$v = \mathrm{HashToRange}(w || t, q, \mathrm{hashfcn}) using
   // HashToRange on the \f$(2 \cdot \mathrm{hashlen})\f$-octet concatenation of
   // {@code w} and \f$t\f$.
-  unsigned char *concat =
-      (unsigned char *)calloc(2 * hashLen, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    concat[i] = w[i];
-  }
-  for (int i = 0; i < hashLen; i++) {
-    concat[hashLen + i] = t[i];
-  }
-
   mpz_t v;
   mpz_init(v);
-  hashToRange(v, concat, 2 * hashLen, publicParameters.q,
+  hashToRange(v, wT, 2 * hashLen, publicParameters.q,
               publicParameters.hashFunction);
 
   // Let \f$u = v \cdot \mathrm{privateKey} + k \cdot Q_{id}\f$ be a point on
@@ -329,9 +336,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
     affine_destroy(pointQId);
     complex_destroyMany(2, theta, r);
     free(z);
-    free(w);
-    free(t);
-    free(concat);
+    free(wT);
     return status;
   }
   status = affine_wNAFMultiply(&kMulPointQId, pointQId, k,
@@ -344,9 +349,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
     affine_destroy(vMulPrivateKey);
     complex_destroyMany(2, theta, r);
     free(z);
-    free(w);
-    free(t);
-    free(concat);
+    free(wT);
     return status;
   }
   status = affine_add(&u, vMulPrivateKey, kMulPointQId,
@@ -360,9 +363,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
     affine_destroy(kMulPointQId);
     complex_destroyMany(2, theta, r);
     free(z);
-    free(w);
-    free(t);
-    free(concat);
+    free(wT);
     return status;
   }
 
@@ -382,9 +383,7 @@ cryptid_ibs_hess_sign(HessIdentityBasedSignatureSignatureAsBinary *result,
   affine_destroy(u);
   complex_destroyMany(2, theta, r);
   free(z);
-  free(w);
-  free(t);
-  free(concat);
+  free(wT);
 
   return CRYPTID_SUCCESS;
 }
@@ -444,18 +443,6 @@ CryptidStatus cryptid_ibs_hess_verify(
   int hashLen;
   hashFunction_getHashSize(&hashLen, publicParameters.hashFunction);
 
-  // Let \f$theta1 = \mathrm{Pairing}(E, p ,q, u, P_{pub})\f$ by applying the
-  // modified Tate pairing.
-  Complex theta1;
-  status =
-      tate_performPairing(&theta1, signature.u, publicParameters.pointP, 2,
-                          publicParameters.q, publicParameters.ellipticCurve);
-  if (status) {
-    hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
-    hessIdentityBasedSignatureSignature_destroy(signature);
-    return status;
-  }
-
   // \f$Q_{id} = \mathrm{HashToPoint}(E, p, q, id, \mathrm{hashfcn})\f$
   // which results in a point of order \f$q\f$ in \f$E(F_p)\f$.
   AffinePoint pointQId;
@@ -465,7 +452,6 @@ CryptidStatus cryptid_ibs_hess_verify(
   if (status) {
     hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
     hessIdentityBasedSignatureSignature_destroy(signature);
-    complex_destroy(theta1);
     return status;
   }
 
@@ -479,32 +465,41 @@ CryptidStatus cryptid_ibs_hess_verify(
   affine_init(&negativePointPpublic, publicParameters.pointPpublic.x,
               yNegateModP);
 
-  // Let \f$theta2 = \mathrm{Pairing}(E, p , q, Q_{id}, \f$-P_{pub}\f$)\f$ by
-  // applying the modified Tate pairing.
-  Complex theta2;
-  status =
-      tate_performPairing(&theta2, pointQId, negativePointPpublic, 2,
-                          publicParameters.q, publicParameters.ellipticCurve);
+  // By bilinearity \f$\mathrm{Pairing}(Q_{id}, -P_{pub})^v =
+  // \mathrm{Pairing}(Q_{id}, [v](-P_{pub}))\f$, so the exponentiation is
+  // replaced by a point multiplication.
+  AffinePoint vMulNegativePointPpublic;
+  status = affine_wNAFMultiply(&vMulNegativePointPpublic, negativePointPpublic,
+                               signature.v, publicParameters.ellipticCurve);
   if (status) {
     hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
     hessIdentityBasedSignatureSignature_destroy(signature);
-    complex_destroy(theta1);
     affine_destroy(pointQId);
     affine_destroy(negativePointPpublic);
     mpz_clears(yNegate, yNegateModP, NULL);
     return status;
   }
 
-  // Let \f$\mathrm{theta2}^{\prime} = \mathrm{theta2}^v\f$, which is theta
-  // raised to the power of \f$v\f$ in \f$F_p^2\f$.
-  Complex theta2Prime;
-  complex_modPow(&theta2Prime, theta2, signature.v,
-                 publicParameters.ellipticCurve.fieldOrder);
-
-  // Let \f$ r = \mathrm{theta1} \cdot \mathrm{theta2}^{\prime} \f$
+  // Let \f$ r = \mathrm{theta1} \cdot \mathrm{theta2}^v \f$, where
+  // \f$theta1 = \mathrm{Pairing}(E, p, q, u, P)\f$ and
+  // \f$theta2 = \mathrm{Pairing}(E, p, q, Q_{id}, -P_{pub})\f$. The two
+  // modified Tate pairings are evaluated as a single product of pairings.
+  const AffinePoint pairingPs[] = {signature.u, pointQId};
+  const AffinePoint pairingBs[] = {publicParameters.pointP,
+                                   vMulNegativePointPpublic};
   Complex r;
-  complex_modMul(&r, theta1, theta2Prime,
-                 publicParameters.ellipticCurve.fieldOrder);
+  status = tate_performMultiPairing(&r, pairingPs, pairingBs, 2, 2,
+                                    publicParameters.q,
+                                    publicParameters.ellipticCurve);
+  if (status) {
+    hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
+    hessIdentityBasedSignatureSignature_destroy(signature);
+    affine_destroy(pointQId);
+    affine_destroy(negativePointPpublic);
+    affine_destroy(vMulNegativePointPpublic);
+    mpz_clears(yNegate, yNegateModP, NULL);
+    return status;
+  }
 
   // Verify that the signature (@code v) equals with the now computed value.
   // The code is the same as in the sign method.
@@ -512,54 +507,41 @@ CryptidStatus cryptid_ibs_hess_verify(
   unsigned char *z;
   canonical(&z, &zLength, r, publicParameters.ellipticCurve.fieldOrder, 1);
 
-  unsigned char *w = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(w, z, zLength, publicParameters.hashFunction);
-
-  unsigned char *t = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  hashFunction_hash(t, (unsigned char *)message, messageLength,
+  unsigned char *wT =
+      (unsigned char *)calloc(2 * hashLen, sizeof(unsigned char));
+  hashFunction_hash(wT, z, zLength, publicParameters.hashFunction);
+  hashFunction_hash(wT + hashLen, (unsigned char *)message, messageLength,
                     publicParameters.hashFunction);
 
-  unsigned char *concat =
-      (unsigned char *)calloc(2 * hashLen + 1, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    concat[i] = w[i];
-  }
-  for (int i = 0; i < hashLen; i++) {
-    concat[hashLen + i] = t[i];
-  }
-  concat[2 * hashLen] = '\0';
-
   mpz_t v;
   mpz_init(v);
-  hashToRange(v, concat, 2 * hashLen, publicParameters.q,
+  hashToRange(v, wT, 2 * hashLen, publicParameters.q,
               publicParameters.hashFunction);
 
   // If the values were the same, the verification returns succes.
   if (mpz_cmp(signature.v, v) == 0) {
     hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
     hessIdentityBasedSignatureSignature_destroy(signature);
-    complex_destroyMany(4, theta1, theta2, theta2Prime, r);
+    complex_destroy(r);
     affine_destroy(pointQId);
     affine_destroy(negativePointPpublic);
+    affine_destroy(vMulNegativePointPpublic);
     mpz_clears(yNegate, yNegateModP, v, NULL);
     free(z);
-    free(w);
-    free(t);
-    free(concat);
+    free(wT);
     return CRYPTID_SUCCESS;
   }
 
   // Otherwise, failure.
   hessIdentityBasedSignaturePublicParameters_destroy(publicParameters);
   hessIdentityBasedSignatureSignature_destroy(signature);
-  complex_destroyMany(4, theta1, theta2, theta2Prime, r);
+  complex_destroy(r);
   affine_destroy(pointQId);
   affine_destroy(negativePointPpublic);
+  affine_destroy(vMulNegativePointPpublic);
   mpz_clears(yNegate, yNegateModP, v, NULL);
   free(z);
-  free(w);
-  free(t);
-  free(concat);
+  free(wT);
 
   return CRYPTID_VERIFICATION_FAILED_ERROR;
 }
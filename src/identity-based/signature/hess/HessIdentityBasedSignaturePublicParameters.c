@@ -1,5 +1,6 @@
 #include "identity-based/signature/hess/HessIdentityBasedSignaturePublicParameters.h"
 #include "util/PrimalityTest.h"
+#include "util/ValidationCache.h"
 
 void hessIdentityBasedSignaturePublicParameters_init(
     HessIdentityBasedSignaturePublicParameters *publicParametersOutput,
@@ -22,14 +23,50 @@ void hessIdentityBasedSignaturePublicParameters_destroy(
   affine_destroy(publicParameters.pointPpublic);
 }
 
+static void hessIdentityBasedSignaturePublicParameters_fingerprint(
+    unsigned char *fingerprintOutput,
+    const HessIdentityBasedSignaturePublicParameters publicParameters) {
+  HashFunctionContext context;
+  validationCache_fingerprintInit(&context,
+                                  "HessIdentityBasedSignaturePublicParameters");
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.ellipticCurve.a);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.ellipticCurve.b);
+  validationCache_fingerprintAddInteger(
+      &context, publicParameters.ellipticCurve.fieldOrder);
+  validationCache_fingerprintAddInteger(&context, publicParameters.q);
+  validationCache_fingerprintAddInteger(&context, publicParameters.pointP.x);
+  validationCache_fingerprintAddInteger(&context, publicParameters.pointP.y);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.pointPpublic.x);
+  validationCache_fingerprintAddInteger(&context,
+                                        publicParameters.pointPpublic.y);
+  validationCache_fingerprintAddUnsigned(&context,
+                                         publicParameters.hashFunction);
+  validationCache_fingerprintFinal(fingerprintOutput, &context);
+}
+
 CryptidValidationResult hessIdentityBasedSignaturePublicParameters_isValid(
     const HessIdentityBasedSignaturePublicParameters publicParameters) {
+  // Parameters validated before are not validated again.
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  hessIdentityBasedSignaturePublicParameters_fingerprint(fingerprint,
+                                                         publicParameters);
+
+  const unsigned long generation = validationCache_generation();
+  if (validationCache_contains(fingerprint)) {
+    return CRYPTID_VALIDATION_SUCCESS;
+  }
+
   if (ellipticCurve_isTypeOne(publicParameters.ellipticCurve) &&
-      primalityTest_isProbablePrime(publicParameters.q) &&
+      primalityTest_isProbablePrime(publicParameters.q,
+                                    primalityTest_VALIDATION) &&
       affine_isValid(publicParameters.pointP, publicParameters.ellipticCurve) &&
       affine_isValid(publicParameters.pointPpublic,
                      publicParameters.ellipticCurve) &&
       hashFunction_isValid(publicParameters.hashFunction)) {
+    validationCache_add(fingerprint, generation);
     return CRYPTID_VALIDATION_SUCCESS;
   }
 
@@ -1,4 +1,4 @@
-#include "sha.h"
+#include <limits.h>
 
 #include "util/HashFunction.h"
 
@@ -35,21 +35,137 @@ CryptidStatus hashFunction_hash(unsigned char *hashResult,
     return CRYPTID_HASH_NULLPOINTER_OUTPUT_PARAM_ERROR;
   }
 
+  HashFunctionContext context;
+  CryptidStatus status = hashFunction_initContext(&context, hashFunction);
+  if (status) {
+    return status;
+  }
+
+  hashFunction_update(&context, message, messageLength);
+
+  return hashFunction_final(hashResult, &context);
+}
+
+CryptidStatus hashFunction_hashMany(unsigned char *const *hashResults,
+                                    const unsigned char *const *messages,
+                                    const size_t *messageLengths,
+                                    const size_t messageCount,
+                                    const HashFunction hashFunction) {
+  if (messageCount > 0 && hashResults == NULL) {
+    return CRYPTID_HASH_NULLPOINTER_OUTPUT_PARAM_ERROR;
+  }
+
   switch (hashFunction) {
+  case hashFunction_SHA224:
+    SHA224_256_MultiCall(SHA224, messages, messageLengths, messageCount,
+                         hashResults);
+    return CRYPTID_SUCCESS;
+  case hashFunction_SHA256:
+    SHA224_256_MultiCall(SHA256, messages, messageLengths, messageCount,
+                         hashResults);
+    return CRYPTID_SUCCESS;
+  default:
+    break;
+  }
+
+  for (size_t i = 0; i < messageCount; i++) {
+    CryptidStatus status = hashFunction_hash(hashResults[i], messages[i],
+                                             messageLengths[i], hashFunction);
+    if (status) {
+      return status;
+    }
+  }
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus hashFunction_initContext(HashFunctionContext *contextOutput,
+                                       const HashFunction hashFunction) {
+  contextOutput->hashFunction = hashFunction;
+
+  switch (hashFunction) {
+  case hashFunction_SHA1:
+    SHA1Reset(&contextOutput->state.ctx.sha1Context);
+    break;
+  case hashFunction_SHA224:
+    SHA224Reset(&contextOutput->state.ctx.sha224Context);
+    break;
+  case hashFunction_SHA256:
+    SHA256Reset(&contextOutput->state.ctx.sha256Context);
+    break;
+  case hashFunction_SHA384:
+    SHA384Reset(&contextOutput->state.ctx.sha384Context);
+    break;
+  case hashFunction_SHA512:
+    SHA512Reset(&contextOutput->state.ctx.sha512Context);
+    break;
+  default:
+    return CRPYTID_UNKNOWN_HASH_TYPE_ERROR;
+  }
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus hashFunction_update(HashFunctionContext *context,
+                                  const unsigned char *const message,
+                                  const size_t messageLength) {
+  const unsigned char *piece = message;
+  size_t remaining = messageLength;
+
+  // The underlying implementation takes the length as an unsigned int, so
+  // longer messages are fed in several pieces.
+  do {
+    const unsigned int pieceLength =
+        remaining > UINT_MAX ? UINT_MAX : (unsigned int)remaining;
+
+    switch (context->hashFunction) {
+    case hashFunction_SHA1:
+      SHA1Input(&context->state.ctx.sha1Context, piece, pieceLength);
+      break;
+    case hashFunction_SHA224:
+      SHA224Input(&context->state.ctx.sha224Context, piece, pieceLength);
+      break;
+    case hashFunction_SHA256:
+      SHA256Input(&context->state.ctx.sha256Context, piece, pieceLength);
+      break;
+    case hashFunction_SHA384:
+      SHA384Input(&context->state.ctx.sha384Context, piece, pieceLength);
+      break;
+    case hashFunction_SHA512:
+      SHA512Input(&context->state.ctx.sha512Context, piece, pieceLength);
+      break;
+    default:
+      return CRPYTID_UNKNOWN_HASH_TYPE_ERROR;
+    }
+
+    piece += pieceLength;
+    remaining -= pieceLength;
+  } while (remaining > 0);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus hashFunction_final(unsigned char *hashResult,
+                                 HashFunctionContext *context) {
+  if (hashResult == NULL) {
+    return CRYPTID_HASH_NULLPOINTER_OUTPUT_PARAM_ERROR;
+  }
+
+  switch (context->hashFunction) {
   case hashFunction_SHA1:
-    SHA1_OneCall(message, messageLength, hashResult);
+    SHA1Result(&context->state.ctx.sha1Context, hashResult);
     break;
   case hashFunction_SHA224:
-    SHA224_OneCall(message, messageLength, hashResult);
+    SHA224Result(&context->state.ctx.sha224Context, hashResult);
     break;
   case hashFunction_SHA256:
-    SHA256_OneCall(message, messageLength, hashResult);
+    SHA256Result(&context->state.ctx.sha256Context, hashResult);
     break;
   case hashFunction_SHA384:
-    SHA384_OneCall(message, messageLength, hashResult);
+    SHA384Result(&context->state.ctx.sha384Context, hashResult);
     break;
   case hashFunction_SHA512:
-    SHA512_OneCall(message, messageLength, hashResult);
+    SHA512Result(&context->state.ctx.sha512Context, hashResult);
     break;
   default:
     return CRPYTID_UNKNOWN_HASH_TYPE_ERROR;
@@ -0,0 +1,92 @@
+#include <string.h>
+
+#include "util/Hmac.h"
+
+// References
+//  * [RFC-2104] Hugo Krawczyk, Mihir Bellare, Ran Canetti. 1997. RFC 2104.
+//  HMAC: Keyed-Hashing for Message Authentication
+
+// The largest block size of the supported hash functions, that of SHA-384 and
+// SHA-512.
+#define HMAC_MAX_BLOCK_SIZE 128
+
+static int hmac_blockSize(const HashFunction hashFunction) {
+  return hashFunction == hashFunction_SHA384 ||
+                 hashFunction == hashFunction_SHA512
+             ? 128
+             : 64;
+}
+
+// Starts a hash computation with the key, padded to a block, XORed with pad.
+static void hmac_initPad(HashFunctionContext *contextOutput,
+                         const unsigned char *const key,
+                         const size_t keyLength, const int blockSize,
+                         const unsigned char padOctet,
+                         const HashFunction hashFunction) {
+  unsigned char pad[HMAC_MAX_BLOCK_SIZE];
+
+  for (int i = 0; i < blockSize; i++) {
+    pad[i] = ((size_t)i < keyLength ? key[i] : 0) ^ padOctet;
+  }
+  hashFunction_initContext(contextOutput, hashFunction);
+  hashFunction_update(contextOutput, pad, blockSize);
+
+  memset(pad, 0, sizeof(pad));
+}
+
+void hmac_initKey(HmacKey *keyOutput, const unsigned char *const key,
+                  const size_t keyLength, const HashFunction hashFunction) {
+  // Implementation of HMAC in [RFC-2104] Section 2.
+  const int blockSize = hmac_blockSize(hashFunction);
+  unsigned char hashedKey[HASHFUNCTION_MAX_HASH_SIZE];
+  const unsigned char *paddedKey = key;
+  size_t paddedKeyLength = keyLength;
+
+  hashFunction_getHashSize(&keyOutput->hashLength, hashFunction);
+
+  // Keys longer than a block are replaced by their hash.
+  if (keyLength > (size_t)blockSize) {
+    hashFunction_hash(hashedKey, key, keyLength, hashFunction);
+    paddedKey = hashedKey;
+    paddedKeyLength = keyOutput->hashLength;
+  }
+
+  hmac_initPad(&keyOutput->inner, paddedKey, paddedKeyLength, blockSize, 0x36,
+               hashFunction);
+  hmac_initPad(&keyOutput->outer, paddedKey, paddedKeyLength, blockSize, 0x5c,
+               hashFunction);
+
+  memset(hashedKey, 0, sizeof(hashedKey));
+}
+
+void hmac_destroyKey(HmacKey *key) { memset(key, 0, sizeof(HmacKey)); }
+
+void hmac_init(HashFunctionContext *contextOutput, const HmacKey *const key) {
+  *contextOutput = key->inner;
+}
+
+void hmac_final(unsigned char *result, HashFunctionContext *context,
+                const HmacKey *const key) {
+  unsigned char innerHash[HASHFUNCTION_MAX_HASH_SIZE];
+
+  hashFunction_final(innerHash, context);
+
+  *context = key->outer;
+  hashFunction_update(context, innerHash, key->hashLength);
+  hashFunction_final(result, context);
+
+  memset(innerHash, 0, sizeof(innerHash));
+  memset(context, 0, sizeof(HashFunctionContext));
+}
+
+void hmac_hash(unsigned char *result, const HmacKey *const key,
+               const unsigned char *const *pieces, const size_t *pieceLengths,
+               const int pieceCount) {
+  HashFunctionContext context;
+
+  hmac_init(&context, key);
+  for (int i = 0; i < pieceCount; i++) {
+    hashFunction_update(&context, pieces[i], pieceLengths[i]);
+  }
+  hmac_final(result, &context, key);
+}
@@ -0,0 +1,133 @@
+#include <string.h>
+
+#include "util/Hmac.h"
+#include "util/HmacDrbg.h"
+
+// References
+//  * [SP-800-90A] Elaine Barker, John Kelsey. 2015. NIST SP 800-90A Rev. 1.
+//  Recommendation for Random Number Generation Using Deterministic Random Bit
+//  Generators
+
+// The largest number of pieces of provided data, see hmacDrbg_update.
+#define HMACDRBG_MAX_PIECES 3
+
+static void hmacDrbg_update(HmacDrbg *drbg, const unsigned char *const *data,
+                            const size_t *dataLengths, const int dataCount) {
+  // Implementation of HMAC_DRBG_Update in [SP-800-90A] Section 10.1.2.2. The
+  // provided data is the concatenation of the pieces of data.
+  const unsigned char *pieces[HMACDRBG_MAX_PIECES + 2];
+  size_t pieceLengths[HMACDRBG_MAX_PIECES + 2];
+  size_t providedDataLength = 0;
+  unsigned char separator;
+  HmacKey hmacKey;
+
+  pieces[0] = drbg->value;
+  pieceLengths[0] = HMACDRBG_OUTPUT_SIZE;
+  pieces[1] = &separator;
+  pieceLengths[1] = 1;
+  for (int i = 0; i < dataCount; i++) {
+    pieces[i + 2] = data[i];
+    pieceLengths[i + 2] = dataLengths[i];
+    providedDataLength += dataLengths[i];
+  }
+
+  // {@code Key = HMAC(Key, V || 0x00 || provided_data)}, {@code V = HMAC(Key,
+  // V)}, and, if there is provided data, once more with 0x01.
+  for (separator = 0x00; separator <= 0x01; separator++) {
+    hmac_initKey(&hmacKey, drbg->key, HMACDRBG_OUTPUT_SIZE,
+                 hashFunction_SHA256);
+    hmac_hash(drbg->key, &hmacKey, pieces, pieceLengths, dataCount + 2);
+
+    hmac_initKey(&hmacKey, drbg->key, HMACDRBG_OUTPUT_SIZE,
+                 hashFunction_SHA256);
+    hmac_hash(drbg->value, &hmacKey, pieces, pieceLengths, 1);
+
+    if (providedDataLength == 0) {
+      break;
+    }
+  }
+
+  hmac_destroyKey(&hmacKey);
+}
+
+void hmacDrbg_instantiate(HmacDrbg *drbgOutput,
+                          const unsigned char *const entropy,
+                          const size_t entropyLength,
+                          const unsigned char *const nonce,
+                          const size_t nonceLength,
+                          const unsigned char *const personalization,
+                          const size_t personalizationLength) {
+  // Implementation of HMAC_DRBG_Instantiate_algorithm in [SP-800-90A] Section
+  // 10.1.2.3.
+  const unsigned char *const data[] = {entropy, nonce, personalization};
+  const size_t dataLengths[] = {entropyLength, nonceLength,
+                                personalizationLength};
+
+  memset(drbgOutput->key, 0x00, HMACDRBG_OUTPUT_SIZE);
+  memset(drbgOutput->value, 0x01, HMACDRBG_OUTPUT_SIZE);
+
+  hmacDrbg_update(drbgOutput, data, dataLengths, 3);
+
+  drbgOutput->reseedCounter = 1;
+}
+
+void hmacDrbg_reseed(HmacDrbg *drbg, const unsigned char *const entropy,
+                     const size_t entropyLength,
+                     const unsigned char *const additionalInput,
+                     const size_t additionalInputLength) {
+  // Implementation of HMAC_DRBG_Reseed_algorithm in [SP-800-90A] Section
+  // 10.1.2.4.
+  const unsigned char *const data[] = {entropy, additionalInput};
+  const size_t dataLengths[] = {entropyLength, additionalInputLength};
+
+  hmacDrbg_update(drbg, data, dataLengths, 2);
+
+  drbg->reseedCounter = 1;
+}
+
+CryptidStatus hmacDrbg_generate(HmacDrbg *drbg, unsigned char *output,
+                                const size_t outputLength,
+                                const unsigned char *const additionalInput,
+                                const size_t additionalInputLength) {
+  // Implementation of HMAC_DRBG_Generate_algorithm in [SP-800-90A] Section
+  // 10.1.2.5.
+  if (outputLength > HMACDRBG_MAX_REQUEST_SIZE ||
+      drbg->reseedCounter > HMACDRBG_RESEED_INTERVAL) {
+    return CRYPTID_RANDOM_GENERATION_ERROR;
+  }
+
+  const unsigned char *const data[] = {additionalInput};
+  const size_t dataLengths[] = {additionalInputLength};
+
+  if (additionalInputLength > 0) {
+    hmacDrbg_update(drbg, data, dataLengths, 1);
+  }
+
+  // {@code V = HMAC(Key, V)} for every block of the output, the key being the
+  // same for all of them.
+  const unsigned char *const value[] = {drbg->value};
+  const size_t valueLength[] = {HMACDRBG_OUTPUT_SIZE};
+  HmacKey hmacKey;
+  hmac_initKey(&hmacKey, drbg->key, HMACDRBG_OUTPUT_SIZE, hashFunction_SHA256);
+
+  size_t generated = 0;
+  while (generated < outputLength) {
+    hmac_hash(drbg->value, &hmacKey, value, valueLength, 1);
+
+    const size_t blockLength = outputLength - generated < HMACDRBG_OUTPUT_SIZE
+                                   ? outputLength - generated
+                                   : HMACDRBG_OUTPUT_SIZE;
+    memcpy(output + generated, drbg->value, blockLength);
+    generated += blockLength;
+  }
+
+  hmac_destroyKey(&hmacKey);
+
+  hmacDrbg_update(drbg, data, dataLengths, 1);
+
+  drbg->reseedCounter++;
+
+  return CRYPTID_SUCCESS;
+}
+
+void hmacDrbg_destroy(HmacDrbg *drbg) { memset(drbg, 0, sizeof(HmacDrbg)); }
@@ -0,0 +1,250 @@
+#include <limits.h>
+#include <stdlib.h>
+
+#include "util/MontgomeryField.h"
+
+static const size_t LIMB_BITS = sizeof(mp_limb_t) * CHAR_BIT;
+
+// Copies the limbs of a nonnegative integer of at most limbCount limbs,
+// padding with zeros.
+static void montgomeryField_copyMpz(mp_limb_t *result, const mpz_t value,
+                                    const mp_size_t limbCount) {
+  const mp_size_t size = (mp_size_t)mpz_size(value);
+  if (size > 0) {
+    mpn_copyi(result, mpz_limbs_read(value), size);
+  }
+  if (size < limbCount) {
+    mpn_zero(result + size, limbCount - size);
+  }
+}
+
+// Montgomery reduction of the 2 * limbCount limbs of t, which must be less than
+// \f$pR\f$: stores \f$\frac{t}{R} \mod p\f$ into result.
+static inline void montgomeryField_reduce(mp_limb_t *result, mp_limb_t *t,
+                                          const mp_size_t limbCount,
+                                          const MontgomeryField *field) {
+  mp_limb_t carry = 0;
+
+  // Every step clears the lowest limb of \f$t\f$ by adding a multiple of
+  // \f$p\f$, so \f$t + mp\f$ is divisible by \f$R\f$ at the end.
+  for (mp_size_t i = 0; i < limbCount; i++) {
+    const mp_limb_t m = t[i] * field->modulusInverse;
+    const mp_limb_t c = mpn_addmul_1(t + i, field->modulus, limbCount, m);
+    carry += mpn_add_1(t + i + limbCount, t + i + limbCount, limbCount - i, c);
+  }
+
+  // \f$\frac{t + mp}{R} < 2p\f$
+  if (carry || mpn_cmp(t + limbCount, field->modulus, limbCount) >= 0) {
+    mpn_sub_n(result, t + limbCount, field->modulus, limbCount);
+  } else {
+    mpn_copyi(result, t + limbCount, limbCount);
+  }
+}
+
+static void montgomeryField_mulGeneric(mp_limb_t *product,
+                                       const mp_limb_t *multiplier,
+                                       const mp_limb_t *multiplicand,
+                                       MontgomeryField *field) {
+  mpn_mul_n(field->product, multiplier, multiplicand, field->limbCount);
+  montgomeryField_reduce(product, field->product, field->limbCount, field);
+}
+
+static void montgomeryField_sqrGeneric(mp_limb_t *square,
+                                       const mp_limb_t *operand,
+                                       MontgomeryField *field) {
+  mpn_sqr(field->product, operand, field->limbCount);
+  montgomeryField_reduce(square, field->product, field->limbCount, field);
+}
+
+// Defines the kernels of a fixed limb count, for which the compiler can unroll
+// the reduction, and which keep the unreduced product in automatic storage.
+#define MONTGOMERY_FIELD_KERNELS(name, limbCount)                              \
+  static void montgomeryField_mul##name(                                       \
+      mp_limb_t *product, const mp_limb_t *multiplier,                         \
+      const mp_limb_t *multiplicand, MontgomeryField *field) {                 \
+    mp_limb_t t[2 * (limbCount)];                                              \
+    mpn_mul_n(t, multiplier, multiplicand, (limbCount));                       \
+    montgomeryField_reduce(product, t, (limbCount), field);                    \
+  }                                                                            \
+                                                                               \
+  static void montgomeryField_sqr##name(                                       \
+      mp_limb_t *square, const mp_limb_t *operand, MontgomeryField *field) {   \
+    mp_limb_t t[2 * (limbCount)];                                              \
+    mpn_sqr(t, operand, (limbCount));                                          \
+    montgomeryField_reduce(square, t, (limbCount), field);                     \
+  }
+
+// Every security level has the kernels of its nominal length, and of the one
+// extra limb an order exceeding it may need.
+#define MONTGOMERY_FIELD_LEVEL_KERNELS(name, bits)                             \
+  MONTGOMERY_FIELD_KERNELS(name, MONTGOMERY_FIELD_LIMB_COUNT(bits))            \
+  MONTGOMERY_FIELD_KERNELS(name##Extended,                                     \
+                           MONTGOMERY_FIELD_LEVEL_LIMB_COUNT(bits))
+
+MONTGOMERY_FIELD_LEVEL_KERNELS(Lowest, 512)
+MONTGOMERY_FIELD_LEVEL_KERNELS(Low, 1024)
+MONTGOMERY_FIELD_LEVEL_KERNELS(Medium, 1536)
+MONTGOMERY_FIELD_LEVEL_KERNELS(High, 3840)
+MONTGOMERY_FIELD_LEVEL_KERNELS(Highest, 7680)
+
+typedef struct MontgomeryFieldKernels {
+  mp_size_t limbCount;
+  void (*mulKernel)(mp_limb_t *product, const mp_limb_t *multiplier,
+                    const mp_limb_t *multiplicand, MontgomeryField *field);
+  void (*sqrKernel)(mp_limb_t *square, const mp_limb_t *operand,
+                    MontgomeryField *field);
+} MontgomeryFieldKernels;
+
+#define MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(name, bits)                      \
+  {MONTGOMERY_FIELD_LIMB_COUNT(bits), montgomeryField_mul##name,               \
+   montgomeryField_sqr##name},                                                 \
+      {MONTGOMERY_FIELD_LEVEL_LIMB_COUNT(bits),                                \
+       montgomeryField_mul##name##Extended,                                    \
+       montgomeryField_sqr##name##Extended}
+
+static const MontgomeryFieldKernels KERNELS[] = {
+    MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(Lowest, 512),
+    MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(Low, 1024),
+    MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(Medium, 1536),
+    MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(High, 3840),
+    MONTGOMERY_FIELD_LEVEL_KERNEL_ENTRIES(Highest, 7680)};
+
+void montgomeryField_init(MontgomeryField *fieldOutput, const mpz_t modulus) {
+  const mp_size_t n = (mp_size_t)mpz_size(modulus);
+
+  fieldOutput->limbCount = n;
+  fieldOutput->modulus = (mp_limb_t *)malloc(n * sizeof(mp_limb_t));
+  montgomeryField_copyMpz(fieldOutput->modulus, modulus, n);
+
+  // Newton iteration for \f$p^{-1} \mod 2^w\f$: an odd \f$p\f$ is its own
+  // inverse modulo \f$2^3\f$, and every step doubles the number of correct
+  // bits.
+  const mp_limb_t lowestLimb = fieldOutput->modulus[0];
+  mp_limb_t inverse = lowestLimb;
+  for (size_t correctBits = 3; correctBits < LIMB_BITS; correctBits *= 2) {
+    inverse *= 2 - lowestLimb * inverse;
+  }
+  fieldOutput->modulusInverse = -inverse;
+
+  mpz_init(fieldOutput->conversion);
+  mpz_setbit(fieldOutput->conversion, 2 * n * LIMB_BITS);
+  mpz_mod(fieldOutput->conversion, fieldOutput->conversion, modulus);
+  fieldOutput->rSquared = (mp_limb_t *)malloc(n * sizeof(mp_limb_t));
+  montgomeryField_copyMpz(fieldOutput->rSquared, fieldOutput->conversion, n);
+
+  fieldOutput->product = (mp_limb_t *)malloc(2 * n * sizeof(mp_limb_t));
+
+  fieldOutput->mulKernel = montgomeryField_mulGeneric;
+  fieldOutput->sqrKernel = montgomeryField_sqrGeneric;
+  for (size_t i = 0; i < sizeof(KERNELS) / sizeof(KERNELS[0]); i++) {
+    if (KERNELS[i].limbCount == n) {
+      fieldOutput->mulKernel = KERNELS[i].mulKernel;
+      fieldOutput->sqrKernel = KERNELS[i].sqrKernel;
+      break;
+    }
+  }
+}
+
+void montgomeryField_destroy(MontgomeryField field) {
+  free(field.modulus);
+  free(field.rSquared);
+  free(field.product);
+  mpz_clear(field.conversion);
+}
+
+void montgomeryField_initElements(mp_limb_t **elementsOutput,
+                                  const size_t count,
+                                  const MontgomeryField *field) {
+  *elementsOutput =
+      (mp_limb_t *)calloc(count * field->limbCount, sizeof(mp_limb_t));
+}
+
+void montgomeryField_fromMpz(mp_limb_t *result, const mpz_t value,
+                             MontgomeryField *field) {
+  mpz_t modulus;
+  mpz_roinit_n(modulus, field->modulus, field->limbCount);
+
+  if (mpz_sgn(value) < 0 || mpz_cmp(value, modulus) >= 0) {
+    mpz_mod(field->conversion, value, modulus);
+    montgomeryField_copyMpz(result, field->conversion, field->limbCount);
+  } else {
+    montgomeryField_copyMpz(result, value, field->limbCount);
+  }
+
+  // \f$vR = \frac{v \cdot R^2}{R}\f$
+  montgomeryField_mul(result, result, field->rSquared, field);
+}
+
+void montgomeryField_toMpz(mpz_t result, const mp_limb_t *element,
+                           MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+
+  // \f$v = \frac{vR}{R}\f$
+  mpn_copyi(field->product, element, n);
+  mpn_zero(field->product + n, n);
+  montgomeryField_reduce(mpz_limbs_write(result, n), field->product, n, field);
+  mpz_limbs_finish(result, n);
+}
+
+void montgomeryField_add(mp_limb_t *sum, const mp_limb_t *augend,
+                         const mp_limb_t *addend,
+                         const MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+
+  const mp_limb_t carry = mpn_add_n(sum, augend, addend, n);
+  if (carry || mpn_cmp(sum, field->modulus, n) >= 0) {
+    mpn_sub_n(sum, sum, field->modulus, n);
+  }
+}
+
+void montgomeryField_sub(mp_limb_t *difference, const mp_limb_t *minuend,
+                         const mp_limb_t *subtrahend,
+                         const MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+
+  if (mpn_sub_n(difference, minuend, subtrahend, n)) {
+    mpn_add_n(difference, difference, field->modulus, n);
+  }
+}
+
+void montgomeryField_neg(mp_limb_t *inverse, const mp_limb_t *operand,
+                         const MontgomeryField *field) {
+  const mp_size_t n = field->limbCount;
+
+  if (mpn_zero_p(operand, n)) {
+    mpn_zero(inverse, n);
+  } else {
+    mpn_sub_n(inverse, field->modulus, operand, n);
+  }
+}
+
+void montgomeryField_mul(mp_limb_t *product, const mp_limb_t *multiplier,
+                         const mp_limb_t *multiplicand,
+                         MontgomeryField *field) {
+  field->mulKernel(product, multiplier, multiplicand, field);
+}
+
+void montgomeryField_sqr(mp_limb_t *square, const mp_limb_t *operand,
+                         MontgomeryField *field) {
+  field->sqrKernel(square, operand, field);
+}
+
+CryptidStatus montgomeryField_inverse(mp_limb_t *inverse,
+                                      const mp_limb_t *operand,
+                                      MontgomeryField *field) {
+  if (mpn_zero_p(operand, field->limbCount)) {
+    return CRYPTID_HAS_NO_MUL_INV_ERROR;
+  }
+
+  mpz_t modulus, value;
+  mpz_roinit_n(modulus, field->modulus, field->limbCount);
+  mpz_roinit_n(value, operand, field->limbCount);
+
+  // \f$(aR)^{-1}\f$ is converted into \f$(aR)^{-1} \cdot R = a^{-1}\f$, then
+  // \f$a^{-1} \cdot R\f$.
+  mpz_invert(field->conversion, value, modulus);
+  montgomeryField_fromMpz(inverse, field->conversion, field);
+  montgomeryField_mul(inverse, inverse, field->rSquared, field);
+
+  return CRYPTID_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include "util/Parallel.h"
+
+static int configuredThreadCount = 0;
+
+void parallel_setThreadCount(const int threadCount) {
+  if (threadCount < 0) {
+    configuredThreadCount = 0;
+  } else if (threadCount > PARALLEL_MAX_THREAD_COUNT) {
+    configuredThreadCount = PARALLEL_MAX_THREAD_COUNT;
+  } else {
+    configuredThreadCount = threadCount;
+  }
+}
+
+#if defined(__CRYPTID_PTHREADS)
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct ParallelThread {
+  ParallelTask task;
+  void *argument;
+  int taskIndex;
+  int taskCount;
+} ParallelThread;
+
+static void *parallel_threadMain(void *thread) {
+  ParallelThread *parallelThread = (ParallelThread *)thread;
+
+  parallelThread->task(parallelThread->argument, parallelThread->taskIndex,
+                       parallelThread->taskCount);
+
+  return NULL;
+}
+
+int parallel_threadCount(void) {
+  if (configuredThreadCount > 0) {
+    return configuredThreadCount;
+  }
+
+  const long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+  return processorCount < 1 ? 1
+         : processorCount > PARALLEL_MAX_THREAD_COUNT
+             ? PARALLEL_MAX_THREAD_COUNT
+             : (int)processorCount;
+}
+
+void parallel_run(const ParallelTask task, void *argument,
+                  const int taskCount) {
+  ParallelThread threads[PARALLEL_MAX_THREAD_COUNT];
+  pthread_t handles[PARALLEL_MAX_THREAD_COUNT];
+  int isStarted[PARALLEL_MAX_THREAD_COUNT];
+
+  for (int i = 1; i < taskCount; i++) {
+    threads[i].task = task;
+    threads[i].argument = argument;
+    threads[i].taskIndex = i;
+    threads[i].taskCount = taskCount;
+
+    isStarted[i] =
+        !pthread_create(&handles[i], NULL, parallel_threadMain, &threads[i]);
+  }
+
+  task(argument, 0, taskCount);
+
+  for (int i = 1; i < taskCount; i++) {
+    if (isStarted[i]) {
+      pthread_join(handles[i], NULL);
+    } else {
+      task(argument, i, taskCount);
+    }
+  }
+}
+
+#else
+
+int parallel_threadCount(void) { return 1; }
+
+void parallel_run(const ParallelTask task, void *argument,
+                  const int taskCount) {
+  for (int i = 0; i < taskCount; i++) {
+    task(argument, i, taskCount);
+  }
+}
+
+#endif
@@ -1,9 +1,89 @@
+#include <math.h>
+#include <stdlib.h>
+
 #include "util/PrimalityTest.h"
 #include "util/Random.h"
+#include "util/ValidationCache.h"
+
+#if defined(__CRYPTID_PTHREADS)
+#include <pthread.h>
+
+static pthread_mutex_t primalityTestPolicyLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// References
+//  * [DLP] Ivan Damgard, Peter Landrock, Carl Pomerance. 1993. Average Case
+//  Error Estimates for the Strong Probable Prime Test
+//  * [FIPS-186-5] NIST. 2023. FIPS 186-5. Digital Signature Standard (DSS)
+//  * [BPSW] Robert Baillie, Samuel S. Wagstaff, Jr. 1980. Lucas Pseudoprimes
 
 static const int MIGHT_BE_PRIME = 1;
 static const int NOT_PRIME = 0;
 
+static PrimalityTestPolicy generationPolicy = primalityTest_MILLER_RABIN;
+static PrimalityTestPolicy validationPolicy = primalityTest_MILLER_RABIN;
+
+static void primalityTest_lock(void) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&primalityTestPolicyLock);
+#endif
+}
+
+static void primalityTest_unlock(void) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_unlock(&primalityTestPolicyLock);
+#endif
+}
+
+void primalityTest_setPolicy(const PrimalityTestPurpose purpose,
+                             const PrimalityTestPolicy policy) {
+  primalityTest_lock();
+  if (purpose == primalityTest_GENERATION) {
+    generationPolicy = policy;
+  } else {
+    validationPolicy = policy;
+  }
+  primalityTest_unlock();
+
+  if (purpose == primalityTest_VALIDATION) {
+    // Results of the previous policy no longer apply.
+    validationCache_invalidate();
+  }
+}
+
+int primalityTest_millerRabinRounds(const unsigned long bitLength) {
+  // The smallest \f$t\f$ for which the bounds of [DLP] on the probability of a
+  // random odd \f$k\f$-bit composite passing \f$t\f$ rounds are below the
+  // target, which is how the tables of [FIPS-186-5] Appendix B.3 are derived.
+  // The bounds hold for \f$k \geq 21\f$.
+  const int worstCaseRounds = PRIMALITYTEST_ERROR_BITS / 2;
+  const double target = ldexp(1.0, -PRIMALITYTEST_ERROR_BITS);
+  const double k = (double)bitLength;
+
+  if (bitLength < 21) {
+    return worstCaseRounds;
+  }
+
+  for (int t = 3; t < worstCaseRounds; t++) {
+    double bound;
+
+    if (t <= k / 9) {
+      bound = pow(k, 1.5) * ldexp(1.0, t) / sqrt((double)t) *
+              pow(4.0, 2.0 - sqrt(t * k));
+    } else {
+      bound = 7.0 / 20.0 * k * ldexp(1.0, -5 * t) +
+              pow(k, 15.0 / 4.0) / 7.0 * pow(2.0, -k / 2.0 - 2 * t) +
+              12.0 * k * pow(2.0, -k / 4.0 - 3 * t);
+    }
+
+    if (bound <= target) {
+      return t;
+    }
+  }
+
+  return worstCaseRounds;
+}
+
 static int primalityTest_millerrabin(const mpz_srcptr p,
                                      const mpz_srcptr pMinus1,
                                      const mpz_ptr base, const mpz_ptr basePow,
@@ -25,12 +105,11 @@ static int primalityTest_millerrabin(const mpz_srcptr p,
   return NOT_PRIME;
 }
 
+// Miller-Rabin rounds to random bases, preceded by one to base 2 if
+// isBaseTwoFirst is set. p must be odd and greater than 3.
 static int primalityTest_millerrabin_mpz(const mpz_srcptr p,
-                                         const int repetitions) {
-  if (mpz_cmp_ui(p, 3L) <= 0) {
-    return MIGHT_BE_PRIME;
-  }
-
+                                         const int repetitions,
+                                         const int isBaseTwoFirst) {
   mpz_t pMinus1, pMinus3, base, basePow, d;
   mpz_inits(pMinus1, pMinus3, base, basePow, d, NULL);
   unsigned long int s;
@@ -38,21 +117,23 @@ static int primalityTest_millerrabin_mpz(const mpz_srcptr p,
 
   mpz_sub_ui(pMinus1, p, 1L);
 
-  mpz_set_ui(base, 210L);
-  mpz_powm(basePow, base, pMinus1, p);
-  if (mpz_cmp_ui(basePow, 1L) != 0) {
-    mpz_clears(pMinus1, pMinus3, base, basePow, d, NULL);
-    return NOT_PRIME;
-  }
-
   s = mpz_scan1(pMinus1, 0L);
   mpz_tdiv_q_2exp(d, pMinus1, s);
 
   mpz_sub_ui(pMinus3, p, 3L);
 
   isPrime = 1;
+  if (isBaseTwoFirst) {
+    mpz_set_ui(base, 2L);
+    isPrime = primalityTest_millerrabin(p, pMinus1, base, basePow, d, s);
+  }
+
   for (int r = 0; r < repetitions && isPrime; r++) {
-    random_mpzInRange(base, pMinus3);
+    // Without a random base nothing is proven, so p is rejected.
+    if (random_mpzInRange(base, pMinus3)) {
+      isPrime = 0;
+      break;
+    }
     mpz_add_ui(base, base, 2L);
 
     isPrime = primalityTest_millerrabin(p, pMinus1, base, basePow, d, s);
@@ -62,22 +143,162 @@ static int primalityTest_millerrabin_mpz(const mpz_srcptr p,
   return isPrime;
 }
 
+// Halves x modulo the odd n.
+static void primalityTest_halveMod(const mpz_ptr x, const mpz_srcptr n) {
+  if (mpz_odd_p(x)) {
+    mpz_add(x, x, n);
+  }
+  mpz_tdiv_q_2exp(x, x, 1L);
+}
+
+// The strong Lucas test of [BPSW] with the parameters of Selfridge's Method A,
+// \f$P = 1\f$ and \f$Q = (1 - D) / 4\f$, \f$D\f$ being the first of
+// \f$5, -7, 9, -11, \ldots\f$ with \f$\left(\frac{D}{n}\right) = -1\f$. n must
+// be odd and greater than 3.
+static int primalityTest_strongLucas(const mpz_srcptr n) {
+  // No such \f$D\f$ exists for squares.
+  if (mpz_perfect_square_p(n)) {
+    return NOT_PRIME;
+  }
+
+  long D = 5;
+  for (;;) {
+    const int jacobi = mpz_si_kronecker(D, n);
+
+    if (jacobi == -1) {
+      break;
+    }
+
+    // A proper factor \f$|D|\f$ of n.
+    if (jacobi == 0 && mpz_cmp_ui(n, (unsigned long)labs(D)) != 0) {
+      return NOT_PRIME;
+    }
+
+    D = D > 0 ? -(D + 2) : -D + 2;
+  }
+
+  mpz_t d, u, v, qk, q, temp;
+  mpz_inits(d, u, v, qk, q, temp, NULL);
+
+  mpz_set_si(q, (1 - D) / 4);
+  mpz_mod(q, q, n);
+
+  // \f$n + 1 = d \cdot 2^s\f$ with \f$d\f$ odd.
+  mpz_add_ui(d, n, 1L);
+  const unsigned long s = mpz_scan1(d, 0L);
+  mpz_tdiv_q_2exp(d, d, s);
+
+  // \f$U_1 = 1\f$, \f$V_1 = P\f$, then the bits of \f$d\f$ from the top,
+  // doubling the index, and adding one for set bits.
+  mpz_set_ui(u, 1L);
+  mpz_set_ui(v, 1L);
+  mpz_set(qk, q);
+
+  for (long bit = (long)mpz_sizeinbase(d, 2) - 2; bit >= 0; bit--) {
+    // \f$U_{2k} = U_k V_k\f$, \f$V_{2k} = V_k^2 - 2Q^k\f$.
+    mpz_mul(u, u, v);
+    mpz_mod(u, u, n);
+    mpz_mul(v, v, v);
+    mpz_submul_ui(v, qk, 2L);
+    mpz_mod(v, v, n);
+    mpz_mul(qk, qk, qk);
+    mpz_mod(qk, qk, n);
+
+    if (mpz_tstbit(d, bit)) {
+      // \f$U_{k+1} = (P U_k + V_k) / 2\f$, \f$V_{k+1} = (D U_k + P V_k) / 2\f$.
+      mpz_add(temp, u, v);
+      mpz_mul_si(v, u, D);
+      mpz_add(v, v, temp);
+      mpz_sub(v, v, u);
+      mpz_mod(v, v, n);
+      primalityTest_halveMod(v, n);
+
+      mpz_mod(u, temp, n);
+      primalityTest_halveMod(u, n);
+
+      mpz_mul(qk, qk, q);
+      mpz_mod(qk, qk, n);
+    }
+  }
+
+  int isPrime = mpz_sgn(u) == 0 || mpz_sgn(v) == 0;
+
+  // \f$V_{d \cdot 2^r} \equiv 0\f$ for some \f$0 < r < s\f$.
+  for (unsigned long r = 1; r < s && !isPrime; r++) {
+    mpz_mul(v, v, v);
+    mpz_submul_ui(v, qk, 2L);
+    mpz_mod(v, v, n);
+    mpz_mul(qk, qk, qk);
+    mpz_mod(qk, qk, n);
+
+    isPrime = mpz_sgn(v) == 0;
+  }
+
+  mpz_clears(d, u, v, qk, q, temp, NULL);
+  return isPrime ? MIGHT_BE_PRIME : NOT_PRIME;
+}
+
 #if defined(__CRYPTID_EXTERN_PRIMALITY_TEST)
 
 extern int __primalityTest_isProbablePrime(const mpz_t p);
 
-CryptidValidationResult primalityTest_isProbablePrime(const mpz_t p) {
-  return __primalityTest_isProbablePrime(p) >= MIGHT_BE_PRIME
-             ? CRYPTID_VALIDATION_SUCCESS
-             : CRYPTID_VALIDATION_FAILURE;
+static int primalityTest_test(const mpz_srcptr p,
+                              const PrimalityTestPolicy policy,
+                              const PrimalityTestPurpose purpose) {
+  (void)policy;
+  (void)purpose;
+
+  return __primalityTest_isProbablePrime(p);
 }
 
 #else
 
-CryptidValidationResult primalityTest_isProbablePrime(const mpz_t p) {
-  return primalityTest_millerrabin_mpz(p, 50) >= MIGHT_BE_PRIME
+static int primalityTest_test(const mpz_srcptr p,
+                              const PrimalityTestPolicy policy,
+                              const PrimalityTestPurpose purpose) {
+  if (mpz_cmp_ui(p, 3L) <= 0) {
+    return mpz_cmp_ui(p, 2L) >= 0 ? MIGHT_BE_PRIME : NOT_PRIME;
+  }
+
+  if (mpz_even_p(p)) {
+    return NOT_PRIME;
+  }
+
+  if (policy == primalityTest_BAILLIE_PSW) {
+    return primalityTest_millerrabin_mpz(p, 0, 1) &&
+           primalityTest_strongLucas(p);
+  }
+
+  return primalityTest_millerrabin_mpz(
+      p,
+      purpose == primalityTest_GENERATION
+          ? primalityTest_millerRabinRounds(mpz_sizeinbase(p, 2))
+          : PRIMALITYTEST_ERROR_BITS / 2,
+      0);
+}
+
+#endif
+
+CryptidValidationResult
+primalityTest_isProbablePrimeWithPolicy(const mpz_t p,
+                                        const PrimalityTestPolicy policy,
+                                        const PrimalityTestPurpose purpose) {
+  if (policy == primalityTest_TRUSTED && purpose == primalityTest_VALIDATION) {
+    return CRYPTID_VALIDATION_SUCCESS;
+  }
+
+  return primalityTest_test(p, policy, purpose) >= MIGHT_BE_PRIME
              ? CRYPTID_VALIDATION_SUCCESS
              : CRYPTID_VALIDATION_FAILURE;
 }
 
-#endif
\ No newline at end of file
+CryptidValidationResult
+primalityTest_isProbablePrime(const mpz_t p,
+                              const PrimalityTestPurpose purpose) {
+  primalityTest_lock();
+  const PrimalityTestPolicy policy =
+      purpose == primalityTest_GENERATION ? generationPolicy : validationPolicy;
+  primalityTest_unlock();
+
+  return primalityTest_isProbablePrimeWithPolicy(p, policy, purpose);
+}
@@ -32,24 +32,121 @@ CryptidStatus cryptid_randomBytes(unsigned char *buf, const int num) {
 
 #else
 
+#include <errno.h>
 #include <stdio.h>
 
-CryptidStatus cryptid_randomBytes(unsigned char *buf, const int num) {
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+static CryptidStatus randBytes_fromSystem(unsigned char *buf, size_t num) {
+#if defined(__linux__)
+  // getrandom(2) blocks only until the pool of the kernel has been
+  // initialized, and needs no file descriptor. Kernels older than 3.17 lack
+  // it, these fall back to /dev/urandom.
+  while (num > 0) {
+    const ssize_t byteCount = getrandom(buf, num, 0);
+
+    if (byteCount < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      if (errno == ENOSYS) {
+        break;
+      }
+
+      return CRYPTID_RANDOM_GENERATION_ERROR;
+    }
+
+    buf += byteCount;
+    num -= (size_t)byteCount;
+  }
+
+  if (num == 0) {
+    return CRYPTID_SUCCESS;
+  }
+#endif
+
   FILE *randomSource = fopen("/dev/urandom", "rb");
 
   if (!randomSource) {
     return CRYPTID_RANDOM_GENERATION_ERROR;
   }
 
-  int byteCount = fread(buf, sizeof(unsigned char), num, randomSource);
+  const size_t byteCount = fread(buf, sizeof(unsigned char), num, randomSource);
+
+  fclose(randomSource);
+
+  return byteCount < num ? CRYPTID_RANDOM_GENERATION_ERROR : CRYPTID_SUCCESS;
+}
+
+#if defined(__CRYPTID_RANDOM_POOL)
+
+#include <pthread.h>
+#include <string.h>
+
+// Small requests are served from a per-thread pool of random bytes, refilled
+// by a single system call. Used bytes are wiped from the pool immediately, and
+// a forked child discards the pool it inherits, so it never repeats the bytes
+// of its parent.
+#define RAND_BYTES_POOL_SIZE 4096
+
+static __thread unsigned char pool[RAND_BYTES_POOL_SIZE];
+
+// The unused bytes are the last poolAvailable ones.
+static __thread int poolAvailable = 0;
+
+static pthread_once_t poolForkHandlerOnce = PTHREAD_ONCE_INIT;
 
-  if (byteCount < num) {
+static void randBytes_discardPool(void) {
+  memset(pool, 0, RAND_BYTES_POOL_SIZE);
+  poolAvailable = 0;
+}
+
+static void randBytes_registerPoolForkHandler(void) {
+  pthread_atfork(NULL, NULL, randBytes_discardPool);
+}
+
+CryptidStatus cryptid_randomBytes(unsigned char *buf, const int num) {
+  if (num < 0) {
     return CRYPTID_RANDOM_GENERATION_ERROR;
   }
 
-  fclose(randomSource);
+  if (num > RAND_BYTES_POOL_SIZE / 4) {
+    return randBytes_fromSystem(buf, (size_t)num);
+  }
+
+  pthread_once(&poolForkHandlerOnce, randBytes_registerPoolForkHandler);
+
+  if (poolAvailable < num) {
+    if (randBytes_fromSystem(pool, RAND_BYTES_POOL_SIZE)) {
+      randBytes_discardPool();
+      return CRYPTID_RANDOM_GENERATION_ERROR;
+    }
+
+    poolAvailable = RAND_BYTES_POOL_SIZE;
+  }
+
+  unsigned char *const available = pool + RAND_BYTES_POOL_SIZE - poolAvailable;
+
+  memcpy(buf, available, (size_t)num);
+  memset(available, 0, (size_t)num);
+  poolAvailable -= num;
 
   return CRYPTID_SUCCESS;
 }
 
+#else
+
+CryptidStatus cryptid_randomBytes(unsigned char *buf, const int num) {
+  if (num < 0) {
+    return CRYPTID_RANDOM_GENERATION_ERROR;
+  }
+
+  return randBytes_fromSystem(buf, (size_t)num);
+}
+
+#endif
+
 #endif
@@ -1,62 +1,499 @@
 #include "util/Random.h"
+#include "util/HmacDrbg.h"
+#include "util/Parallel.h"
 #include "util/PrimalityTest.h"
 #include "util/RandBytes.h"
+#include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__CRYPTID_PTHREADS)
+#include <pthread.h>
+#define RANDOM_THREAD_LOCAL __thread
+#else
+#define RANDOM_THREAD_LOCAL
+#endif
 
 static const unsigned int MOST_SIGNIFICANT_WORD_FIRST = 1;
 static const unsigned int NATIVE_ENDIANNESS = 0;
 static const unsigned int NO_SKIP = 0;
 
-void random_unsignedIntOfLength(unsigned int *randomOutput,
-                                const unsigned int numberOfBits) {
+// The number of requests served by a generator seeded by the operating system
+// before it is reseeded by it.
+static const unsigned long long SYSTEM_RESEED_INTERVAL = 1ULL << 16;
+
+// The length of the entropy input and the nonce drawn from the operating
+// system, for the 256-bit security strength of the generator.
+#define SYSTEM_ENTROPY_LENGTH 32
+#define SYSTEM_NONCE_LENGTH 16
+
+typedef enum {
+  RANDOM_UNINSTANTIATED,
+  RANDOM_SYSTEM_SEEDED,
+  RANDOM_EXPLICITLY_SEEDED
+} RandomMode;
+
+// Every thread has its own generator, so no locking is needed.
+static RANDOM_THREAD_LOCAL HmacDrbg drbg;
+static RANDOM_THREAD_LOCAL RandomMode mode = RANDOM_UNINSTANTIATED;
+
+#if defined(__CRYPTID_PTHREADS)
+static pthread_once_t forkHandlerOnce = PTHREAD_ONCE_INIT;
+
+// A forked child would otherwise repeat the output of its parent.
+static void random_forgetInChild(void) {
+  if (mode == RANDOM_SYSTEM_SEEDED) {
+    hmacDrbg_destroy(&drbg);
+    mode = RANDOM_UNINSTANTIATED;
+  }
+}
+
+static void random_registerForkHandler(void) {
+  pthread_atfork(NULL, NULL, random_forgetInChild);
+}
+#endif
+
+static CryptidStatus random_seedFromSystem(void) {
+  unsigned char seed[SYSTEM_ENTROPY_LENGTH + SYSTEM_NONCE_LENGTH];
+
+  CryptidStatus status = cryptid_randomBytes(
+      seed, mode == RANDOM_UNINSTANTIATED ? sizeof(seed)
+                                          : SYSTEM_ENTROPY_LENGTH);
+
+  if (!status) {
+    if (mode == RANDOM_UNINSTANTIATED) {
+      hmacDrbg_instantiate(&drbg, seed, SYSTEM_ENTROPY_LENGTH,
+                           seed + SYSTEM_ENTROPY_LENGTH, SYSTEM_NONCE_LENGTH,
+                           NULL, 0);
+      mode = RANDOM_SYSTEM_SEEDED;
+    } else {
+      hmacDrbg_reseed(&drbg, seed, SYSTEM_ENTROPY_LENGTH, NULL, 0);
+    }
+  }
+
+  memset(seed, 0, sizeof(seed));
+
+  return status;
+}
+
+CryptidStatus random_bytes(unsigned char *output, const size_t outputLength) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_once(&forkHandlerOnce, random_registerForkHandler);
+#endif
+
+  if (mode == RANDOM_UNINSTANTIATED ||
+      (mode == RANDOM_SYSTEM_SEEDED &&
+       drbg.reseedCounter > SYSTEM_RESEED_INTERVAL)) {
+    CryptidStatus status = random_seedFromSystem();
+    if (status) {
+      return status;
+    }
+  }
+
+  size_t generated = 0;
+  while (generated < outputLength) {
+    const size_t requestLength =
+        outputLength - generated < HMACDRBG_MAX_REQUEST_SIZE
+            ? outputLength - generated
+            : HMACDRBG_MAX_REQUEST_SIZE;
+
+    CryptidStatus status =
+        hmacDrbg_generate(&drbg, output + generated, requestLength, NULL, 0);
+    if (status) {
+      return status;
+    }
+
+    generated += requestLength;
+  }
+
+  return CRYPTID_SUCCESS;
+}
+
+void random_setSeed(const unsigned char *const seed, const size_t seedLength) {
+  hmacDrbg_destroy(&drbg);
+
+  if (seed == NULL) {
+    mode = RANDOM_UNINSTANTIATED;
+    return;
+  }
+
+  hmacDrbg_instantiate(&drbg, seed, seedLength, NULL, 0, NULL, 0);
+  mode = RANDOM_EXPLICITLY_SEEDED;
+}
+
+CryptidStatus random_unsignedIntOfLength(unsigned int *randomOutput,
+                                         const unsigned int numberOfBits) {
   unsigned int numberOfBytes = (numberOfBits + 7) / 8;
 
   unsigned char buffer[sizeof(unsigned int)] = {0};
 
-  cryptid_randomBytes((unsigned char *)&buffer, numberOfBytes);
+  CryptidStatus status = random_bytes((unsigned char *)&buffer, numberOfBytes);
+  if (status) {
+    memset(buffer, 0, sizeof(buffer));
+    *randomOutput = 0;
+    return status;
+  }
 
   unsigned int unneededBits = 8 * numberOfBytes - numberOfBits;
   buffer[numberOfBytes - 1] &= (1 << (8 - unneededBits)) - 1;
 
   *randomOutput = *((unsigned int *)&buffer);
+
+  return CRYPTID_SUCCESS;
 }
 
 // Using the method suggested by Johannes A. Buchmann in Introduction to
 // Cryptography Second Edition Section 4.6
-void random_unsignedIntInRange(unsigned int *randomOutput,
-                               const unsigned int range) {
+CryptidStatus random_unsignedIntInRange(unsigned int *randomOutput,
+                                        const unsigned int range) {
   unsigned int rangeBitLength = (int)log2(range) + 1;
 
   do {
-    random_unsignedIntOfLength(randomOutput, rangeBitLength);
+    CryptidStatus status =
+        random_unsignedIntOfLength(randomOutput, rangeBitLength);
+    if (status) {
+      return status;
+    }
   } while (*randomOutput > range);
+
+  return CRYPTID_SUCCESS;
 }
 
-void random_mpzOfLength(mpz_t result, const unsigned int numberOfBits) {
+// Draws from generator, or from the generator of the calling thread if it is
+// NULL.
+static CryptidStatus random_mpzOfLengthFrom(mpz_t result,
+                                            const unsigned int numberOfBits,
+                                            HmacDrbg *generator) {
   unsigned int numberOfBytes = (numberOfBits + 7) / 8;
 
   unsigned char buffer[numberOfBytes];
 
-  cryptid_randomBytes((unsigned char *)&buffer, numberOfBytes);
+  CryptidStatus status =
+      generator
+          ? hmacDrbg_generate(generator, buffer, numberOfBytes, NULL, 0)
+          : random_bytes((unsigned char *)&buffer, numberOfBytes);
+  if (status) {
+    memset(buffer, 0, sizeof(buffer));
+    mpz_set_ui(result, 0);
+    return status;
+  }
 
   unsigned int unneededBits = 8 * numberOfBytes - numberOfBits;
   buffer[0] &= (1 << (8 - unneededBits)) - 1;
 
   mpz_import(result, sizeof(buffer), MOST_SIGNIFICANT_WORD_FIRST,
              sizeof(buffer[0]), NATIVE_ENDIANNESS, NO_SKIP, buffer);
+
+  return CRYPTID_SUCCESS;
+}
+
+CryptidStatus random_mpzOfLength(mpz_t result,
+                                 const unsigned int numberOfBits) {
+  return random_mpzOfLengthFrom(result, numberOfBits, NULL);
 }
 
-void random_mpzInRange(mpz_t result, const mpz_t range) {
+CryptidStatus random_mpzInRange(mpz_t result, const mpz_t range) {
   unsigned int rangeBitLength = mpz_sizeinbase(range, 2);
 
   do {
-    random_mpzOfLength(result, rangeBitLength);
+    CryptidStatus status = random_mpzOfLength(result, rangeBitLength);
+    if (status) {
+      return status;
+    }
   } while (mpz_cmp(result, range) > 0);
+
+  return CRYPTID_SUCCESS;
+}
+
+// Odd primes below this bound are sieved out of the candidates of
+// random_pairingPrime.
+#define SIEVE_PRIME_BOUND 65536
+
+// Odd primes below this bound divide the candidates of random_solinasPrime
+// before the primality test.
+#define TRIAL_DIVISION_PRIME_BOUND 2048
+
+// Lists the odd primes below bound by the sieve of Eratosthenes, and gives
+// their number.
+static int random_smallPrimes(unsigned int **primesOutput,
+                              const unsigned int bound) {
+  unsigned char *isComposite = calloc(bound, sizeof(unsigned char));
+  unsigned int *primes = malloc(bound / 2 * sizeof(unsigned int));
+  int primeCount = 0;
+
+  for (unsigned int i = 3; i < bound; i += 2) {
+    if (isComposite[i]) {
+      continue;
+    }
+
+    primes[primeCount++] = i;
+    for (unsigned long j = (unsigned long)i * i; j < bound; j += 2 * i) {
+      isComposite[j] = 1;
+    }
+  }
+
+  free(isComposite);
+
+  *primesOutput = primes;
+  return primeCount;
+}
+
+static int random_hasSmallFactor(const mpz_t n, const unsigned int *primes,
+                                 const int primeCount) {
+  for (int i = 0; i < primeCount; i++) {
+    if (mpz_fdiv_ui(n, primes[i]) == 0 && mpz_cmp_ui(n, primes[i]) != 0) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+// \f$a^{-1} \bmod s\f$ for a prime \f$s\f$, by Fermat's little theorem.
+static unsigned long random_inverseModSmallPrime(const unsigned long a,
+                                                 const unsigned long s) {
+  unsigned long long result = 1, base = a % s;
+
+  for (unsigned long e = s - 2; e > 0; e >>= 1) {
+    if (e & 1) {
+      result = result * base % s;
+    }
+    base = base * base % s;
+  }
+
+  return (unsigned long)result;
+}
+
+// The length of the seed of random_pairingPrime, from which the generators of
+// its windows are derived.
+#define PAIRING_PRIME_SEED_LENGTH 32
+
+// No window has yielded a prime yet.
+#define PAIRING_PRIME_NO_WINDOW ULONG_MAX
+
+// The state of random_pairingPrime shared by its workers.
+typedef struct PairingPrimeSearch {
+  mpz_ptr p;
+  mpz_ptr r;
+  mpz_t step;
+  unsigned int rBitLength;
+  unsigned int windowSize;
+  unsigned int *primes;
+  int primeCount;
+  // \f$(12q)^{-1} \bmod s\f$ for every small prime \f$s\f$, or 0 if \f$s\f$
+  // divides \f$12q\f$.
+  unsigned long *stepInverses;
+  unsigned char seed[PAIRING_PRIME_SEED_LENGTH];
+  // The index of the first window known to contain a prime, or 0 if a worker
+  // failed to draw a starting point.
+  unsigned long foundWindow;
+  CryptidStatus status;
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_t lock;
+#endif
+} PairingPrimeSearch;
+
+static unsigned long
+random_pairingPrimeFoundWindow(PairingPrimeSearch *search) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&search->lock);
+  const unsigned long foundWindow = search->foundWindow;
+  pthread_mutex_unlock(&search->lock);
+  return foundWindow;
+#else
+  return search->foundWindow;
+#endif
+}
+
+// Publishes the prime of a window, unless an earlier window has one.
+static void random_foundPairingPrime(PairingPrimeSearch *search,
+                                     const unsigned long window, const mpz_t p,
+                                     const mpz_t r) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&search->lock);
+#endif
+  if (window < search->foundWindow) {
+    mpz_set(search->p, p);
+    mpz_set(search->r, r);
+    search->foundWindow = window;
+  }
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_unlock(&search->lock);
+#endif
+}
+
+// Stops every worker with the status of a failed random generation.
+static void random_failedPairingPrime(PairingPrimeSearch *search,
+                                      const CryptidStatus status) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&search->lock);
+#endif
+  search->status = status;
+  search->foundWindow = 0;
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_unlock(&search->lock);
+#endif
+}
+
+// Draws the starting point \f$r_0\f$ of a window from a generator derived from
+// the seed of the search and the index of the window.
+static CryptidStatus random_pairingPrimeStart(mpz_t r0,
+                                              PairingPrimeSearch *search,
+                                              const unsigned long window) {
+  unsigned char nonce[sizeof(unsigned long)];
+  for (size_t i = 0; i < sizeof(nonce); i++) {
+    nonce[i] = (unsigned char)(window >> (8 * (sizeof(nonce) - 1 - i)));
+  }
+
+  HmacDrbg generator;
+  hmacDrbg_instantiate(&generator, search->seed, PAIRING_PRIME_SEED_LENGTH,
+                       nonce, sizeof(nonce), NULL, 0);
+
+  CryptidStatus status =
+      random_mpzOfLengthFrom(r0, search->rBitLength, &generator);
+
+  hmacDrbg_destroy(&generator);
+
+  return status;
+}
+
+static void random_searchPairingPrime(void *argument, const int taskIndex,
+                                      const int taskCount) {
+  // Incremental search: a random \f$r_0\f$ is drawn, and the candidates
+  // \f$p_i = 12 \cdot (r_0 + i) \cdot q - 1\f$ of a window are sieved by the
+  // small primes, so most composites are rejected without any modular
+  // exponentiation. \f$p_i \equiv 0 \pmod{s}\f$ exactly for the \f$i\f$ in
+  // one residue class modulo \f$s\f$, found from \f$p_0 \bmod s\f$.
+  //
+  // The windows are numbered, and the worker of index \f$t\f$ searches the
+  // windows \f$t, t + T, t + 2T, \ldots\f$ of the \f$T\f$ workers. A worker
+  // stops once an earlier window than its current one has a prime, so the
+  // first prime of the first window containing one is the result, whatever
+  // the number of workers and their timing.
+  PairingPrimeSearch *const search = (PairingPrimeSearch *)argument;
+  const unsigned int windowSize = search->windowSize;
+  unsigned char *isComposite = malloc(windowSize);
+
+  mpz_t r0, p0, r, p, offset;
+  mpz_inits(r0, p0, r, p, offset, NULL);
+
+  for (unsigned long window = taskIndex;
+       window < random_pairingPrimeFoundWindow(search); window += taskCount) {
+    CryptidStatus status = random_pairingPrimeStart(r0, search, window);
+    if (status) {
+      random_failedPairingPrime(search, status);
+      break;
+    }
+
+    mpz_mul(p0, search->step, r0);
+    mpz_sub_ui(p0, p0, 1);
+
+    memset(isComposite, 0, windowSize);
+    for (int j = 0; j < search->primeCount; j++) {
+      const unsigned long s = search->primes[j];
+
+      // Then \f$p_i \equiv -1 \pmod{s}\f$ for every \f$i\f$.
+      if (search->stepInverses[j] == 0) {
+        continue;
+      }
+
+      const unsigned long pModS = mpz_fdiv_ui(p0, s);
+      const unsigned long first =
+          (unsigned long)((unsigned long long)((s - pModS) % s) *
+                          search->stepInverses[j] % s);
+
+      for (unsigned long i = first; i < windowSize; i += s) {
+        isComposite[i] = 1;
+      }
+    }
+
+    for (unsigned int i = 0; i < windowSize; i++) {
+      if (isComposite[i]) {
+        continue;
+      }
+
+      mpz_add_ui(r, r0, i);
+      if (mpz_sizeinbase(r, 2) > search->rBitLength) {
+        break;
+      }
+
+      // \f$r = 0\f$ would give \f$p = -1\f$.
+      if (mpz_sgn(r) == 0) {
+        continue;
+      }
+
+      mpz_mul_ui(offset, search->step, i);
+      mpz_add(p, p0, offset);
+
+      if (primalityTest_isProbablePrime(p, primalityTest_GENERATION)) {
+        random_foundPairingPrime(search, window, p, r);
+        break;
+      }
+
+      if (random_pairingPrimeFoundWindow(search) < window) {
+        break;
+      }
+    }
+  }
+
+  free(isComposite);
+  mpz_clears(r0, p0, r, p, offset, NULL);
+}
+
+CryptidStatus random_pairingPrime(mpz_t p, mpz_t r, const mpz_t q,
+                                  const unsigned int rBitLength) {
+  PairingPrimeSearch search;
+
+  CryptidStatus status = random_bytes(search.seed, PAIRING_PRIME_SEED_LENGTH);
+  if (status) {
+    memset(search.seed, 0, PAIRING_PRIME_SEED_LENGTH);
+    return status;
+  }
+
+  search.p = p;
+  search.r = r;
+  search.rBitLength = rBitLength;
+  // A few times longer than the expected distance to a prime.
+  search.windowSize = 2 * rBitLength + 64;
+  search.primeCount = random_smallPrimes(&search.primes, SIEVE_PRIME_BOUND);
+  search.stepInverses = malloc(search.primeCount * sizeof(unsigned long));
+  search.foundWindow = PAIRING_PRIME_NO_WINDOW;
+  search.status = CRYPTID_SUCCESS;
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_init(&search.lock, NULL);
+#endif
+
+  mpz_init(search.step);
+  mpz_mul_ui(search.step, q, 12);
+
+  for (int j = 0; j < search.primeCount; j++) {
+    const unsigned long stepModS = mpz_fdiv_ui(search.step, search.primes[j]);
+
+    search.stepInverses[j] =
+        stepModS ? random_inverseModSmallPrime(stepModS, search.primes[j]) : 0;
+  }
+
+  parallel_run(random_searchPairingPrime, &search, parallel_threadCount());
+
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_destroy(&search.lock);
+#endif
+  mpz_clear(search.step);
+  free(search.primes);
+  free(search.stepInverses);
+  memset(search.seed, 0, PAIRING_PRIME_SEED_LENGTH);
+
+  return search.status;
 }
 
 CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
                                   const unsigned int attemptLimit) {
+  unsigned int *primes;
+  const int primeCount =
+      random_smallPrimes(&primes, TRIAL_DIVISION_PRIME_BOUND);
+
   unsigned int random = 0, lastrandom;
   unsigned int isPrimeGenerated = 0;
   unsigned int attempts = 0;
@@ -64,7 +501,13 @@ CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
   while ((attempts < attemptLimit) && !isPrimeGenerated) {
     lastrandom = random;
 
-    random_unsignedIntInRange(&random, numberOfBits - (lastrandom + 1));
+    CryptidStatus status =
+        random_unsignedIntInRange(&random, numberOfBits - (lastrandom + 1));
+    if (status) {
+      free(primes);
+      return status;
+    }
+
     random += lastrandom;
     for (unsigned int i = random; i > lastrandom; i--) {
       mpz_ui_pow_ui(result, 2, numberOfBits);
@@ -78,7 +521,8 @@ CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
 
       mpz_sub_ui(result, result, 1);
 
-      if (primalityTest_isProbablePrime(result)) {
+      if (!random_hasSmallFactor(result, primes, primeCount) &&
+          primalityTest_isProbablePrime(result, primalityTest_GENERATION)) {
         isPrimeGenerated = 1;
         break;
       }
@@ -87,18 +531,26 @@ CryptidStatus random_solinasPrime(mpz_t result, const unsigned int numberOfBits,
     attempts++;
   }
 
+  free(primes);
+
   return isPrimeGenerated ? CRYPTID_SUCCESS
                           : CRYPTID_ATTEMPT_LIMIT_REACHED_ERROR;
 }
 
-static AffinePoint
-mod3PointGenerationStrategy(const EllipticCurve ellipticCurve) {
+static CryptidStatus
+mod3PointGenerationStrategy(AffinePoint *result,
+                            const EllipticCurve ellipticCurve) {
   size_t numberOfBits = mpz_sizeinbase(ellipticCurve.fieldOrder, 2);
 
   mpz_t y, bAddInv, exp, ySquared, base, x;
   mpz_inits(y, bAddInv, exp, ySquared, base, x, NULL);
 
-  random_mpzOfLength(y, numberOfBits);
+  CryptidStatus status = random_mpzOfLength(y, numberOfBits);
+  if (status) {
+    mpz_clears(y, bAddInv, exp, ySquared, base, x, NULL);
+    return status;
+  }
+
   mpz_mod(y, y, ellipticCurve.fieldOrder);
 
   mpz_sub(bAddInv, ellipticCurve.fieldOrder, ellipticCurve.b);
@@ -114,12 +566,11 @@ mod3PointGenerationStrategy(const EllipticCurve ellipticCurve) {
 
   mpz_powm(x, base, exp, ellipticCurve.fieldOrder);
 
-  AffinePoint result;
-  affine_init(&result, x, y);
+  affine_init(result, x, y);
 
   mpz_clears(y, bAddInv, exp, ySquared, base, x, NULL);
 
-  return result;
+  return CRYPTID_SUCCESS;
 }
 
 CryptidStatus random_affinePoint(AffinePoint *result,
@@ -129,7 +580,10 @@ CryptidStatus random_affinePoint(AffinePoint *result,
   int isPointGenerated = 0;
 
   do {
-    *result = mod3PointGenerationStrategy(ellipticCurve);
+    CryptidStatus status = mod3PointGenerationStrategy(result, ellipticCurve);
+    if (status) {
+      return status;
+    }
 
     if (affine_isOnCurve(*result, ellipticCurve)) {
       isPointGenerated = 1;
@@ -1,8 +1,7 @@
-#include <math.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "util/Parallel.h"
 #include "util/Utils.h"
 
 // References
@@ -10,91 +9,81 @@
 //  Cryptography Standard (IBCS) #1: Supersingular Curve Implementations of the
 //  BF and BB1 Cryptosystems
 
+static const int MOST_SIGNIFICANT_WORD_FIRST = 1;
+static const int NATIVE_ENDIANNESS = 0;
+static const size_t NO_SKIP = 0;
+
 void hashToRange(mpz_t result, const unsigned char *const s, const int sLength,
                  const mpz_t p, const HashFunction hashFunction) {
   // Implementation of Algorithm 4.1.1 (HashToRange) in [RFC-5091].
 
-  mpz_t v, a, twoFiveSix, twoFiveSixPow, vxTwoFiveSixPow;
-  mpz_inits(v, a, twoFiveSix, twoFiveSixPow, vxTwoFiveSixPow, NULL);
-
   // Let {@code hashlen} be the number of octets comprising the output of {@code
   // hashfcn}.
   int hashLen;
   hashFunction_getHashSize(&hashLen, hashFunction);
 
-  // Let \f$v_{0} = 0\f$.
-  mpz_set_ui(v, 0);
-
+  // The strings \f$h_0 || h_1 || h_2\f$. As
+  // \f$v_2 = 256^{\mathrm{hashlen}} \cdot a_1 + a_2\f$, the last two are
+  // exactly the big-endian representation of \f$v_2\f$.
   // Let \f$h_{0} = 00...00\f$, a string of null octets with a length of {@code
   // hashlen}.
-  unsigned char *h =
-      (unsigned char *)calloc(hashLen + 1, sizeof(unsigned char));
-  h[hashLen] = '\0';
-  unsigned char *t =
-      (unsigned char *)calloc(hashLen + sLength + 1, sizeof(unsigned char));
-  unsigned char *hexString =
-      (unsigned char *)calloc(hashLen * 2 + 1, sizeof(unsigned char));
-  unsigned char hex[3] = "\0\0\0";
+  unsigned char h[3 * HASHFUNCTION_MAX_HASH_SIZE] = {0};
 
   // {@code For i = 1 to 2, do:}
   for (int i = 1; i < 3; i++) {
     // Let \f$t_{i} = h_{(i - 1)} || s\f$, which is the \f$(|s| +
     // {mathrm{hashlen})\f$-octet string concatenation of the strings \f$h_{(i -
     // 1)} and s\f$.
-    for (int i = 0; i < hashLen; i++) {
-      t[i] = h[i];
-    }
-    for (int i = 0; i < sLength; i++) {
-      t[hashLen + i] = s[i];
-    }
-    t[hashLen + sLength] = '\0';
-
     // Let \f$h_{i} = \mathrm{hashfcn}(t_i)\f$, which is a {@code hashlen}-octet
     // string resulting from the hash algorithm {@code hashfcn} on the input
-    // \f$t_i\f$.
-    hashFunction_hash(h, t, hashLen + sLength, hashFunction);
-
-    // Let \f$a_i = \mathrm{Value}(h_i)\f$ be the integer in the range \f$0\f$
-    // to \f$256^{\mathrm{hashlen}} - 1\f$ denoted by the raw octet string
-    // \f$h_i\f$ interpreted in the unsigned big-endian convention.
-    for (int j = 0; j < hashLen; j++) {
-      sprintf((char *)hex, "%02X", h[j]);
-      hexString[j * 2] = hex[0];
-      hexString[j * 2 + 1] = hex[1];
-    }
-    hexString[2 * hashLen] = '\0';
-
-    mpz_set_str(a, (char *)hexString, 16);
-
-    // Let \f$v_i = 256^{\mathrm{hashlen}} \cdot v_{(i - 1)} + a_i\f$.
-    mpz_set_ui(twoFiveSix, 256);
-    mpz_pow_ui(twoFiveSixPow, twoFiveSix, hashLen);
-    mpz_mul(vxTwoFiveSixPow, v, twoFiveSixPow);
-
-    mpz_clear(v);
-    mpz_init(v);
-    mpz_add(v, vxTwoFiveSixPow, a);
+    // \f$t_i\f$. The concatenation is fed to the hash function piecewise.
+    HashFunctionContext context;
+    hashFunction_initContext(&context, hashFunction);
+    hashFunction_update(&context, h + (i - 1) * hashLen, hashLen);
+    hashFunction_update(&context, s, sLength);
+    hashFunction_final(h + i * hashLen, &context);
   }
 
+  // Let \f$a_i = \mathrm{Value}(h_i)\f$ be the integer in the range \f$0\f$
+  // to \f$256^{\mathrm{hashlen}} - 1\f$ denoted by the raw octet string
+  // \f$h_i\f$ interpreted in the unsigned big-endian convention.
+  // Let \f$v_i = 256^{\mathrm{hashlen}} \cdot v_{(i - 1)} + a_i\f$.
+  mpz_t v;
+  mpz_init(v);
+  mpz_import(v, 2 * hashLen, MOST_SIGNIFICANT_WORD_FIRST, sizeof(h[0]),
+             NATIVE_ENDIANNESS, NO_SKIP, h + hashLen);
+
   // Let \f$v = v_l \mod n\f$.
   mpz_mod(result, v, p);
 
-  free(h);
-  free(t);
-  free(hexString);
-  mpz_clears(v, a, twoFiveSix, twoFiveSixPow, vxTwoFiveSixPow, NULL);
+  mpz_clear(v);
 }
 
 CryptidStatus hashToPoint(AffinePoint *result, const char *const id,
                           const int idLength, const mpz_t q,
                           const EllipticCurve ellipticCurve,
                           const HashFunction hashFunction) {
+  mpz_t pAddOne, pAddOneQq;
+  mpz_inits(pAddOne, pAddOneQq, NULL);
+
+  mpz_add_ui(pAddOne, ellipticCurve.fieldOrder, 1);
+  mpz_cdiv_q(pAddOneQq, pAddOne, q);
+
+  CryptidStatus status = hashToPointWithCofactor(
+      result, id, idLength, pAddOneQq, ellipticCurve, hashFunction);
+
+  mpz_clears(pAddOne, pAddOneQq, NULL);
+  return status;
+}
+
+CryptidStatus hashToPointWithCofactor(AffinePoint *result, const char *const id,
+                                      const int idLength, const mpz_t cofactor,
+                                      const EllipticCurve ellipticCurve,
+                                      const HashFunction hashFunction) {
   // Implementation of Algorithm 4.4.2 (HashToPoint1) in [RFC-5091].
 
-  mpz_t y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, yPowTwoSub, pAddOne,
-      pAddOneQq;
-  mpz_inits(y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, yPowTwoSub, pAddOne,
-            pAddOneQq, NULL);
+  mpz_t y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo;
+  mpz_inits(y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, NULL);
 
   // Let \f$y = \mathrm{HashToRange}(id, p, \mathrm{hashfcn})\f$, using {@code
   // HashToRange}, an element of \f$F_p\f$.
@@ -116,24 +105,31 @@ CryptidStatus hashToPoint(AffinePoint *result, const char *const id,
   AffinePoint qPrime;
   affine_init(&qPrime, x, y);
 
-  mpz_add_ui(pAddOne, ellipticCurve.fieldOrder, 1);
-  mpz_cdiv_q(pAddOneQq, pAddOne, q);
-
   // Let \f$Q = [(p + 1) / q ]Q^{\prime}\f$, a point of order \f$q\f$ in
   // \f$E(F_p)\f$.
   CryptidStatus status =
-      affine_wNAFMultiply(result, qPrime, pAddOneQq, ellipticCurve);
-  if (status) {
-    mpz_clears(y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, yPowTwoSub, pAddOne,
-               pAddOneQq, NULL);
-    affine_destroy(qPrime);
-    return status;
-  }
+      affine_wNAFMultiply(result, qPrime, cofactor, ellipticCurve);
 
-  mpz_clears(y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, yPowTwoSub, pAddOne,
-             pAddOneQq, NULL);
+  mpz_clears(y, x, pxTwo, pxTwoSub, pxTwoSubQ3, yPowTwo, NULL);
   affine_destroy(qPrime);
-  return CRYPTID_SUCCESS;
+  return status;
+}
+
+// Writes the big-endian zero-padded fixed-length octet string representation of
+// an element of \f$Z_p\f$ into the length octets of result.
+static void canonical_exportPadded(unsigned char *result, const size_t length,
+                                   const mpz_t value, const mpz_t p) {
+  mpz_t reduced;
+  mpz_init(reduced);
+  mpz_mod(reduced, value, p);
+
+  const size_t valueLength =
+      mpz_sgn(reduced) ? (mpz_sizeinbase(reduced, 2) + 7) / 8 : 0;
+  memset(result, 0, length - valueLength);
+  mpz_export(result + length - valueLength, NULL, MOST_SIGNIFICANT_WORD_FIRST,
+             sizeof(result[0]), NATIVE_ENDIANNESS, NO_SKIP, reduced);
+
+  mpz_clear(reduced);
 }
 
 void canonical(unsigned char **result, int *const resultLength, const Complex v,
@@ -142,80 +138,94 @@ void canonical(unsigned char **result, int *const resultLength, const Complex v,
 
   // Let \f$l = \mathrm{Ceiling}(\frac{\log(p)}{8})\f$, the number of octets
   // needed to represent integers in \f$Z_p\f$.
-  char *bytes = mpz_get_str(NULL, 16, p);
-  size_t outputSize = strlen(bytes);
+  const size_t l = (mpz_sizeinbase(p, 2) + 7) / 8;
+
+  *result = (unsigned char *)malloc(2 * l);
 
   // Let \f$v = a + b \cdot i\f$, where \f$i^2 = -1\f$.
   // Let \f$a_{256^l}\f$ be the big-endian zero-padded fixed-length octet string
   // representation of \f$a\f$ in \f$Z_p\f$. Let \f$b_{256^l}\f$ be the
   // big-endian zero-padded fixed-length octet string representation of \f$b\f$
   // in \f$Z_p\f$.
-  char *realPartHexString = mpz_get_str(NULL, 16, v.real);
-  char *imagPartHexString = mpz_get_str(NULL, 16, v.imaginary);
-
-  *result = (unsigned char *)calloc(outputSize, sizeof(unsigned char));
-  unsigned char *resultHexString =
-      (unsigned char *)calloc(2 * outputSize + 1, sizeof(unsigned char));
-  int index = 0;
-
+  //
   // If the {@code order} is {@code 0}, then let \f$s = a_{256^l} ||
   // b_{256^l}\f$, which is the concatenation of \f$a_{256^l}\f$ followed by
   // \f$b_{256^l}\f$.
-  if (order == 0) {
-    for (size_t i = 0; i < outputSize; i++) {
-      if (strlen(realPartHexString) + i < outputSize) {
-        resultHexString[i] = 0;
-        index++;
-      } else {
-        resultHexString[i] = realPartHexString[i - index];
-      }
-    }
-    index = 0;
-    for (size_t i = 0; i < outputSize; i++) {
-      if (strlen(imagPartHexString) + i < outputSize) {
-        resultHexString[outputSize + i] = 0;
-        index++;
-      } else {
-        resultHexString[outputSize + i] = imagPartHexString[i - index];
-      }
-    }
-  }
   // If the {@code order} is {@code 1}, then let \f$s = b_{256^l} ||
-  // a_{256^l}\f$, which is the concatenation of \f$a_{256^l}\f$ followed by
-  // \f$b_{256^l}\f$.
-  else {
-    for (size_t i = 0; i < outputSize; i++) {
-      if (strlen(imagPartHexString) + i < outputSize) {
-        resultHexString[i] = 0;
-        index++;
-      } else {
-        resultHexString[i] = imagPartHexString[i - index];
-      }
-    }
-    index = 0;
-    for (size_t i = 0; i < outputSize; i++) {
-      if (strlen(realPartHexString) + i < outputSize) {
-        resultHexString[outputSize + i] = 0;
-        index++;
-      } else {
-        resultHexString[outputSize + i] = realPartHexString[i - index];
-      }
-    }
-  }
+  // a_{256^l}\f$, which is the concatenation of \f$b_{256^l}\f$ followed by
+  // \f$a_{256^l}\f$.
+  const size_t realOffset = order == 0 ? 0 : l;
+  const size_t imaginaryOffset = order == 0 ? l : 0;
+  canonical_exportPadded(*result + realOffset, l, v.real, p);
+  canonical_exportPadded(*result + imaginaryOffset, l, v.imaginary, p);
+
+  *resultLength = 2 * l;
+}
 
-  resultHexString[2 * outputSize] = '\0';
+// Every thread of hashBytes derives at least this many octets, so small
+// outputs are not worth the cost of starting threads.
+static const int HASH_BYTES_OCTETS_PER_THREAD = 1 << 15;
 
-  unsigned char *pos = resultHexString;
-  for (size_t i = 0; i < outputSize; i++) {
-    sscanf((char *)pos, "%2hhx", *result + i);
-    pos += 2;
-  }
+// The number of blocks of hashBytes passed to the multi-buffer hash at once.
+#define HASH_BYTES_BATCH_SIZE 16
 
-  free(bytes);
-  free(realPartHexString);
-  free(imagPartHexString);
-  free(resultHexString);
-  *resultLength = outputSize;
+typedef struct HashBytesBlocks {
+  unsigned char *blocks;
+  int blockCount;
+  const unsigned char *k;
+  int hashLen;
+  HashFunction hashFunction;
+} HashBytesBlocks;
+
+static void hashBytes_hashBlock(unsigned char *const ri,
+                                const unsigned char *const hi,
+                                const unsigned char *const k,
+                                const int hashLen,
+                                const HashFunction hashFunction) {
+  // Let \f$r_i = \mathrm{hashfcn}(h_i || k)\f$, where \f$h_i || k\f$ is the
+  // \f$(2 \cdot \mathrm{hashlen})\f$-octet concatenation of \f$h_i\f$ and
+  // \f$k\f$, fed to the hash function piecewise.
+  HashFunctionContext context;
+  hashFunction_initContext(&context, hashFunction);
+  hashFunction_update(&context, hi, hashLen);
+  hashFunction_update(&context, k, hashLen);
+  hashFunction_final(ri, &context);
+}
+
+static void hashBytes_hashBlocks(void *argument, const int taskIndex,
+                                 const int taskCount) {
+  const HashBytesBlocks *const blocks = (const HashBytesBlocks *)argument;
+
+  const int first =
+      (int)((long long)blocks->blockCount * taskIndex / taskCount);
+  const int last =
+      (int)((long long)blocks->blockCount * (taskIndex + 1) / taskCount);
+
+  // The blocks are independent, so they are hashed in batches by the
+  // multi-buffer hash, each \f$h_i || k\f$ copied next to each other.
+  const int hashLen = blocks->hashLen;
+  unsigned char concatenations[HASH_BYTES_BATCH_SIZE]
+                              [2 * HASHFUNCTION_MAX_HASH_SIZE];
+  const unsigned char *messages[HASH_BYTES_BATCH_SIZE];
+  size_t messageLengths[HASH_BYTES_BATCH_SIZE];
+  unsigned char *hashResults[HASH_BYTES_BATCH_SIZE];
+
+  for (int i = first; i < last; i += HASH_BYTES_BATCH_SIZE) {
+    const int batchSize =
+        last - i < HASH_BYTES_BATCH_SIZE ? last - i : HASH_BYTES_BATCH_SIZE;
+
+    for (int j = 0; j < batchSize; j++) {
+      hashResults[j] = blocks->blocks + (i + j) * hashLen;
+
+      memcpy(concatenations[j], hashResults[j], hashLen);
+      memcpy(concatenations[j] + hashLen, blocks->k, hashLen);
+      messages[j] = concatenations[j];
+      messageLengths[j] = 2 * hashLen;
+    }
+
+    hashFunction_hashMany(hashResults, messages, messageLengths, batchSize,
+                          blocks->hashFunction);
+  }
 }
 
 void hashBytes(unsigned char **result, const int b,
@@ -231,60 +241,58 @@ void hashBytes(unsigned char **result, const int b,
   hashFunction_getHashSize(&hashLen, hashFunction);
 
   // Let \f$k = \mathrm{hashfcn}(p)\f$.
-  unsigned char *k = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
+  unsigned char k[HASHFUNCTION_MAX_HASH_SIZE];
   hashFunction_hash(k, p, pLength, hashFunction);
 
   // Let \f$h_0 = 00...00\f$, a string of null octets with a length of {@code
   // hashlen}.
-  unsigned char *h = (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  for (int i = 0; i < hashLen; i++) {
-    h[i] = 0;
-  }
+  unsigned char h[HASHFUNCTION_MAX_HASH_SIZE] = {0};
 
   // Let \f$l = \mathrm{Ceiling}(\frac{b}{\mathrm{hashlen}}).
-  int l = (int)ceil((double)b / (double)hashLen);
-
-  int generatedOctets = 0;
-  int didGenerateEnough = 0;
-  unsigned char *concat =
-      (unsigned char *)calloc(2 * hashLen, sizeof(unsigned char));
-  unsigned char *resultPart =
-      (unsigned char *)calloc(hashLen, sizeof(unsigned char));
-  // {@code For each i in 1 to l, do:}
-  for (int i = 1; i <= l && !didGenerateEnough; i++) {
-    // Let \f$h_i = \mathrm{hashfcn}(h_{i - 1}).
-    hashFunction_hash(h, h, hashLen, hashFunction);
+  int l = (b + hashLen - 1) / hashLen;
+
+  // Only the chain \f$h_i = \mathrm{hashfcn}(h_{i - 1})\f$ is sequential, the
+  // blocks \f$r_i\f$ only depend on their own \f$h_i\f$. So the chain of every
+  // full block is computed first, each \f$h_i\f$ stored where \f$r_i\f$ goes,
+  // and then the \f$r_i\f$ are computed in place, split across threads.
+  // Let \f$r = \mathrm{LeftmostOctets}(b, r_1 || ... || r_l)\f$, i.e.,
+  // \f$r\f$ is formed as the concatenation of the \f$r_i\f$, truncated to the
+  // desired number of octets.
+  const int fullBlockCount = b / hashLen;
+
+  const unsigned char *hi = h;
+  for (int i = 0; i < fullBlockCount; i++) {
+    unsigned char *const block = *result + i * hashLen;
+    hashFunction_hash(block, hi, hashLen, hashFunction);
+    hi = block;
+  }
 
-    // Let \f$r_i = \mathrm{hashfcn}(h_i || k)\f$, where \f$h_i || k\f$ is the
-    // \f$(2 \cdot \mathrm{hashlen})\f$-octet concatenation of \f$h_i\f$ and
-    // \f$k\f$.
-    for (int j = 0; j < hashLen; j++) {
-      concat[j] = h[j];
-    }
-    for (int j = 0; j < hashLen; j++) {
-      concat[hashLen + j] = k[j];
-    }
+  int threadCount = fullBlockCount * hashLen / HASH_BYTES_OCTETS_PER_THREAD;
+  if (threadCount > parallel_threadCount()) {
+    threadCount = parallel_threadCount();
+  }
 
-    hashFunction_hash(resultPart, concat, 2 * hashLen, hashFunction);
-
-    // Let \f$r = \mathrm{LeftmostOctets}(b, r_1 || ... || r_l)\f$, i.e.,
-    // \f$r\f$ is formed as the concatenation of the \f$r_i\f$, truncated to the
-    // desired number of octets.
-    for (int j = 0; j < hashLen; j++) {
-      if (generatedOctets + j < b) {
-        (*result)[generatedOctets + j] = resultPart[j];
-      } else {
-        didGenerateEnough = 1;
-        break;
-      }
-    }
-    generatedOctets += hashLen;
+  if (fullBlockCount > 0) {
+    HashBytesBlocks blocks = {*result, fullBlockCount, k, hashLen,
+                              hashFunction};
+
+    // The chain continues from the last full block, which is overwritten.
+    memcpy(h, hi, hashLen);
+
+    parallel_run(hashBytes_hashBlocks, &blocks,
+                 threadCount > 1 ? threadCount : 1);
   }
 
-  (*result)[b] = '\0';
+  // A partial last block goes through a temporary.
+  if (fullBlockCount < l) {
+    unsigned char resultPart[HASHFUNCTION_MAX_HASH_SIZE];
+
+    hashFunction_hash(h, h, hashLen, hashFunction);
+    hashBytes_hashBlock(resultPart, h, k, hashLen, hashFunction);
 
-  free(k);
-  free(h);
-  free(concat);
-  free(resultPart);
+    memcpy(*result + fullBlockCount * hashLen, resultPart,
+           b - fullBlockCount * hashLen);
+  }
+
+  (*result)[b] = '\0';
 }
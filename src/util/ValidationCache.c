@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/ValidationCache.h"
+
+#if defined(__CRYPTID_PTHREADS)
+#include <pthread.h>
+
+static pthread_mutex_t validationCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// The fingerprints, the most recently used first.
+static unsigned char validationCacheEntries[VALIDATIONCACHE_CAPACITY]
+                                          [VALIDATIONCACHE_FINGERPRINT_SIZE];
+static int validationCacheSize = 0;
+static unsigned long validationCacheGeneration = 0;
+
+static void validationCache_lock(void) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_lock(&validationCacheLock);
+#endif
+}
+
+static void validationCache_unlock(void) {
+#if defined(__CRYPTID_PTHREADS)
+  pthread_mutex_unlock(&validationCacheLock);
+#endif
+}
+
+// Moves the entry at index to the front, shifting the ones before it back.
+static void
+validationCache_moveToFront(const int index,
+                            const unsigned char *const fingerprint) {
+  memmove(validationCacheEntries[1], validationCacheEntries[0],
+          index * VALIDATIONCACHE_FINGERPRINT_SIZE);
+  memcpy(validationCacheEntries[0], fingerprint,
+         VALIDATIONCACHE_FINGERPRINT_SIZE);
+}
+
+static int validationCache_indexOf(const unsigned char *const fingerprint) {
+  for (int i = 0; i < validationCacheSize; i++) {
+    if (!memcmp(validationCacheEntries[i], fingerprint,
+                VALIDATIONCACHE_FINGERPRINT_SIZE)) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+void validationCache_fingerprintInit(HashFunctionContext *contextOutput,
+                                     const char *const kind) {
+  hashFunction_initContext(contextOutput, hashFunction_SHA256);
+
+  // The terminating zero separates the kind from the fields.
+  hashFunction_update(contextOutput, (const unsigned char *)kind,
+                      strlen(kind) + 1);
+}
+
+void validationCache_fingerprintAddInteger(HashFunctionContext *context,
+                                           const mpz_t integer) {
+  // The sign, the length of the magnitude as four octets, then the magnitude,
+  // all big-endian, so the encoding of a sequence of fields is unambiguous.
+  const size_t length = (mpz_sizeinbase(integer, 2) + 7) / 8;
+  unsigned char header[5];
+
+  header[0] = (unsigned char)(mpz_sgn(integer) + 1);
+  for (int i = 0; i < 4; i++) {
+    header[1 + i] = (unsigned char)(length >> (8 * (3 - i)));
+  }
+  hashFunction_update(context, header, sizeof(header));
+
+  if (mpz_sgn(integer) == 0) {
+    return;
+  }
+
+  unsigned char *magnitude = malloc(length);
+  mpz_export(magnitude, NULL, 1, 1, 1, 0, integer);
+  hashFunction_update(context, magnitude, length);
+  free(magnitude);
+}
+
+void validationCache_fingerprintAddUnsigned(HashFunctionContext *context,
+                                            const unsigned long value) {
+  unsigned char octets[8];
+
+  for (int i = 0; i < 8; i++) {
+    octets[i] = (unsigned char)((unsigned long long)value >> (8 * (7 - i)));
+  }
+  hashFunction_update(context, octets, sizeof(octets));
+}
+
+void validationCache_fingerprintFinal(unsigned char *fingerprintOutput,
+                                      HashFunctionContext *context) {
+  hashFunction_final(fingerprintOutput, context);
+}
+
+CryptidValidationResult
+validationCache_contains(const unsigned char *const fingerprint) {
+  validationCache_lock();
+
+  const int index = validationCache_indexOf(fingerprint);
+  if (index >= 0) {
+    validationCache_moveToFront(index, fingerprint);
+  }
+
+  validationCache_unlock();
+
+  return index >= 0 ? CRYPTID_VALIDATION_SUCCESS : CRYPTID_VALIDATION_FAILURE;
+}
+
+unsigned long validationCache_generation(void) {
+  validationCache_lock();
+  const unsigned long generation = validationCacheGeneration;
+  validationCache_unlock();
+
+  return generation;
+}
+
+void validationCache_add(const unsigned char *const fingerprint,
+                         const unsigned long generation) {
+  validationCache_lock();
+
+  // The object was validated under a policy that no longer applies.
+  if (generation != validationCacheGeneration) {
+    validationCache_unlock();
+    return;
+  }
+
+  int index = validationCache_indexOf(fingerprint);
+  if (index < 0) {
+    // Evicts the least recently used entry if the cache is full.
+    if (validationCacheSize < VALIDATIONCACHE_CAPACITY) {
+      validationCacheSize++;
+    }
+    index = validationCacheSize - 1;
+  }
+  validationCache_moveToFront(index, fingerprint);
+
+  validationCache_unlock();
+}
+
+void validationCache_invalidate(void) {
+  validationCache_lock();
+
+  memset(validationCacheEntries, 0, sizeof(validationCacheEntries));
+  validationCacheSize = 0;
+  validationCacheGeneration++;
+
+  validationCache_unlock();
+}
@@ -96,6 +96,237 @@ TEST fresh_boneh_franklin_ibe_setup_different_identities(
   PASS();
 }
 
+TEST fresh_boneh_franklin_ibe_setup_reused_context(
+    const SecurityLevel securityLevel, const char *const message,
+    const char *const identity) {
+  BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary publicParameters;
+  BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary masterSecret;
+
+  CryptidStatus status = cryptid_ibe_bonehFranklin_setup(
+      &masterSecret, &publicParameters, securityLevel);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  BonehFranklinIdentityBasedEncryptionContext context;
+  status = cryptid_ibe_bonehFranklin_createContext(&context, publicParameters);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  AffinePointAsBinary privateKey;
+  status = cryptid_ibe_bonehFranklin_extractWithContext(
+      &privateKey, identity, strlen(identity), masterSecret, &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  for (int i = 0; i < 3; i++) {
+    BonehFranklinIdentityBasedEncryptionCiphertextAsBinary ciphertext;
+    status = cryptid_ibe_bonehFranklin_encryptWithContext(
+        &ciphertext, message, strlen(message), identity, strlen(identity),
+        &context);
+
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+    char *plaintext;
+    status = cryptid_ibe_bonehFranklin_decryptWithContext(
+        &plaintext, ciphertext, privateKey, &context);
+
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+    ASSERT_EQ(strcmp(message, plaintext), 0);
+
+    free(plaintext);
+    bonehFranklinIdentityBasedEncryptionCiphertextAsBinary_destroy(ciphertext);
+  }
+
+  cryptid_ibe_bonehFranklin_destroyContext(&context);
+  affineAsBinary_destroy(privateKey);
+  free(masterSecret.masterSecret);
+  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_destroy(
+      publicParameters);
+
+  PASS();
+}
+
+TEST fresh_boneh_franklin_ibe_setup_identity_cache(
+    const SecurityLevel securityLevel, const char *const message) {
+  BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary publicParameters;
+  BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary masterSecret;
+
+  CryptidStatus status = cryptid_ibe_bonehFranklin_setup(
+      &masterSecret, &publicParameters, securityLevel);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  BonehFranklinIdentityBasedEncryptionContext context;
+  status = cryptid_ibe_bonehFranklin_createContext(&context, publicParameters);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  // A single entry, so alternating between the identities evicts every time.
+  cryptid_ibe_bonehFranklin_enableIdentityCache(&context, 1);
+
+  const char *const identities[] = {"alice", "alice", "bob", "alice", "bob"};
+  for (int i = 0; i < 5; i++) {
+    const char *const identity = identities[i];
+
+    AffinePointAsBinary privateKey;
+    status = cryptid_ibe_bonehFranklin_extractWithContext(
+        &privateKey, identity, strlen(identity), masterSecret, &context);
+
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+    BonehFranklinIdentityBasedEncryptionCiphertextAsBinary ciphertext;
+    status = cryptid_ibe_bonehFranklin_encryptWithContext(
+        &ciphertext, message, strlen(message), identity, strlen(identity),
+        &context);
+
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+    char *plaintext;
+    status = cryptid_ibe_bonehFranklin_decryptWithContext(
+        &plaintext, ciphertext, privateKey, &context);
+
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+    ASSERT_EQ(strcmp(message, plaintext), 0);
+
+    free(plaintext);
+    bonehFranklinIdentityBasedEncryptionCiphertextAsBinary_destroy(ciphertext);
+    affineAsBinary_destroy(privateKey);
+  }
+
+  cryptid_ibe_bonehFranklin_destroyContext(&context);
+  free(masterSecret.masterSecret);
+  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_destroy(
+      publicParameters);
+
+  PASS();
+}
+
+// Feeds length octets to the update function in pieces of pieceLength octets.
+static CryptidStatus streamInPieces(
+    CryptidStatus (*update)(BonehFranklinIdentityBasedEncryptionStream *,
+                            unsigned char *, const unsigned char *const,
+                            const size_t),
+    BonehFranklinIdentityBasedEncryptionStream *stream, unsigned char *output,
+    const unsigned char *const input, const size_t length,
+    const size_t pieceLength) {
+  for (size_t offset = 0; offset < length; offset += pieceLength) {
+    const size_t count =
+        length - offset < pieceLength ? length - offset : pieceLength;
+    CryptidStatus status =
+        update(stream, output + offset, input + offset, count);
+    if (status) {
+      return status;
+    }
+  }
+
+  return CRYPTID_SUCCESS;
+}
+
+TEST fresh_boneh_franklin_ibe_setup_stream(const SecurityLevel securityLevel,
+                                           const size_t payloadLength) {
+  BonehFranklinIdentityBasedEncryptionPublicParametersAsBinary publicParameters;
+  BonehFranklinIdentityBasedEncryptionMasterSecretAsBinary masterSecret;
+
+  CryptidStatus status = cryptid_ibe_bonehFranklin_setup(
+      &masterSecret, &publicParameters, securityLevel);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  BonehFranklinIdentityBasedEncryptionContext context;
+  status = cryptid_ibe_bonehFranklin_createContext(&context, publicParameters);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  const char *const identity = "alice";
+  const char *const otherIdentity = "bob";
+  AffinePointAsBinary privateKey, otherPrivateKey;
+  status = cryptid_ibe_bonehFranklin_extractWithContext(
+      &privateKey, identity, strlen(identity), masterSecret, &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  status = cryptid_ibe_bonehFranklin_extractWithContext(
+      &otherPrivateKey, otherIdentity, strlen(otherIdentity), masterSecret,
+      &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  unsigned char *payload = malloc(payloadLength);
+  unsigned char *ciphertext = malloc(payloadLength);
+  unsigned char *plaintext = malloc(payloadLength);
+  for (size_t i = 0; i < payloadLength; i++) {
+    payload[i] = (unsigned char)rand();
+  }
+
+  // Encrypt and decrypt in pieces not aligned to each other or to the chunks.
+  BonehFranklinIdentityBasedEncryptionStream stream;
+  BonehFranklinIdentityBasedEncryptionEncapsulationAsBinary encapsulation;
+  status = cryptid_ibe_bonehFranklin_encryptInit(
+      &stream, &encapsulation, identity, strlen(identity), &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  status = streamInPieces(cryptid_ibe_bonehFranklin_encryptUpdate, &stream,
+                          ciphertext, payload, payloadLength, 1000);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  unsigned char tag[64];
+  status = cryptid_ibe_bonehFranklin_encryptFinal(tag, &stream);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  const size_t tagLength = encapsulation.cipherVLength;
+
+  status = cryptid_ibe_bonehFranklin_decryptInit(&stream, encapsulation,
+                                                 privateKey, &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  status = streamInPieces(cryptid_ibe_bonehFranklin_decryptUpdate, &stream,
+                          plaintext, ciphertext, payloadLength, 777);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  status = cryptid_ibe_bonehFranklin_decryptFinal(&stream, tag, tagLength);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT_EQ(memcmp(payload, plaintext, payloadLength), 0);
+
+  // A modified ciphertext is rejected by the tag.
+  ciphertext[payloadLength / 2] ^= 1;
+  status = cryptid_ibe_bonehFranklin_decryptInit(&stream, encapsulation,
+                                                 privateKey, &context);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  cryptid_ibe_bonehFranklin_decryptUpdate(&stream, plaintext, ciphertext,
+                                          payloadLength);
+  status = cryptid_ibe_bonehFranklin_decryptFinal(&stream, tag, tagLength);
+
+  ASSERT_EQ(status, CRYPTID_DECRYPTION_FAILED_ERROR);
+
+  // The private key of another identity cannot open the encapsulation.
+  status = cryptid_ibe_bonehFranklin_decryptInit(&stream, encapsulation,
+                                                 otherPrivateKey, &context);
+
+  ASSERT_EQ(status, CRYPTID_DECRYPTION_FAILED_ERROR);
+
+  free(payload);
+  free(ciphertext);
+  free(plaintext);
+  bonehFranklinIdentityBasedEncryptionEncapsulationAsBinary_destroy(
+      encapsulation);
+  cryptid_ibe_bonehFranklin_destroyContext(&context);
+  affineAsBinary_destroy(privateKey);
+  affineAsBinary_destroy(otherPrivateKey);
+  free(masterSecret.masterSecret);
+  bonehFranklinIdentityBasedEncryptionPublicParametersAsBinary_destroy(
+      publicParameters);
+
+  PASS();
+}
+
 static void generateRandomString(char **output, const size_t outputLength,
                                  const char *const alphabet,
                                  const size_t alphabetSize) {
@@ -146,6 +377,10 @@ SUITE(cryptid_boneh_franklin_ibe_suite) {
 
           RUN_TESTp(fresh_boneh_franklin_ibe_setup_matching_identities,
                     securityLevel, message, identity);
+          RUN_TESTp(fresh_boneh_franklin_ibe_setup_reused_context,
+                    securityLevel, message, identity);
+          RUN_TESTp(fresh_boneh_franklin_ibe_setup_identity_cache,
+                    securityLevel, message);
 
           free(message);
           free(identity);
@@ -190,6 +425,15 @@ SUITE(cryptid_boneh_franklin_ibe_suite) {
         }
       }
     }
+
+    {
+      // Shorter than, equal to and spanning multiple authentication chunks.
+      size_t payloadLengths[] = {1, 4096, 10000};
+      for (int i = 0; i < 3; i++) {
+        RUN_TESTp(fresh_boneh_franklin_ibe_setup_stream, LOWEST,
+                  payloadLengths[i]);
+      }
+    }
   }
 }
 
@@ -0,0 +1,288 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionIdentityCache.h"
+#include "util/Parallel.h"
+
+TEST identity_cache_get_should_miss_on_empty_cache(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 4);
+
+  // When
+  Complex value;
+  int found = bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+      &value, &cache, "alice", strlen("alice"));
+
+  // Then
+  ASSERT_EQ(found, 0);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_get_should_return_stored_value(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 4);
+  Complex alice, bob;
+  complex_initLong(&alice, 3, 7);
+  complex_initLong(&bob, 11, 13);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "alice", strlen("alice"), alice);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(&cache, "bob",
+                                                         strlen("bob"), bob);
+
+  // When
+  Complex value;
+  int found = bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+      &value, &cache, "alice", strlen("alice"));
+
+  // Then
+  ASSERT_EQ(found, 1);
+  ASSERT_EQ(complex_isEquals(value, alice), CRYPTID_EQUAL);
+  ASSERT_EQ(cache.size, 2);
+
+  complex_destroyMany(3, alice, bob, value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_put_should_evict_least_recently_used(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 2);
+  Complex value;
+  complex_initLong(&value, 3, 7);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "alice", strlen("alice"), value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(&cache, "bob",
+                                                         strlen("bob"), value);
+
+  // When
+  Complex lookup;
+  int found = bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+      &lookup, &cache, "alice", strlen("alice"));
+  ASSERT_EQ(found, 1);
+  complex_destroy(lookup);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "carol", strlen("carol"), value);
+
+  // Then
+  ASSERT_EQ(cache.size, 2);
+  ASSERT_EQ(bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+                &lookup, &cache, "bob", strlen("bob")),
+            0);
+  ASSERT_EQ(bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+                &lookup, &cache, "alice", strlen("alice")),
+            1);
+  complex_destroy(lookup);
+  ASSERT_EQ(bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+                &lookup, &cache, "carol", strlen("carol")),
+            1);
+  complex_destroy(lookup);
+
+  complex_destroy(value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_with_zero_capacity_should_store_nothing(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 0);
+  Complex value;
+  complex_initLong(&value, 3, 7);
+
+  // When
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "alice", strlen("alice"), value);
+
+  // Then
+  Complex lookup;
+  ASSERT_EQ(bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+                &lookup, &cache, "alice", strlen("alice")),
+            0);
+  ASSERT_EQ(cache.size, 0);
+
+  complex_destroy(value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_init_should_clamp_huge_capacity(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+
+  // When
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, SIZE_MAX);
+
+  // Then
+  ASSERT_EQ(cache.capacity,
+            BONEHFRANKLINIDENTITYBASEDENCRYPTIONIDENTITYCACHE_MAX_CAPACITY);
+  ASSERT(cache.bucketCount >= 2 * cache.capacity);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_reset_should_empty_and_resize(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 2);
+  Complex value;
+  complex_initLong(&value, 3, 7);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "alice", strlen("alice"), value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(&cache, "bob",
+                                                         strlen("bob"), value);
+
+  // When
+  bonehFranklinIdentityBasedEncryptionIdentityCache_reset(&cache, 3);
+
+  // Then
+  Complex lookup;
+  ASSERT_EQ(cache.size, 0);
+  ASSERT_EQ(cache.capacity, 3);
+  ASSERT_EQ(bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+                &lookup, &cache, "alice", strlen("alice")),
+            0);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "alice", strlen("alice"), value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(&cache, "bob",
+                                                         strlen("bob"), value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+      &cache, "carol", strlen("carol"), value);
+  ASSERT_EQ(cache.size, 3);
+
+  complex_destroy(value);
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+static void putAndGet(void *argument, const int taskIndex,
+                      const int taskCount) {
+  BonehFranklinIdentityBasedEncryptionIdentityCache *cache =
+      (BonehFranklinIdentityBasedEncryptionIdentityCache *)argument;
+  char identity[16];
+  Complex value, lookup;
+
+  for (int i = 0; i < 1000; i++) {
+    const int id = (i * taskCount + taskIndex) % 64;
+    const size_t identityLength =
+        (size_t)snprintf(identity, sizeof(identity), "id%d", id);
+
+    complex_initLong(&value, id, id + 1);
+    bonehFranklinIdentityBasedEncryptionIdentityCache_put(
+        cache, identity, identityLength, value);
+    if (bonehFranklinIdentityBasedEncryptionIdentityCache_get(
+            &lookup, cache, identity, identityLength)) {
+      assert(complex_isEquals(lookup, value) == CRYPTID_EQUAL);
+      complex_destroy(lookup);
+    }
+    complex_destroy(value);
+  }
+}
+
+static void resetOrPutAndGet(void *argument, const int taskIndex,
+                             const int taskCount) {
+  BonehFranklinIdentityBasedEncryptionIdentityCache *cache =
+      (BonehFranklinIdentityBasedEncryptionIdentityCache *)argument;
+
+  if (taskIndex > 0) {
+    putAndGet(argument, taskIndex, taskCount);
+    return;
+  }
+
+  for (int i = 0; i < 100; i++) {
+    bonehFranklinIdentityBasedEncryptionIdentityCache_reset(cache,
+                                                            8 + i % 16);
+  }
+}
+
+TEST identity_cache_should_be_resettable_while_in_use(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 16);
+  parallel_setThreadCount(4);
+
+  // When
+  parallel_run(resetOrPutAndGet, &cache, 4);
+
+  parallel_setThreadCount(0);
+
+  // Then
+  ASSERT(cache.size <= cache.capacity);
+
+  size_t listed = 0;
+  for (BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+           cache.mostRecent;
+       entry; entry = entry->lessRecent) {
+    listed++;
+  }
+  ASSERT_EQ(listed, cache.size);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+TEST identity_cache_should_be_usable_from_multiple_threads(void) {
+  // Given
+  BonehFranklinIdentityBasedEncryptionIdentityCache cache;
+  bonehFranklinIdentityBasedEncryptionIdentityCache_init(&cache, 16);
+  parallel_setThreadCount(4);
+
+  // When
+  parallel_run(putAndGet, &cache, 4);
+
+  parallel_setThreadCount(0);
+
+  // Then
+  ASSERT_EQ(cache.size, 16);
+
+  size_t listed = 0;
+  for (BonehFranklinIdentityBasedEncryptionIdentityCacheEntry *entry =
+           cache.mostRecent;
+       entry; entry = entry->lessRecent) {
+    listed++;
+  }
+  ASSERT_EQ(listed, 16);
+
+  bonehFranklinIdentityBasedEncryptionIdentityCache_destroy(&cache);
+
+  PASS();
+}
+
+SUITE(identity_cache_suite) {
+  RUN_TEST(identity_cache_get_should_miss_on_empty_cache);
+  RUN_TEST(identity_cache_get_should_return_stored_value);
+  RUN_TEST(identity_cache_put_should_evict_least_recently_used);
+  RUN_TEST(identity_cache_with_zero_capacity_should_store_nothing);
+  RUN_TEST(identity_cache_init_should_clamp_huge_capacity);
+  RUN_TEST(identity_cache_reset_should_empty_and_resize);
+  RUN_TEST(identity_cache_should_be_usable_from_multiple_threads);
+  RUN_TEST(identity_cache_should_be_resettable_while_in_use);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(identity_cache_suite);
+
+  GREATEST_MAIN_END();
+}
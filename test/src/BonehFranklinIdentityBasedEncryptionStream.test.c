@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "identity-based/encryption/boneh-franklin/BonehFranklinIdentityBasedEncryptionStream.h"
+#include "util/Utils.h"
+
+static void createKeyMaterial(unsigned char *keyMaterial, const int length) {
+  for (int i = 0; i < length; i++) {
+    keyMaterial[i] = (unsigned char)(7 * i + 3);
+  }
+}
+
+TEST stream_keystream_should_match_hash_bytes(const HashFunction hashFunction,
+                                              const size_t length) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+  unsigned char keyMaterial[128];
+  createKeyMaterial(keyMaterial, 2 * hashLength);
+  unsigned char *zeros = calloc(length, sizeof(unsigned char));
+  unsigned char *keystream = malloc(length);
+
+  // When
+  BonehFranklinIdentityBasedEncryptionStream stream;
+  bonehFranklinIdentityBasedEncryptionStream_init(&stream, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_update(&stream, keystream, zeros,
+                                                    length, 1);
+  unsigned char *expected;
+  hashBytes(&expected, length, keyMaterial, hashLength, hashFunction);
+
+  // Then
+  ASSERT_EQ(memcmp(keystream, expected, length), 0);
+
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&stream);
+  free(zeros);
+  free(keystream);
+  free(expected);
+
+  PASS();
+}
+
+TEST stream_should_not_depend_on_piece_lengths(const size_t length) {
+  // Given
+  const HashFunction hashFunction = hashFunction_SHA256;
+  unsigned char keyMaterial[64];
+  createKeyMaterial(keyMaterial, 64);
+  unsigned char *input = malloc(length);
+  for (size_t i = 0; i < length; i++) {
+    input[i] = (unsigned char)i;
+  }
+  unsigned char *wholeOutput = malloc(length);
+  unsigned char *piecesOutput = malloc(length);
+
+  // When
+  BonehFranklinIdentityBasedEncryptionStream whole, pieces;
+  bonehFranklinIdentityBasedEncryptionStream_init(&whole, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_init(&pieces, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_update(&whole, wholeOutput, input,
+                                                    length, 1);
+  for (size_t offset = 0; offset < length; offset += 13) {
+    const size_t count = length - offset < 13 ? length - offset : 13;
+    bonehFranklinIdentityBasedEncryptionStream_update(
+        &pieces, piecesOutput + offset, input + offset, count, 1);
+  }
+
+  unsigned char wholeTag[32], piecesTag[32];
+  bonehFranklinIdentityBasedEncryptionStream_tag(wholeTag, &whole);
+  bonehFranklinIdentityBasedEncryptionStream_tag(piecesTag, &pieces);
+
+  // Then
+  ASSERT_EQ(memcmp(wholeOutput, piecesOutput, length), 0);
+  ASSERT_EQ(memcmp(wholeTag, piecesTag, 32), 0);
+
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&whole);
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&pieces);
+  free(input);
+  free(wholeOutput);
+  free(piecesOutput);
+
+  PASS();
+}
+
+TEST stream_tag_should_depend_on_length(void) {
+  // Given
+  const HashFunction hashFunction = hashFunction_SHA1;
+  unsigned char keyMaterial[40];
+  createKeyMaterial(keyMaterial, 40);
+  unsigned char zeros[2] = {0, 0}, output[2];
+
+  // When
+  BonehFranklinIdentityBasedEncryptionStream shorter, longer;
+  bonehFranklinIdentityBasedEncryptionStream_init(&shorter, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_init(&longer, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_update(&shorter, output, zeros, 1,
+                                                    0);
+  bonehFranklinIdentityBasedEncryptionStream_update(&longer, output, zeros, 2,
+                                                    0);
+
+  unsigned char shorterTag[20], longerTag[20];
+  bonehFranklinIdentityBasedEncryptionStream_tag(shorterTag, &shorter);
+  bonehFranklinIdentityBasedEncryptionStream_tag(longerTag, &longer);
+
+  // Then
+  ASSERT(memcmp(shorterTag, longerTag, 20) != 0);
+
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&shorter);
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&longer);
+
+  PASS();
+}
+
+TEST stream_tag_should_be_hmac_of_ciphertext_and_length(void) {
+  // Given
+  const HashFunction hashFunction = hashFunction_SHA256;
+  unsigned char keyMaterial[64];
+  createKeyMaterial(keyMaterial, 64);
+  unsigned char input[300], ciphertext[300];
+  for (size_t i = 0; i < sizeof(input); i++) {
+    input[i] = (unsigned char)i;
+  }
+
+  // When
+  BonehFranklinIdentityBasedEncryptionStream stream;
+  bonehFranklinIdentityBasedEncryptionStream_init(&stream, keyMaterial,
+                                                  hashFunction);
+  bonehFranklinIdentityBasedEncryptionStream_update(&stream, ciphertext, input,
+                                                    sizeof(input), 1);
+  unsigned char tag[32];
+  bonehFranklinIdentityBasedEncryptionStream_tag(tag, &stream);
+
+  // Then
+  HmacKey hmacKey;
+  hmac_initKey(&hmacKey, keyMaterial + 32, 32, hashFunction);
+  const unsigned char encodedLength[8] = {0, 0, 0, 0, 0, 0, 0x01, 0x2c};
+  const unsigned char *const pieces[] = {ciphertext, encodedLength};
+  const size_t pieceLengths[] = {sizeof(ciphertext), 8};
+  unsigned char expected[32];
+  hmac_hash(expected, &hmacKey, pieces, pieceLengths, 2);
+
+  ASSERT_MEM_EQ(expected, tag, 32);
+
+  hmac_destroyKey(&hmacKey);
+  bonehFranklinIdentityBasedEncryptionStream_destroy(&stream);
+
+  PASS();
+}
+
+SUITE(stream_suite) {
+  RUN_TESTp(stream_keystream_should_match_hash_bytes, hashFunction_SHA1, 1);
+  RUN_TESTp(stream_keystream_should_match_hash_bytes, hashFunction_SHA256,
+            100);
+  RUN_TESTp(stream_keystream_should_match_hash_bytes, hashFunction_SHA512,
+            5000);
+  RUN_TESTp(stream_should_not_depend_on_piece_lengths, 100);
+  RUN_TESTp(stream_should_not_depend_on_piece_lengths, 9000);
+  RUN_TEST(stream_tag_should_depend_on_length);
+  RUN_TEST(stream_tag_should_be_hmac_of_ciphertext_and_length);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(stream_suite);
+
+  GREATEST_MAIN_END();
+}
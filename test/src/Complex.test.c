@@ -167,6 +167,34 @@ SUITE(additive_inverse_suite) {
   mpz_clear(p);
 }
 
+TEST conjugate_should_negate_the_imaginary_part(const long real,
+                                               const long imaginary,
+                                               const long expectedImaginary) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+  Complex c, expected;
+  complex_initLong(&c, real, imaginary);
+  complex_initLong(&expected, real, expectedImaginary);
+
+  // When
+  Complex result;
+  complex_conjugate(&result, c, p);
+
+  // Then
+  ASSERT(complex_isEquals(result, expected));
+
+  complex_destroyMany(3, c, expected, result);
+  mpz_clear(p);
+
+  PASS();
+}
+
+SUITE(conjugate_suite) {
+  RUN_TESTp(conjugate_should_negate_the_imaginary_part, 3, 2, 5);
+  RUN_TESTp(conjugate_should_negate_the_imaginary_part, 6, 0, 0);
+}
+
 TEST the_power_of_1_0_is_1_0_for_any_p(void) {
   // Given
   Complex base;
@@ -291,6 +319,69 @@ SUITE(modulo_multiplication_with_scalar_suite) {
   RUN_TESTp(GF_5_modMul_should_just_work, 4, 3, 2);
 }
 
+TEST GF_7_modMul_of_complex_numbers_should_just_work(
+    const long real, const long imaginary, const long expectedReal,
+    const long expectedImaginary) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+
+  Complex c, d;
+  complex_initLong(&c, 2, 3);
+  complex_initLong(&d, real, imaginary);
+  Complex expected;
+  complex_initLong(&expected, expectedReal, expectedImaginary);
+
+  // When
+  Complex result;
+  complex_modMul(&result, c, d, p);
+
+  // Then
+  ASSERT(complex_isEquals(result, expected));
+
+  complex_destroyMany(4, result, expected, c, d);
+  mpz_clear(p);
+
+  PASS();
+}
+
+TEST GF_7_modSquare_should_match_modMul(const long real,
+                                        const long imaginary) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+
+  Complex c;
+  complex_initLong(&c, real, imaginary);
+  Complex expected;
+  complex_modMul(&expected, c, c, p);
+
+  // When
+  Complex result;
+  complex_modSquare(&result, c, p);
+
+  // Then
+  ASSERT(complex_isEquals(result, expected));
+
+  complex_destroyMany(3, result, expected, c);
+  mpz_clear(p);
+
+  PASS();
+}
+
+SUITE(modulo_multiplication_suite) {
+  RUN_TESTp(GF_7_modMul_of_complex_numbers_should_just_work, 0, 0, 0, 0);
+  RUN_TESTp(GF_7_modMul_of_complex_numbers_should_just_work, 1, 0, 2, 3);
+  RUN_TESTp(GF_7_modMul_of_complex_numbers_should_just_work, 4, 5, 0, 1);
+  RUN_TESTp(GF_7_modMul_of_complex_numbers_should_just_work, 6, 6, 1, 2);
+
+  for (long real = 0; real < 7; real++) {
+    for (long imaginary = 0; imaginary < 7; imaginary++) {
+      RUN_TESTp(GF_7_modSquare_should_match_modMul, real, imaginary);
+    }
+  }
+}
+
 TEST the_multiplicative_inverse_of_1_0_should_be_1_0_for_any_p(void) {
   // Given
   mpz_t p;
@@ -381,6 +472,105 @@ SUITE(multiplicative_inverse_suite) {
   }
 }
 
+TEST GF_7_modMulInto_should_match_modMul_when_aliased(const long real,
+                                                     const long imaginary) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+
+  Complex c, d;
+  complex_initLong(&c, real, imaginary);
+  complex_initLong(&d, 3, 5);
+
+  Complex expectedSquare, expectedProduct;
+  complex_modMul(&expectedSquare, c, c, p);
+  complex_modMul(&expectedProduct, expectedSquare, d, p);
+
+  // When
+  complex_modMulInto(&c, c, c, p, &scratch);
+  complex_modMulInto(&d, c, d, p, &scratch);
+
+  // Then
+  ASSERT(complex_isEquals(c, expectedSquare));
+  ASSERT(complex_isEquals(d, expectedProduct));
+
+  complex_destroyMany(4, c, d, expectedSquare, expectedProduct);
+  complex_destroyScratch(scratch);
+  mpz_clear(p);
+
+  PASS();
+}
+
+TEST GF_7_multiplicativeInverseInto_should_match_multiplicativeInverse_when_aliased(
+    const long real, const long imaginary) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+  ComplexScratch scratch;
+  complex_initScratch(&scratch);
+
+  Complex c;
+  complex_initLong(&c, real, imaginary);
+
+  Complex expected;
+  CryptidStatus status = complex_multiplicativeInverse(&expected, c, p);
+
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  // When
+  status = complex_multiplicativeInverseInto(&c, c, p, &scratch);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT(complex_isEquals(c, expected));
+
+  complex_destroyMany(2, c, expected);
+  complex_destroyScratch(scratch);
+  mpz_clear(p);
+
+  PASS();
+}
+
+TEST modSubInto_should_be_the_inverse_of_modAddInto(void) {
+  // Given
+  mpz_t p;
+  mpz_init_set_ui(p, 7);
+
+  Complex c, d, original;
+  complex_initLong(&c, 2, 6);
+  complex_initLong(&d, 5, 3);
+  complex_initLong(&original, 2, 6);
+
+  // When
+  complex_modAddInto(&c, c, d, p);
+  complex_modSubInto(&c, c, d, p);
+
+  // Then
+  ASSERT(complex_isEquals(c, original));
+
+  complex_destroyMany(3, c, d, original);
+  mpz_clear(p);
+
+  PASS();
+}
+
+SUITE(into_suite) {
+  RUN_TEST(modSubInto_should_be_the_inverse_of_modAddInto);
+  RUN_TESTp(GF_7_modMulInto_should_match_modMul_when_aliased, 0, 0);
+  RUN_TESTp(GF_7_modMulInto_should_match_modMul_when_aliased, 4, 6);
+  RUN_TESTp(
+      GF_7_multiplicativeInverseInto_should_match_multiplicativeInverse_when_aliased,
+      3, 0);
+  RUN_TESTp(
+      GF_7_multiplicativeInverseInto_should_match_multiplicativeInverse_when_aliased,
+      0, 3);
+  RUN_TESTp(
+      GF_7_multiplicativeInverseInto_should_match_multiplicativeInverse_when_aliased,
+      2, 5);
+}
+
 GREATEST_MAIN_DEFS();
 
 int main(int argc, char **argv) {
@@ -389,9 +579,12 @@ int main(int argc, char **argv) {
   RUN_SUITE(init_suite);
   RUN_SUITE(add_suite);
   RUN_SUITE(additive_inverse_suite);
+  RUN_SUITE(conjugate_suite);
   RUN_SUITE(modulo_power_suite);
   RUN_SUITE(modulo_multiplication_with_scalar_suite);
+  RUN_SUITE(modulo_multiplication_suite);
   RUN_SUITE(multiplicative_inverse_suite);
+  RUN_SUITE(into_suite);
 
   GREATEST_MAIN_END();
 }
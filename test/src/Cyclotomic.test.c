@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "complex/Complex.h"
+#include "complex/Cyclotomic.h"
+
+// Creates the element \f$\frac{\overline{w}}{w}\f$ of norm 1 from
+// \f$w = 3 + 7i\f$.
+static void createUnitaryElement(Complex *result, const mpz_t p) {
+  Complex w, wConjugate, wInverse;
+  complex_initLong(&w, 3, 7);
+  complex_conjugate(&wConjugate, w, p);
+  complex_multiplicativeInverse(&wInverse, w, p);
+  complex_modMul(result, wConjugate, wInverse, p);
+  complex_destroyMany(3, w, wConjugate, wInverse);
+}
+
+TEST cyclotomic_square_should_match_multiplication(void) {
+  // Given
+  mpz_t p;
+  mpz_init_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  Complex z;
+  createUnitaryElement(&z, p);
+
+  // When
+  Complex square, expected;
+  cyclotomic_square(&square, z, p);
+  complex_modMul(&expected, z, z, p);
+
+  // Then
+  ASSERT_EQ(complex_isEquals(square, expected), CRYPTID_EQUAL);
+
+  complex_destroyMany(3, z, square, expected);
+  mpz_clear(p);
+
+  PASS();
+}
+
+TEST cyclotomic_inverse_should_be_multiplicative_inverse(void) {
+  // Given
+  mpz_t p;
+  mpz_init_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  Complex z;
+  createUnitaryElement(&z, p);
+
+  // When
+  Complex inverse, expected;
+  cyclotomic_inverse(&inverse, z, p);
+  complex_multiplicativeInverse(&expected, z, p);
+
+  // Then
+  ASSERT_EQ(complex_isEquals(inverse, expected), CRYPTID_EQUAL);
+
+  complex_destroyMany(3, z, inverse, expected);
+  mpz_clear(p);
+
+  PASS();
+}
+
+TEST cyclotomic_pow_should_match_modulo_power(const char *const exponentStr) {
+  // Given
+  mpz_t p, exponent, absExponent;
+  mpz_init_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  mpz_init_set_str(exponent, exponentStr, 16);
+  mpz_init(absExponent);
+  mpz_abs(absExponent, exponent);
+  Complex z;
+  createUnitaryElement(&z, p);
+
+  // When
+  Complex power, expected;
+  cyclotomic_pow(&power, z, exponent, p);
+  complex_modPow(&expected, z, absExponent, p);
+  if (mpz_sgn(exponent) < 0) {
+    Complex tmp;
+    complex_multiplicativeInverse(&tmp, expected, p);
+    complex_destroy(expected);
+    expected = tmp;
+  }
+
+  // Then
+  ASSERT_EQ(complex_isEquals(power, expected), CRYPTID_EQUAL);
+
+  complex_destroyMany(3, z, power, expected);
+  mpz_clears(p, exponent, absExponent, NULL);
+
+  PASS();
+}
+
+// Exponents longer than the modulus of the highest security level have their
+// NAF digits on the heap.
+TEST cyclotomic_pow_should_accept_exponents_of_any_length(void) {
+  // Given
+  mpz_t p, exponent, five;
+  mpz_init_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  mpz_init_set_ui(five, 5);
+  Complex z;
+  createUnitaryElement(&z, p);
+
+  // \f$z^{p + 1} = 1\f$, hence \f$z^{(p + 1)2^{8000} + 5} = z^5\f$.
+  mpz_init(exponent);
+  mpz_add_ui(exponent, p, 1);
+  mpz_mul_2exp(exponent, exponent, 8000);
+  mpz_add_ui(exponent, exponent, 5);
+
+  // When
+  Complex power, expected;
+  cyclotomic_pow(&power, z, exponent, p);
+  complex_modPow(&expected, z, five, p);
+
+  // Then
+  ASSERT_EQ(complex_isEquals(power, expected), CRYPTID_EQUAL);
+
+  complex_destroyMany(3, z, power, expected);
+  mpz_clears(p, exponent, five, NULL);
+
+  PASS();
+}
+
+SUITE(cyclotomic_suite) {
+  RUN_TEST(cyclotomic_square_should_match_multiplication);
+  RUN_TEST(cyclotomic_inverse_should_be_multiplicative_inverse);
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power, "0");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power, "1");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power, "2");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power, "1f");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power, "-5");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power,
+            "d4c8a4ea2a91c2ee65b1f0b31fa38d9b");
+  RUN_TESTp(cyclotomic_pow_should_match_modulo_power,
+            "-bffffffffffffffffffffffffffcffff4");
+  RUN_TEST(cyclotomic_pow_should_accept_exponents_of_any_length);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(cyclotomic_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,117 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "elliptic/AffinePoint.h"
+#include "elliptic/EllipticCurve.h"
+#include "elliptic/FixedBaseTable.h"
+
+TEST fixed_base_multiplication_should_match_wnaf(const char *const scalar) {
+  // Given
+  // The RFC 5091 test curve and a point of order \f$q\f$ on it.
+  mpz_t q, p, zero, one, x, y, s;
+  mpz_inits(q, p, x, y, s, NULL);
+  mpz_init_set_ui(zero, 0);
+  mpz_init_set_ui(one, 1);
+
+  mpz_set_str(q, "fffffffffffffffffffffffffffbffff", 16);
+  mpz_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  mpz_set_str(x, "489a03c58dcf7fcfc97e99ffef0bb4634", 16);
+  mpz_set_str(y, "510c6972d795ec0c2b081b81de767f808", 16);
+  mpz_set_str(s, scalar, 16);
+
+  EllipticCurve ec;
+  ellipticCurve_init(&ec, zero, one, p);
+  AffinePoint base;
+  affine_init(&base, x, y);
+
+  FixedBaseTable table;
+  fixedBase_init(&table, base, q, ec);
+
+  // When
+  AffinePoint result, expected;
+  CryptidStatus status = fixedBase_multiply(&result, table, s, ec);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT_EQ(affine_wNAFMultiply(&expected, base, s, ec), CRYPTID_SUCCESS);
+  ASSERT(affine_isEquals(result, expected));
+
+  affine_destroy(result);
+  affine_destroy(expected);
+  affine_destroy(base);
+  fixedBase_destroy(table);
+  ellipticCurve_destroy(ec);
+  mpz_clears(q, p, zero, one, x, y, s, NULL);
+
+  PASS();
+}
+
+TEST fixed_base_multiplication_should_reduce_by_the_order(void) {
+  // Given
+  mpz_t q, p, zero, one, x, y, s, sPlusQ;
+  mpz_inits(q, p, x, y, s, sPlusQ, NULL);
+  mpz_init_set_ui(zero, 0);
+  mpz_init_set_ui(one, 1);
+
+  mpz_set_str(q, "fffffffffffffffffffffffffffbffff", 16);
+  mpz_set_str(p, "bffffffffffffffffffffffffffcffff3", 16);
+  mpz_set_str(x, "489a03c58dcf7fcfc97e99ffef0bb4634", 16);
+  mpz_set_str(y, "510c6972d795ec0c2b081b81de767f808", 16);
+  mpz_set_ui(s, 12345);
+  mpz_add(sPlusQ, s, q);
+
+  EllipticCurve ec;
+  ellipticCurve_init(&ec, zero, one, p);
+  AffinePoint base;
+  affine_init(&base, x, y);
+
+  FixedBaseTable table;
+  fixedBase_init(&table, base, q, ec);
+
+  // When
+  AffinePoint result, expected, infinity;
+  fixedBase_multiply(&result, table, sPlusQ, ec);
+  fixedBase_multiply(&expected, table, s, ec);
+  fixedBase_multiply(&infinity, table, q, ec);
+
+  // Then
+  ASSERT(affine_isEquals(result, expected));
+  ASSERT(affine_isInfinity(infinity));
+
+  affine_destroy(result);
+  affine_destroy(expected);
+  affine_destroy(infinity);
+  affine_destroy(base);
+  fixedBase_destroy(table);
+  ellipticCurve_destroy(ec);
+  mpz_clears(q, p, zero, one, x, y, s, sPlusQ, NULL);
+
+  PASS();
+}
+
+SUITE(fixed_base_suite) {
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf, "0");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf, "1");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf, "2");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf, "3f");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf,
+            "8000000000000000000000000000000");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf,
+            "d4c8a4ea2a91c2ee65b1f0b31fa38d9b");
+  RUN_TESTp(fixed_base_multiplication_should_match_wnaf,
+            "fffffffffffffffffffffffffffbfffe");
+  RUN_TEST(fixed_base_multiplication_should_reduce_by_the_order);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(fixed_base_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,277 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "util/HashFunction.h"
+
+// The expected values are the "abc" and the one million "a" examples of
+// FIPS 180-2.
+
+static const unsigned char SHA1_ABC[] = {
+    0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71,
+    0x78, 0x50, 0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d};
+
+static const unsigned char SHA224_ABC[] = {
+    0x23, 0x09, 0x7d, 0x22, 0x34, 0x05, 0xd8, 0x22, 0x86, 0x42, 0xa4, 0x77,
+    0xbd, 0xa2, 0x55, 0xb3, 0x2a, 0xad, 0xbc, 0xe4, 0xbd, 0xa0, 0xb3, 0xf7,
+    0xe3, 0x6c, 0x9d, 0xa7};
+
+static const unsigned char SHA256_ABC[] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+    0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+    0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+
+static const unsigned char SHA384_ABC[] = {
+    0xcb, 0x00, 0x75, 0x3f, 0x45, 0xa3, 0x5e, 0x8b, 0xb5, 0xa0, 0x3d, 0x69,
+    0x9a, 0xc6, 0x50, 0x07, 0x27, 0x2c, 0x32, 0xab, 0x0e, 0xde, 0xd1, 0x63,
+    0x1a, 0x8b, 0x60, 0x5a, 0x43, 0xff, 0x5b, 0xed, 0x80, 0x86, 0x07, 0x2b,
+    0xa1, 0xe7, 0xcc, 0x23, 0x58, 0xba, 0xec, 0xa1, 0x34, 0xc8, 0x25, 0xa7};
+
+static const unsigned char SHA512_ABC[] = {
+    0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49,
+    0xae, 0x20, 0x41, 0x31, 0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2,
+    0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a, 0x21, 0x92, 0x99, 0x2a,
+    0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+    0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f,
+    0xa5, 0x4c, 0xa4, 0x9f};
+
+static const unsigned char SHA1_MILLION_A[] = {
+    0x34, 0xaa, 0x97, 0x3c, 0xd4, 0xc4, 0xda, 0xa4, 0xf6, 0x1e, 0xeb, 0x2b,
+    0xdb, 0xad, 0x27, 0x31, 0x65, 0x34, 0x01, 0x6f};
+
+static const unsigned char SHA256_MILLION_A[] = {
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2,
+    0x84, 0xd7, 0x3e, 0x67, 0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e,
+    0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0};
+
+static const unsigned char SHA512_MILLION_A[] = {
+    0xe7, 0x18, 0x48, 0x3d, 0x0c, 0xe7, 0x69, 0x64, 0x4e, 0x2e, 0x42, 0xc7,
+    0xbc, 0x15, 0xb4, 0x63, 0x8e, 0x1f, 0x98, 0xb1, 0x3b, 0x20, 0x44, 0x28,
+    0x56, 0x32, 0xa8, 0x03, 0xaf, 0xa9, 0x73, 0xeb, 0xde, 0x0f, 0xf2, 0x44,
+    0x87, 0x7e, 0xa6, 0x0a, 0x4c, 0xb0, 0x43, 0x2c, 0xe5, 0x77, 0xc3, 0x1b,
+    0xeb, 0x00, 0x9c, 0x5c, 0x2c, 0x49, 0xaa, 0x2e, 0x4e, 0xad, 0xb2, 0x17,
+    0xad, 0x8c, 0xc0, 0x9b};
+
+TEST hash_should_match_the_reference(const HashFunction hashFunction,
+                                     const unsigned char *const expected) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+  unsigned char hash[HASHFUNCTION_MAX_HASH_SIZE];
+
+  // When
+  CryptidStatus status = hashFunction_hash(hash, (const unsigned char *)"abc",
+                                           3, hashFunction);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT_MEM_EQ(expected, hash, hashLength);
+
+  PASS();
+}
+
+TEST update_should_accept_arbitrary_pieces(
+    const HashFunction hashFunction, const unsigned char *const expected) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+  unsigned char hash[HASHFUNCTION_MAX_HASH_SIZE];
+
+  const size_t pieceLength = 999;
+  unsigned char piece[999];
+  memset(piece, 'a', pieceLength);
+
+  HashFunctionContext context;
+  ASSERT_EQ(hashFunction_initContext(&context, hashFunction), CRYPTID_SUCCESS);
+
+  // When
+  size_t remaining = 1000000;
+  while (remaining > 0) {
+    const size_t length = remaining < pieceLength ? remaining : pieceLength;
+    hashFunction_update(&context, piece, length);
+    hashFunction_update(&context, piece, 0);
+    remaining -= length;
+  }
+  hashFunction_final(hash, &context);
+
+  // Then
+  ASSERT_MEM_EQ(expected, hash, hashLength);
+
+  PASS();
+}
+
+TEST copied_context_should_continue_independently(
+    const HashFunction hashFunction) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+  unsigned char expected[HASHFUNCTION_MAX_HASH_SIZE];
+  unsigned char hash[HASHFUNCTION_MAX_HASH_SIZE];
+
+  HashFunctionContext prefix;
+  hashFunction_initContext(&prefix, hashFunction);
+  hashFunction_update(&prefix, (const unsigned char *)"prefix ", 7);
+
+  // When, Then
+  const char *const suffixes[] = {"one", "two"};
+  for (size_t i = 0; i < 2; i++) {
+    char message[16];
+    sprintf(message, "prefix %s", suffixes[i]);
+    hashFunction_hash(expected, (const unsigned char *)message,
+                      strlen(message), hashFunction);
+
+    HashFunctionContext context = prefix;
+    hashFunction_update(&context, (const unsigned char *)suffixes[i],
+                        strlen(suffixes[i]));
+    hashFunction_final(hash, &context);
+
+    ASSERT_MEM_EQ(expected, hash, hashLength);
+  }
+
+  PASS();
+}
+
+TEST accelerated_kernels_should_match_portable_code(
+    const HashFunction hashFunction) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+  unsigned char accelerated[HASHFUNCTION_MAX_HASH_SIZE];
+  unsigned char portable[HASHFUNCTION_MAX_HASH_SIZE];
+
+  const size_t maxLength = 1500;
+  unsigned char *message = malloc(maxLength);
+  for (size_t i = 0; i < maxLength; i++) {
+    message[i] = (unsigned char)(i * 131 + 7);
+  }
+
+  const SHA256BlockKernel sha256Kernel = SHA256_Block_Kernel;
+  const SHA512BlockKernel sha512Kernel = SHA512_Block_Kernel;
+
+  // When, Then
+  // Every length up to several blocks, both in one piece and starting off
+  // a block boundary.
+  for (size_t length = 0; length < maxLength; length += 7) {
+    hashFunction_hash(accelerated, message, length, hashFunction);
+
+    SHA256_Block_Kernel = NULL;
+    SHA512_Block_Kernel = NULL;
+    HashFunctionContext context;
+    hashFunction_initContext(&context, hashFunction);
+    hashFunction_update(&context, message, length / 3);
+    hashFunction_update(&context, message + length / 3, length - length / 3);
+    hashFunction_final(portable, &context);
+    SHA256_Block_Kernel = sha256Kernel;
+    SHA512_Block_Kernel = sha512Kernel;
+
+    ASSERT_MEM_EQ(portable, accelerated, hashLength);
+  }
+
+  free(message);
+
+  PASS();
+}
+
+TEST hashMany_should_match_hash(const HashFunction hashFunction,
+                                const int isAccelerated) {
+  // Given
+  int hashLength;
+  hashFunction_getHashSize(&hashLength, hashFunction);
+
+  // Lengths around the block boundaries, in a count that does not fill the
+  // last group of lanes.
+  const size_t messageCount = 37;
+  unsigned char *const message = malloc(4 * messageCount + 200);
+  for (size_t i = 0; i < 4 * messageCount + 200; i++) {
+    message[i] = (unsigned char)(i * 71 + 3);
+  }
+
+  const unsigned char *messages[37];
+  size_t messageLengths[37];
+  unsigned char results[37][HASHFUNCTION_MAX_HASH_SIZE];
+  unsigned char *hashResults[37];
+  for (size_t i = 0; i < messageCount; i++) {
+    messages[i] = message + i;
+    messageLengths[i] = i % 2 ? 4 * i : 55 + i % 11;
+    hashResults[i] = results[i];
+  }
+
+  const SHA256MultiBlockKernel multiBlockKernel = SHA256_Multi_Block_Kernel;
+  if (!isAccelerated) {
+    SHA256_Multi_Block_Kernel = NULL;
+  }
+
+  // When
+  CryptidStatus status = hashFunction_hashMany(
+      hashResults, messages, messageLengths, messageCount, hashFunction);
+
+  SHA256_Multi_Block_Kernel = multiBlockKernel;
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  for (size_t i = 0; i < messageCount; i++) {
+    unsigned char expected[HASHFUNCTION_MAX_HASH_SIZE];
+    hashFunction_hash(expected, messages[i], messageLengths[i], hashFunction);
+
+    ASSERT_MEM_EQ(expected, results[i], hashLength);
+  }
+
+  free(message);
+
+  PASS();
+}
+
+TEST initContext_should_reject_unknown_hash_function() {
+  HashFunctionContext context;
+
+  ASSERT_EQ(hashFunction_initContext(&context, HASHFUNCTION_MAX_VALUE + 1),
+            CRPYTID_UNKNOWN_HASH_TYPE_ERROR);
+
+  PASS();
+}
+
+SUITE(hash_function_suite) {
+  RUN_TESTp(hash_should_match_the_reference, hashFunction_SHA1, SHA1_ABC);
+  RUN_TESTp(hash_should_match_the_reference, hashFunction_SHA224, SHA224_ABC);
+  RUN_TESTp(hash_should_match_the_reference, hashFunction_SHA256, SHA256_ABC);
+  RUN_TESTp(hash_should_match_the_reference, hashFunction_SHA384, SHA384_ABC);
+  RUN_TESTp(hash_should_match_the_reference, hashFunction_SHA512, SHA512_ABC);
+
+  RUN_TESTp(update_should_accept_arbitrary_pieces, hashFunction_SHA1,
+            SHA1_MILLION_A);
+  RUN_TESTp(update_should_accept_arbitrary_pieces, hashFunction_SHA256,
+            SHA256_MILLION_A);
+  RUN_TESTp(update_should_accept_arbitrary_pieces, hashFunction_SHA512,
+            SHA512_MILLION_A);
+
+  RUN_TESTp(copied_context_should_continue_independently, hashFunction_SHA224);
+  RUN_TESTp(copied_context_should_continue_independently, hashFunction_SHA384);
+
+  RUN_TESTp(accelerated_kernels_should_match_portable_code,
+            hashFunction_SHA224);
+  RUN_TESTp(accelerated_kernels_should_match_portable_code,
+            hashFunction_SHA256);
+  RUN_TESTp(accelerated_kernels_should_match_portable_code,
+            hashFunction_SHA512);
+
+  RUN_TESTp(hashMany_should_match_hash, hashFunction_SHA224, 1);
+  RUN_TESTp(hashMany_should_match_hash, hashFunction_SHA256, 1);
+  RUN_TESTp(hashMany_should_match_hash, hashFunction_SHA256, 0);
+  RUN_TESTp(hashMany_should_match_hash, hashFunction_SHA384, 1);
+
+  RUN_TEST(initContext_should_reject_unknown_hash_function);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(hash_function_suite);
+
+  GREATEST_MAIN_END();
+}
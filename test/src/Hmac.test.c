@@ -0,0 +1,114 @@
+#include <string.h>
+
+#include "greatest.h"
+
+#include "util/Hmac.h"
+
+TEST hmac_should_match_test_vector(const HashFunction hashFunction,
+                                   const unsigned char *key,
+                                   const size_t keyLength,
+                                   const char *const message,
+                                   const unsigned char *const expected) {
+  // Given
+  HmacKey hmacKey;
+  hmac_initKey(&hmacKey, key, keyLength, hashFunction);
+  const unsigned char *const pieces[] = {(const unsigned char *)message};
+  const size_t pieceLengths[] = {strlen(message)};
+  unsigned char result[HASHFUNCTION_MAX_HASH_SIZE];
+
+  // When
+  hmac_hash(result, &hmacKey, pieces, pieceLengths, 1);
+
+  // Then
+  ASSERT_MEM_EQ(expected, result, hmacKey.hashLength);
+  hmac_destroyKey(&hmacKey);
+
+  PASS();
+}
+
+TEST hmac_should_not_depend_on_pieces(void) {
+  // Given
+  const unsigned char key[] = "key";
+  HmacKey hmacKey;
+  hmac_initKey(&hmacKey, key, 3, hashFunction_SHA256);
+  const char *const message = "The quick brown fox jumps over the lazy dog";
+  const unsigned char *const whole[] = {(const unsigned char *)message};
+  const size_t wholeLengths[] = {strlen(message)};
+  unsigned char expected[32], result[32];
+  hmac_hash(expected, &hmacKey, whole, wholeLengths, 1);
+
+  // When
+  HashFunctionContext context;
+  hmac_init(&context, &hmacKey);
+  hashFunction_update(&context, (const unsigned char *)message, 10);
+  hashFunction_update(&context, (const unsigned char *)message + 10,
+                      strlen(message) - 10);
+  hmac_final(result, &context, &hmacKey);
+
+  // Then
+  ASSERT_MEM_EQ(expected, result, 32);
+
+  hmac_destroyKey(&hmacKey);
+
+  PASS();
+}
+
+// Test cases 2 and 6 of RFC 4231, and test case 2 of RFC 2202.
+static const unsigned char JEFE[] = "Jefe";
+static unsigned char longKey[131];
+
+static const unsigned char JEFE_SHA1[] = {
+    0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2, 0xd2, 0x74, 0x16, 0xd5,
+    0xf1, 0x84, 0xdf, 0x9c, 0x25, 0x9a, 0x7c, 0x79};
+
+static const unsigned char JEFE_SHA256[] = {
+    0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26,
+    0x08, 0x95, 0x75, 0xc7, 0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83,
+    0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+
+static const unsigned char JEFE_SHA512[] = {
+    0x16, 0x4b, 0x7a, 0x7b, 0xfc, 0xf8, 0x19, 0xe2, 0xe3, 0x95, 0xfb, 0xe7,
+    0x3b, 0x56, 0xe0, 0xa3, 0x87, 0xbd, 0x64, 0x22, 0x2e, 0x83, 0x1f, 0xd6,
+    0x10, 0x27, 0x0c, 0xd7, 0xea, 0x25, 0x05, 0x54, 0x97, 0x58, 0xbf, 0x75,
+    0xc0, 0x5a, 0x99, 0x4a, 0x6d, 0x03, 0x4f, 0x65, 0xf8, 0xf0, 0xe6, 0xfd,
+    0xca, 0xea, 0xb1, 0xa3, 0x4d, 0x4a, 0x6b, 0x4b, 0x63, 0x6e, 0x07, 0x0a,
+    0x38, 0xbc, 0xe7, 0x37};
+
+static const unsigned char LONG_KEY_SHA256[] = {
+    0x60, 0xe4, 0x31, 0x59, 0x1e, 0xe0, 0xb6, 0x7f, 0x0d, 0x8a, 0x26, 0xaa,
+    0xcb, 0xf5, 0xb7, 0x7f, 0x8e, 0x0b, 0xc6, 0x21, 0x37, 0x28, 0xc5, 0x14,
+    0x05, 0x46, 0x04, 0x0f, 0x0e, 0xe3, 0x7f, 0x54};
+
+static const unsigned char LONG_KEY_SHA384[] = {
+    0x4e, 0xce, 0x08, 0x44, 0x85, 0x81, 0x3e, 0x90, 0x88, 0xd2, 0xc6, 0x3a,
+    0x04, 0x1b, 0xc5, 0xb4, 0x4f, 0x9e, 0xf1, 0x01, 0x2a, 0x2b, 0x58, 0x8f,
+    0x3c, 0xd1, 0x1f, 0x05, 0x03, 0x3a, 0xc4, 0xc6, 0x0c, 0x2e, 0xf6, 0xab,
+    0x40, 0x30, 0xfe, 0x82, 0x96, 0x24, 0x8d, 0xf1, 0x63, 0xf4, 0x49, 0x52};
+
+SUITE(hmac_suite) {
+  memset(longKey, 0xaa, sizeof(longKey));
+
+  RUN_TESTp(hmac_should_match_test_vector, hashFunction_SHA1, JEFE, 4,
+            "what do ya want for nothing?", JEFE_SHA1);
+  RUN_TESTp(hmac_should_match_test_vector, hashFunction_SHA256, JEFE, 4,
+            "what do ya want for nothing?", JEFE_SHA256);
+  RUN_TESTp(hmac_should_match_test_vector, hashFunction_SHA512, JEFE, 4,
+            "what do ya want for nothing?", JEFE_SHA512);
+  RUN_TESTp(hmac_should_match_test_vector, hashFunction_SHA256, longKey, 131,
+            "Test Using Larger Than Block-Size Key - Hash Key First",
+            LONG_KEY_SHA256);
+  RUN_TESTp(hmac_should_match_test_vector, hashFunction_SHA384, longKey, 131,
+            "Test Using Larger Than Block-Size Key - Hash Key First",
+            LONG_KEY_SHA384);
+  RUN_TEST(hmac_should_not_depend_on_pieces);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(hmac_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "util/HmacDrbg.h"
+#include "util/Random.h"
+
+// The first HMAC_DRBG SHA-256 example of the NIST CAVP without prediction
+// resistance, reseed, personalization string and additional input: the
+// output of the second 1024-bit request.
+TEST generate_should_match_the_cavp_example() {
+  // Given
+  const unsigned char entropy[] = {
+      0xca, 0x85, 0x19, 0x11, 0x34, 0x93, 0x84, 0xbf, 0xfe, 0x89, 0xde, 0x1c,
+      0xbd, 0xc4, 0x6e, 0x68, 0x31, 0xe4, 0x4d, 0x34, 0xa4, 0xfb, 0x93, 0x5e,
+      0xe2, 0x85, 0xdd, 0x14, 0xb7, 0x1a, 0x74, 0x88};
+  const unsigned char nonce[] = {
+      0x65, 0x9b, 0xa9, 0x6c, 0x60, 0x1d, 0xc6, 0x9f, 0xc9, 0x02, 0x94, 0x08,
+      0x05, 0xec, 0x0c, 0xa8};
+  const unsigned char expected[] = {
+      0xe5, 0x28, 0xe9, 0xab, 0xf2, 0xde, 0xce, 0x54, 0xd4, 0x7c, 0x7e, 0x75,
+      0xe5, 0xfe, 0x30, 0x21, 0x49, 0xf8, 0x17, 0xea, 0x9f, 0xb4, 0xbe, 0xe6,
+      0xf4, 0x19, 0x96, 0x97, 0xd0, 0x4d, 0x5b, 0x89, 0xd5, 0x4f, 0xbb, 0x97,
+      0x8a, 0x15, 0xb5, 0xc4, 0x43, 0xc9, 0xec, 0x21, 0x03, 0x6d, 0x24, 0x60,
+      0xb6, 0xf7, 0x3e, 0xba, 0xd0, 0xdc, 0x2a, 0xba, 0x6e, 0x62, 0x4a, 0xbf,
+      0x07, 0x74, 0x5b, 0xc1, 0x07, 0x69, 0x4b, 0xb7, 0x54, 0x7b, 0xb0, 0x99,
+      0x5f, 0x70, 0xde, 0x25, 0xd6, 0xb2, 0x9e, 0x2d, 0x30, 0x11, 0xbb, 0x19,
+      0xd2, 0x76, 0x76, 0xc0, 0x71, 0x62, 0xc8, 0xb5, 0xcc, 0xde, 0x06, 0x68,
+      0x96, 0x1d, 0xf8, 0x68, 0x03, 0x48, 0x2c, 0xb3, 0x7e, 0xd6, 0xd5, 0xc0,
+      0xbb, 0x8d, 0x50, 0xcf, 0x1f, 0x50, 0xd4, 0x76, 0xaa, 0x04, 0x58, 0xbd,
+      0xab, 0xa8, 0x06, 0xf4, 0x8b, 0xe9, 0xdc, 0xb8};
+  unsigned char output[128];
+
+  HmacDrbg drbg;
+  hmacDrbg_instantiate(&drbg, entropy, 32, nonce, 16, NULL, 0);
+
+  // When
+  ASSERT_EQ(hmacDrbg_generate(&drbg, output, 128, NULL, 0), CRYPTID_SUCCESS);
+  ASSERT_EQ(hmacDrbg_generate(&drbg, output, 128, NULL, 0), CRYPTID_SUCCESS);
+
+  // Then
+  ASSERT_MEM_EQ(expected, output, 128);
+  hmacDrbg_destroy(&drbg);
+
+  PASS();
+}
+
+// The expected value is computed directly from the definitions of
+// SP 800-90A Section 10.1.2.
+TEST reseed_and_additional_input_should_match_the_reference() {
+  // Given
+  const unsigned char expected[] = {
+      0xb9, 0x55, 0x1e, 0xa8, 0xd4, 0x88, 0xa6, 0xd1, 0x96, 0x9e, 0x6d, 0xc4,
+      0x76, 0x14, 0xd1, 0xbd, 0xe3, 0x43, 0x5a, 0xa8, 0x63, 0x83, 0xcf, 0x05,
+      0xa6, 0xd8, 0x81, 0xd0, 0x0e, 0x74, 0x7e, 0xeb, 0xb4, 0x28, 0xda, 0x64,
+      0x0f, 0x0e, 0x57, 0x9e, 0x43, 0x78, 0x87, 0xdb, 0x78, 0x76, 0xa5, 0x20,
+      0xc2, 0xb3, 0x37, 0x5b, 0x6c, 0xa6, 0x03, 0x86, 0x83, 0xd0, 0xca, 0xf8,
+      0xe5, 0x0f, 0x68, 0x0a, 0x99, 0x39, 0xc5, 0x46, 0xd5, 0xde};
+  unsigned char entropy[32], nonce[16], reseedEntropy[32], output[70];
+  for (int i = 0; i < 32; i++) {
+    entropy[i] = (unsigned char)i;
+    reseedEntropy[i] = (unsigned char)(48 + i);
+  }
+  for (int i = 0; i < 16; i++) {
+    nonce[i] = (unsigned char)(32 + i);
+  }
+
+  HmacDrbg drbg;
+  hmacDrbg_instantiate(&drbg, entropy, 32, nonce, 16,
+                       (const unsigned char *)"personalization", 15);
+
+  // When
+  hmacDrbg_generate(&drbg, output, 40, (const unsigned char *)"additional",
+                    10);
+  hmacDrbg_reseed(&drbg, reseedEntropy, 32, (const unsigned char *)"reseed",
+                  6);
+  hmacDrbg_generate(&drbg, output, 70, NULL, 0);
+
+  // Then
+  ASSERT_MEM_EQ(expected, output, 70);
+  hmacDrbg_destroy(&drbg);
+
+  PASS();
+}
+
+TEST generate_should_reject_too_long_requests() {
+  HmacDrbg drbg;
+  unsigned char entropy[32] = {0};
+  hmacDrbg_instantiate(&drbg, entropy, 32, NULL, 0, NULL, 0);
+
+  ASSERT_EQ(hmacDrbg_generate(&drbg, NULL, HMACDRBG_MAX_REQUEST_SIZE + 1,
+                              NULL, 0),
+            CRYPTID_RANDOM_GENERATION_ERROR);
+
+  hmacDrbg_destroy(&drbg);
+
+  PASS();
+}
+
+TEST seeded_random_should_be_reproducible() {
+  // Given
+  const unsigned char seed[] = "benchmark seed of thirty-two octets";
+  mpz_t range, first, second;
+  mpz_init_set_str(range, "ffffffffffffffffffffffffffffff61", 16);
+  mpz_inits(first, second, NULL);
+
+  // When
+  random_setSeed(seed, sizeof(seed));
+  random_mpzInRange(first, range);
+
+  random_setSeed(seed, sizeof(seed));
+  random_mpzInRange(second, range);
+
+  random_setSeed(NULL, 0);
+
+  // Then
+  ASSERT_EQ(mpz_cmp(first, second), 0);
+
+  // The operating system seeds differently every time.
+  random_mpzInRange(first, range);
+  random_mpzInRange(second, range);
+  ASSERT(mpz_cmp(first, second));
+
+  mpz_clears(range, first, second, NULL);
+
+  PASS();
+}
+
+SUITE(hmac_drbg_suite) {
+  RUN_TEST(generate_should_match_the_cavp_example);
+  RUN_TEST(reseed_and_additional_input_should_match_the_reference);
+  RUN_TEST(generate_should_reject_too_long_requests);
+  RUN_TEST(seeded_random_should_be_reproducible);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(hmac_drbg_suite);
+
+  GREATEST_MAIN_END();
+}
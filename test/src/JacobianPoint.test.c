@@ -0,0 +1,172 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "elliptic/AffinePoint.h"
+#include "elliptic/EllipticCurve.h"
+#include "elliptic/JacobianPoint.h"
+
+TEST repeated_mixed_addition_should_match_affine_addition(
+    const long a, const long b, const long fieldOrder, const long x,
+    const long y) {
+  // Given
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, a, b, fieldOrder);
+  AffinePoint p;
+  affine_initLong(&p, x, y);
+
+  AffinePoint expected;
+  affine_initLong(&expected, x, y);
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ec);
+  JacobianPoint jacobian, normalizedP;
+  jacobian_initFromAffine(&jacobian, p, &curve);
+  jacobian_initFromAffine(&normalizedP, p, &curve);
+
+  // When
+  // Then
+  for (int i = 2; i < 2 * fieldOrder; i++) {
+    AffinePoint tmp;
+    ASSERT_EQ(affine_add(&tmp, expected, p, ec), CRYPTID_SUCCESS);
+    affine_destroy(expected);
+    expected = tmp;
+
+    jacobian_addNormalized(&jacobian, jacobian, normalizedP, &curve);
+
+    AffinePoint result;
+    jacobian_toAffine(&result, jacobian, &curve);
+    ASSERT(affine_isEquals(result, expected));
+    affine_destroy(result);
+  }
+
+  affine_destroy(p);
+  affine_destroy(expected);
+  jacobian_destroy(jacobian);
+  jacobian_destroy(normalizedP);
+  jacobian_destroyCurve(curve);
+  ellipticCurve_destroy(ec);
+
+  PASS();
+}
+
+TEST doubling_and_addition_should_agree(const long a, const long b,
+                                        const long fieldOrder, const long x,
+                                        const long y) {
+  // Given
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, a, b, fieldOrder);
+  AffinePoint p;
+  affine_initLong(&p, x, y);
+
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ec);
+  JacobianPoint normalizedP, threeP, doubleP, sum;
+  jacobian_initFromAffine(&normalizedP, p, &curve);
+  jacobian_initFromAffine(&threeP, p, &curve);
+  jacobian_initInfinity(&doubleP, &curve);
+  jacobian_initInfinity(&sum, &curve);
+
+  // When
+  jacobian_double(&doubleP, threeP, &curve);
+  jacobian_addNormalized(&threeP, doubleP, normalizedP, &curve);
+
+  // \f$4P = 2P + 2P = 3P + P\f$
+  jacobian_add(&sum, doubleP, doubleP, &curve);
+  jacobian_double(&doubleP, doubleP, &curve);
+  jacobian_addNormalized(&threeP, threeP, normalizedP, &curve);
+
+  // Then
+  AffinePoint single;
+  jacobian_toAffine(&single, sum, &curve);
+
+  JacobianPoint points[3] = {sum, doubleP, threeP};
+  jacobian_normalizeMany(points, 3, &curve);
+
+  for (int i = 0; i < 3; i++) {
+    AffinePoint result;
+    jacobian_toAffine(&result, points[i], &curve);
+    ASSERT(affine_isEquals(result, single));
+    affine_destroy(result);
+
+    ASSERT(jacobian_isInfinity(points[i], &curve) ||
+           mpn_cmp(points[i].z, curve.one, curve.field.limbCount) == 0);
+  }
+
+  affine_destroy(single);
+  for (int i = 0; i < 3; i++) {
+    jacobian_destroy(points[i]);
+  }
+  jacobian_destroy(normalizedP);
+  jacobian_destroyCurve(curve);
+  affine_destroy(p);
+  ellipticCurve_destroy(ec);
+
+  PASS();
+}
+
+TEST inverse_points_should_add_to_infinity(void) {
+  // Given
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, 0, 1, 11);
+  AffinePoint p, minusP;
+  affine_initLong(&p, 2, 3);
+  affine_initLong(&minusP, 2, 8);
+
+  JacobianCurve curve;
+  jacobian_initCurve(&curve, ec);
+  JacobianPoint jacobian, normalizedMinusP, negatedP;
+  jacobian_initFromAffine(&jacobian, p, &curve);
+  jacobian_initFromAffine(&normalizedMinusP, minusP, &curve);
+  jacobian_initInfinity(&negatedP, &curve);
+
+  // When
+  jacobian_negate(&negatedP, jacobian, &curve);
+  jacobian_addNormalized(&jacobian, jacobian, normalizedMinusP, &curve);
+
+  // Then
+  ASSERT(jacobian_isInfinity(jacobian, &curve));
+
+  AffinePoint result;
+  jacobian_toAffine(&result, jacobian, &curve);
+  ASSERT(affine_isInfinity(result));
+
+  AffinePoint negated;
+  jacobian_toAffine(&negated, negatedP, &curve);
+  ASSERT(affine_isEquals(negated, minusP));
+
+  affine_destroy(result);
+  affine_destroy(negated);
+  affine_destroy(p);
+  affine_destroy(minusP);
+  jacobian_destroy(jacobian);
+  jacobian_destroy(normalizedMinusP);
+  jacobian_destroy(negatedP);
+  jacobian_destroyCurve(curve);
+  ellipticCurve_destroy(ec);
+
+  PASS();
+}
+
+SUITE(jacobian_suite) {
+  // \f$y^2 = x^3 + 1\f$ over \f$F_{11}\f$ and \f$y^2 = x^3 + 2x + 3\f$ over
+  // \f$F_{97}\f$.
+  RUN_TESTp(repeated_mixed_addition_should_match_affine_addition, 0, 1, 11, 2,
+            3);
+  RUN_TESTp(repeated_mixed_addition_should_match_affine_addition, 2, 3, 97, 3,
+            6);
+  RUN_TESTp(doubling_and_addition_should_agree, 0, 1, 11, 2, 3);
+  RUN_TESTp(doubling_and_addition_should_agree, 2, 3, 97, 3, 6);
+  RUN_TEST(inverse_points_should_add_to_infinity);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(jacobian_suite);
+
+  GREATEST_MAIN_END();
+}
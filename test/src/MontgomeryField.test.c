@@ -0,0 +1,153 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "util/MontgomeryField.h"
+
+TEST conversion_should_round_trip(const char *const modulusHex,
+                                  const char *const valueHex) {
+  // Given
+  mpz_t p, value, expected, result;
+  mpz_init_set_str(p, modulusHex, 16);
+  mpz_init_set_str(value, valueHex, 16);
+  mpz_inits(expected, result, NULL);
+  mpz_mod(expected, value, p);
+
+  MontgomeryField field;
+  montgomeryField_init(&field, p);
+  mp_limb_t *element;
+  montgomeryField_initElements(&element, 1, &field);
+
+  // When
+  montgomeryField_fromMpz(element, value, &field);
+  montgomeryField_toMpz(result, element, &field);
+
+  // Then
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  free(element);
+  montgomeryField_destroy(field);
+  mpz_clears(p, value, expected, result, NULL);
+
+  PASS();
+}
+
+TEST operations_should_match_mpz(const char *const modulusHex,
+                                 const char *const aHex,
+                                 const char *const bHex) {
+  // Given
+  mpz_t p, a, b, expected, result;
+  mpz_init_set_str(p, modulusHex, 16);
+  mpz_init_set_str(a, aHex, 16);
+  mpz_init_set_str(b, bHex, 16);
+  mpz_inits(expected, result, NULL);
+  mpz_mod(a, a, p);
+  mpz_mod(b, b, p);
+
+  MontgomeryField field;
+  montgomeryField_init(&field, p);
+  mp_limb_t *elements;
+  montgomeryField_initElements(&elements, 3, &field);
+  mp_limb_t *x = elements;
+  mp_limb_t *y = elements + field.limbCount;
+  mp_limb_t *r = elements + 2 * field.limbCount;
+  montgomeryField_fromMpz(x, a, &field);
+  montgomeryField_fromMpz(y, b, &field);
+
+  // When, Then
+  montgomeryField_add(r, x, y, &field);
+  montgomeryField_toMpz(result, r, &field);
+  mpz_add(expected, a, b);
+  mpz_mod(expected, expected, p);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  montgomeryField_sub(r, x, y, &field);
+  montgomeryField_toMpz(result, r, &field);
+  mpz_sub(expected, a, b);
+  mpz_mod(expected, expected, p);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  montgomeryField_neg(r, x, &field);
+  montgomeryField_toMpz(result, r, &field);
+  mpz_neg(expected, a);
+  mpz_mod(expected, expected, p);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  montgomeryField_mul(r, x, y, &field);
+  montgomeryField_toMpz(result, r, &field);
+  mpz_mul(expected, a, b);
+  mpz_mod(expected, expected, p);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  montgomeryField_sqr(r, x, &field);
+  montgomeryField_toMpz(result, r, &field);
+  mpz_mul(expected, a, a);
+  mpz_mod(expected, expected, p);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  // In place.
+  montgomeryField_mul(x, x, x, &field);
+  montgomeryField_toMpz(result, x, &field);
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  CryptidStatus status = montgomeryField_inverse(r, y, &field);
+  if (mpz_sgn(b)) {
+    ASSERT_EQ(status, CRYPTID_SUCCESS);
+    montgomeryField_toMpz(result, r, &field);
+    mpz_invert(expected, b, p);
+    ASSERT_EQ(mpz_cmp(result, expected), 0);
+  } else {
+    ASSERT_EQ(status, CRYPTID_HAS_NO_MUL_INV_ERROR);
+  }
+
+  free(elements);
+  montgomeryField_destroy(field);
+  mpz_clears(p, a, b, expected, result, NULL);
+
+  PASS();
+}
+
+// \f$2^{127} - 1\f$, \f$2^{128} - 159\f$ filling its top limb,
+// \f$2^{512} - 569\f$ and \f$2^{1024} - 105\f$ of the nominal lengths of the
+// two lowest security levels and \f$2^{521} - 1\f$ exceeding the nominal
+// length.
+static const char *const MODULI[] = {
+    "7", "7fffffffffffffffffffffffffffffff", "ffffffffffffffffffffffffffffff61",
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffdc7",
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffff97",
+    "1fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffff"};
+
+SUITE(montgomery_field_suite) {
+  for (size_t i = 0; i < sizeof(MODULI) / sizeof(MODULI[0]); i++) {
+    RUN_TESTp(conversion_should_round_trip, MODULI[i], "0");
+    RUN_TESTp(conversion_should_round_trip, MODULI[i], "1");
+    RUN_TESTp(conversion_should_round_trip, MODULI[i], "-3");
+    RUN_TESTp(conversion_should_round_trip, MODULI[i],
+              "123456789abcdef0fedcba98765432100123456789abcdef");
+
+    RUN_TESTp(operations_should_match_mpz, MODULI[i], "0", "0");
+    RUN_TESTp(operations_should_match_mpz, MODULI[i], "-1", "-2");
+    RUN_TESTp(operations_should_match_mpz, MODULI[i], "5",
+              "fedcba98765432100123456789abcdef");
+    RUN_TESTp(operations_should_match_mpz, MODULI[i],
+              "d4c8a4ea2a91c2ee65b1f0b31fa38d9b0123456789",
+              "-123456789abcdef0fedcba9876543210");
+  }
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(montgomery_field_suite);
+
+  GREATEST_MAIN_END();
+}
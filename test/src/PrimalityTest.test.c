@@ -0,0 +1,217 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "util/Parallel.h"
+#include "util/PrimalityTest.h"
+#include "util/Random.h"
+
+// Strong pseudoprimes to base 2, and strong Lucas pseudoprimes with the
+// parameters of Selfridge's Method A.
+static const char *const PSEUDOPRIMES[] = {
+    "2047", "3277", "4033", "4681", "8321", "3215031751", "2152302898747",
+    "3474749660383", "341550071728321", "3825123056546413051",
+    // \f$2^{64}\f$ would not hold this one.
+    "318665857834031151167461", "5459", "5777", "10877", "16109", "18971",
+    "22499", "24569", "25199", "40309", "58519"};
+
+TEST policy_should_agree_with_gmp_on_small_numbers(
+    const PrimalityTestPolicy policy, const PrimalityTestPurpose purpose) {
+  // Given
+  mpz_t n;
+  mpz_init(n);
+
+  // When, Then
+  for (unsigned long i = 0; i < 20000; i++) {
+    mpz_set_ui(n, i);
+
+    ASSERT_EQ(mpz_probab_prime_p(n, 30) != 0,
+              primalityTest_isProbablePrimeWithPolicy(n, policy, purpose) ==
+                  CRYPTID_VALIDATION_SUCCESS);
+  }
+
+  mpz_clear(n);
+
+  PASS();
+}
+
+TEST policy_should_agree_with_gmp_on_large_numbers(
+    const PrimalityTestPolicy policy, const PrimalityTestPurpose purpose) {
+  // Given
+  mpz_t n;
+  mpz_init(n);
+
+  // When, Then
+  // Random odd numbers, then the primes found after them.
+  for (int i = 0; i < 100; i++) {
+    random_mpzOfLength(n, 256 + 64 * (i % 4));
+    mpz_setbit(n, 0);
+
+    ASSERT_EQ(mpz_probab_prime_p(n, 30) != 0,
+              primalityTest_isProbablePrimeWithPolicy(n, policy, purpose) ==
+                  CRYPTID_VALIDATION_SUCCESS);
+
+    mpz_nextprime(n, n);
+
+    ASSERT_EQ(primalityTest_isProbablePrimeWithPolicy(n, policy, purpose),
+              CRYPTID_VALIDATION_SUCCESS);
+  }
+
+  mpz_clear(n);
+
+  PASS();
+}
+
+TEST policy_should_reject_pseudoprimes(const PrimalityTestPolicy policy,
+                                       const PrimalityTestPurpose purpose) {
+  // Given
+  mpz_t n;
+  mpz_init(n);
+
+  // When, Then
+  for (size_t i = 0; i < sizeof(PSEUDOPRIMES) / sizeof(PSEUDOPRIMES[0]); i++) {
+    mpz_set_str(n, PSEUDOPRIMES[i], 10);
+
+    ASSERT_EQ(primalityTest_isProbablePrimeWithPolicy(n, policy, purpose),
+              CRYPTID_VALIDATION_FAILURE);
+  }
+
+  // A square, having no parameter of Method A.
+  mpz_set_ui(n, 1000003);
+  mpz_mul(n, n, n);
+  ASSERT_EQ(primalityTest_isProbablePrimeWithPolicy(n, policy, purpose),
+            CRYPTID_VALIDATION_FAILURE);
+
+  mpz_clear(n);
+
+  PASS();
+}
+
+TEST millerRabinRounds_should_depend_on_size() {
+  // Too small for the bounds.
+  ASSERT_EQ(primalityTest_millerRabinRounds(16),
+            PRIMALITYTEST_ERROR_BITS / 2);
+
+  for (unsigned long bitLength = 21; bitLength <= 8192; bitLength += 11) {
+    const int rounds = primalityTest_millerRabinRounds(bitLength);
+
+    ASSERT(rounds >= 3);
+    ASSERT(rounds <= PRIMALITYTEST_ERROR_BITS / 2);
+  }
+
+  ASSERT(primalityTest_millerRabinRounds(160) < 30);
+  ASSERT_EQ(primalityTest_millerRabinRounds(512), 8);
+  ASSERT_EQ(primalityTest_millerRabinRounds(1024), 4);
+  ASSERT_EQ(primalityTest_millerRabinRounds(4096), 3);
+
+  PASS();
+}
+
+TEST trusted_policy_should_only_skip_validation() {
+  // Given
+  mpz_t composite;
+  mpz_init_set_ui(composite, 1000001);
+
+  primalityTest_setPolicy(primalityTest_VALIDATION, primalityTest_TRUSTED);
+  primalityTest_setPolicy(primalityTest_GENERATION, primalityTest_TRUSTED);
+
+  // When
+  const CryptidValidationResult validation =
+      primalityTest_isProbablePrime(composite, primalityTest_VALIDATION);
+  const CryptidValidationResult generation =
+      primalityTest_isProbablePrime(composite, primalityTest_GENERATION);
+
+  primalityTest_setPolicy(primalityTest_VALIDATION,
+                          primalityTest_MILLER_RABIN);
+  primalityTest_setPolicy(primalityTest_GENERATION,
+                          primalityTest_MILLER_RABIN);
+
+  // Then
+  ASSERT_EQ(validation, CRYPTID_VALIDATION_SUCCESS);
+  ASSERT_EQ(generation, CRYPTID_VALIDATION_FAILURE);
+
+  ASSERT_EQ(primalityTest_isProbablePrime(composite, primalityTest_VALIDATION),
+            CRYPTID_VALIDATION_FAILURE);
+
+  mpz_clear(composite);
+
+  PASS();
+}
+
+// The first task switches the generation policy back and forth, the others
+// test a prime meanwhile, each counting the times it is rejected.
+static void switchPolicyOrTest(void *argument, const int taskIndex,
+                               const int taskCount) {
+  (void)taskCount;
+  int *rejectedCounts = (int *)argument;
+  mpz_t prime;
+  mpz_init_set_str(prime, "170141183460469231731687303715884105727", 10);
+
+  for (int i = 0; i < 200; i++) {
+    if (taskIndex == 0) {
+      primalityTest_setPolicy(primalityTest_GENERATION,
+                              i % 2 ? primalityTest_MILLER_RABIN
+                                    : primalityTest_BAILLIE_PSW);
+    } else if (!primalityTest_isProbablePrime(prime,
+                                              primalityTest_GENERATION)) {
+      rejectedCounts[taskIndex]++;
+    }
+  }
+
+  mpz_clear(prime);
+}
+
+TEST policy_should_be_settable_while_testing_on_other_threads(void) {
+  // Given
+  int rejectedCounts[4] = {0};
+  parallel_setThreadCount(4);
+
+  // When
+  parallel_run(switchPolicyOrTest, rejectedCounts, 4);
+
+  parallel_setThreadCount(0);
+  primalityTest_setPolicy(primalityTest_GENERATION,
+                          primalityTest_MILLER_RABIN);
+
+  // Then
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(rejectedCounts[i], 0);
+  }
+
+  PASS();
+}
+
+SUITE(primality_test_suite) {
+  RUN_TESTp(policy_should_agree_with_gmp_on_small_numbers,
+            primalityTest_MILLER_RABIN, primalityTest_GENERATION);
+  RUN_TESTp(policy_should_agree_with_gmp_on_small_numbers,
+            primalityTest_BAILLIE_PSW, primalityTest_VALIDATION);
+
+  RUN_TESTp(policy_should_agree_with_gmp_on_large_numbers,
+            primalityTest_MILLER_RABIN, primalityTest_GENERATION);
+  RUN_TESTp(policy_should_agree_with_gmp_on_large_numbers,
+            primalityTest_MILLER_RABIN, primalityTest_VALIDATION);
+  RUN_TESTp(policy_should_agree_with_gmp_on_large_numbers,
+            primalityTest_BAILLIE_PSW, primalityTest_VALIDATION);
+
+  RUN_TESTp(policy_should_reject_pseudoprimes, primalityTest_MILLER_RABIN,
+            primalityTest_VALIDATION);
+  RUN_TESTp(policy_should_reject_pseudoprimes, primalityTest_BAILLIE_PSW,
+            primalityTest_VALIDATION);
+
+  RUN_TEST(millerRabinRounds_should_depend_on_size);
+  RUN_TEST(trusted_policy_should_only_skip_validation);
+  RUN_TEST(policy_should_be_settable_while_testing_on_other_threads);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(primality_test_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,80 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "util/RandBytes.h"
+
+TEST randomBytes_should_fill_the_buffer(const int num) {
+  // Given
+  unsigned char *const first = calloc(num, sizeof(unsigned char));
+  unsigned char *const second = calloc(num, sizeof(unsigned char));
+
+  // When
+  ASSERT_EQ(cryptid_randomBytes(first, num), CRYPTID_SUCCESS);
+  ASSERT_EQ(cryptid_randomBytes(second, num), CRYPTID_SUCCESS);
+
+  // Then
+  // Two draws of at least 16 octets collide with a negligible probability.
+  ASSERT(memcmp(first, second, num));
+
+  int nonZeroCount = 0;
+  for (int i = 0; i < num; i++) {
+    nonZeroCount += first[i] != 0;
+  }
+  ASSERT(nonZeroCount > num / 2);
+
+  free(first);
+  free(second);
+
+  PASS();
+}
+
+TEST small_requests_should_not_repeat_across_refills() {
+  // Given
+  const int requestCount = 1000;
+  const int num = 13;
+  unsigned char *const drawn = malloc(requestCount * num);
+
+  // When
+  for (int i = 0; i < requestCount; i++) {
+    ASSERT_EQ(cryptid_randomBytes(drawn + i * num, num), CRYPTID_SUCCESS);
+  }
+
+  // Then
+  for (int i = 1; i < requestCount; i++) {
+    ASSERT(memcmp(drawn + (i - 1) * num, drawn + i * num, num));
+  }
+
+  free(drawn);
+
+  PASS();
+}
+
+TEST randomBytes_should_reject_negative_length() {
+  unsigned char buffer[1];
+
+  ASSERT_EQ(cryptid_randomBytes(buffer, -1), CRYPTID_RANDOM_GENERATION_ERROR);
+
+  PASS();
+}
+
+SUITE(rand_bytes_suite) {
+  RUN_TESTp(randomBytes_should_fill_the_buffer, 16);
+  RUN_TESTp(randomBytes_should_fill_the_buffer, 1500);
+  RUN_TESTp(randomBytes_should_fill_the_buffer, 100000);
+  RUN_TEST(small_requests_should_not_repeat_across_refills);
+  RUN_TEST(randomBytes_should_reject_negative_length);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(rand_bytes_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,122 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "greatest.h"
+
+#include "util/Parallel.h"
+#include "util/Random.h"
+
+TEST pairingPrime_should_give_a_prime_of_the_form(const unsigned int qBits,
+                                                  const unsigned int rBits,
+                                                  const int threadCount) {
+  // Given
+  mpz_t q, r, p, expected;
+  mpz_inits(q, r, p, expected, NULL);
+  ASSERT_EQ(random_solinasPrime(q, qBits, 100), CRYPTID_SUCCESS);
+
+  parallel_setThreadCount(threadCount);
+
+  // When
+  CryptidStatus status = random_pairingPrime(p, r, q, rBits);
+
+  parallel_setThreadCount(0);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+
+  mpz_mul_ui(expected, r, 12);
+  mpz_mul(expected, expected, q);
+  mpz_sub_ui(expected, expected, 1);
+  ASSERT_EQ(mpz_cmp(p, expected), 0);
+
+  ASSERT(mpz_sizeinbase(r, 2) <= rBits);
+  ASSERT(mpz_probab_prime_p(p, 30));
+
+  mpz_clears(q, r, p, expected, NULL);
+
+  PASS();
+}
+
+// Seeds the generator, then selects a pairing prime on threadCount threads.
+static CryptidStatus seededPairingPrime(mpz_t p, mpz_t r, const mpz_t q,
+                                        const int threadCount) {
+  const unsigned char seed[32] = "pairing prime seed";
+
+  random_setSeed(seed, sizeof(seed));
+  parallel_setThreadCount(threadCount);
+
+  CryptidStatus status = random_pairingPrime(p, r, q, 349);
+
+  parallel_setThreadCount(0);
+  random_setSeed(NULL, 0);
+
+  return status;
+}
+
+TEST seeded_pairingPrime_should_not_depend_on_thread_count(void) {
+  // Given
+  mpz_t q, p1, r1, p4, r4, p4Again, r4Again;
+  mpz_inits(q, p1, r1, p4, r4, p4Again, r4Again, NULL);
+  ASSERT_EQ(random_solinasPrime(q, 160, 100), CRYPTID_SUCCESS);
+
+  // When
+  ASSERT_EQ(seededPairingPrime(p1, r1, q, 1), CRYPTID_SUCCESS);
+  ASSERT_EQ(seededPairingPrime(p4, r4, q, 4), CRYPTID_SUCCESS);
+  ASSERT_EQ(seededPairingPrime(p4Again, r4Again, q, 4), CRYPTID_SUCCESS);
+
+  // Then
+  ASSERT_EQ(mpz_cmp(p4, p4Again), 0);
+  ASSERT_EQ(mpz_cmp(r4, r4Again), 0);
+  ASSERT_EQ(mpz_cmp(p1, p4), 0);
+  ASSERT_EQ(mpz_cmp(r1, r4), 0);
+
+  mpz_clears(q, p1, r1, p4, r4, p4Again, r4Again, NULL);
+
+  PASS();
+}
+
+TEST solinasPrime_should_give_a_solinas_prime(const unsigned int numberOfBits) {
+  // Given
+  mpz_t q, b;
+  mpz_inits(q, b, NULL);
+
+  // When
+  ASSERT_EQ(random_solinasPrime(q, numberOfBits, 100), CRYPTID_SUCCESS);
+
+  // Then
+  ASSERT(mpz_probab_prime_p(q, 30));
+
+  // \f$2^a - q - 1\f$ is a single power of two.
+  mpz_ui_pow_ui(b, 2, numberOfBits);
+  mpz_sub(b, b, q);
+  mpz_sub_ui(b, b, 1);
+  ASSERT_EQ(mpz_popcount(b), 1);
+
+  mpz_clears(q, b, NULL);
+
+  PASS();
+}
+
+SUITE(random_suite) {
+  RUN_TESTp(pairingPrime_should_give_a_prime_of_the_form, 160, 349, 1);
+  RUN_TESTp(pairingPrime_should_give_a_prime_of_the_form, 224, 797, 1);
+  RUN_TESTp(pairingPrime_should_give_a_prime_of_the_form, 224, 797, 4);
+  // Windows close to the top of the range of r.
+  RUN_TESTp(pairingPrime_should_give_a_prime_of_the_form, 160, 12, 1);
+  RUN_TESTp(pairingPrime_should_give_a_prime_of_the_form, 160, 12, 4);
+  RUN_TEST(seeded_pairingPrime_should_not_depend_on_thread_count);
+
+  RUN_TESTp(solinasPrime_should_give_a_solinas_prime, 160);
+  RUN_TESTp(solinasPrime_should_give_a_solinas_prime, 256);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(random_suite);
+
+  GREATEST_MAIN_END();
+}
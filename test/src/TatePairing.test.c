@@ -93,6 +93,110 @@ TEST RFC_5091_tate_pairing_should_work(void) {
   PASS();
 }
 
+TEST GF_131_multi_pairing_should_be_product_of_pairings(void) {
+  // Given
+  int embeddingDegree = 2;
+  mpz_t subgroupOrder, two, three;
+  mpz_init_set_ui(subgroupOrder, 11);
+  mpz_init_set_ui(two, 2);
+  mpz_init_set_ui(three, 3);
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, 0, 1, 131);
+  AffinePoint a, twoA, threeA;
+  affine_initLong(&a, 98, 58);
+  affine_wNAFMultiply(&twoA, a, two, ec);
+  affine_wNAFMultiply(&threeA, a, three, ec);
+
+  // \f$e(a, 2a) \cdot e(a, 3a) \cdot e(\infty, a) = e(a, 5a)\f$
+  AffinePoint ps[] = {a, a, affine_infinity()};
+  AffinePoint bs[] = {twoA, threeA, a};
+  Complex expected;
+  complex_initLong(&expected, 39, 24);
+
+  // When
+  Complex result;
+  CryptidStatus status = tate_performMultiPairing(
+      &result, ps, bs, 3, embeddingDegree, subgroupOrder, ec);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT(complex_isEquals(result, expected));
+
+  affine_destroy(a);
+  affine_destroy(twoA);
+  affine_destroy(threeA);
+  affine_destroy(ps[2]);
+  mpz_clears(subgroupOrder, two, three, NULL);
+  ellipticCurve_destroy(ec);
+  complex_destroyMany(2, result, expected);
+
+  PASS();
+}
+
+TEST empty_multi_pairing_should_be_one(void) {
+  // Given
+  mpz_t subgroupOrder;
+  mpz_init_set_ui(subgroupOrder, 11);
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, 0, 1, 131);
+  Complex expected;
+  complex_initLong(&expected, 1, 0);
+
+  // When
+  Complex result;
+  CryptidStatus status =
+      tate_performMultiPairing(&result, NULL, NULL, 0, 2, subgroupOrder, ec);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT(complex_isEquals(result, expected));
+
+  mpz_clear(subgroupOrder);
+  ellipticCurve_destroy(ec);
+  complex_destroyMany(2, result, expected);
+
+  PASS();
+}
+
+TEST GF_131_pairing_with_lines_should_match_pairing(const long n) {
+  // Given
+  mpz_t subgroupOrder, mul;
+  mpz_init_set_ui(subgroupOrder, 11);
+  mpz_init_set_ui(mul, n);
+  EllipticCurve ec;
+  ellipticCurve_initLong(&ec, 0, 1, 131);
+  AffinePoint a;
+  affine_initLong(&a, 98, 58);
+  AffinePoint b;
+  affine_wNAFMultiply(&b, a, mul, ec);
+
+  TatePairingPrecomputation precomputation;
+  tate_initPrecomputation(&precomputation, 2, subgroupOrder, ec);
+  TatePairingLines lines;
+  tate_initLines(&lines, a, subgroupOrder, ec);
+
+  // When
+  Complex result, expected;
+  CryptidStatus status = tate_performPairingWithLines(
+      &result, lines, b, precomputation, subgroupOrder, ec);
+
+  // Then
+  ASSERT_EQ(status, CRYPTID_SUCCESS);
+  ASSERT_EQ(tate_performPairing(&expected, a, b, 2, subgroupOrder, ec),
+            CRYPTID_SUCCESS);
+  ASSERT(complex_isEquals(result, expected));
+
+  affine_destroy(a);
+  affine_destroy(b);
+  tate_destroyLines(lines);
+  tate_destroyPrecomputation(precomputation);
+  mpz_clears(subgroupOrder, mul, NULL);
+  ellipticCurve_destroy(ec);
+  complex_destroyMany(2, result, expected);
+
+  PASS();
+}
+
 SUITE(tate_pairing_suite) {
   {
     Complex expected[11];
@@ -118,6 +222,11 @@ SUITE(tate_pairing_suite) {
   }
 
   RUN_TEST(RFC_5091_tate_pairing_should_work);
+  RUN_TEST(GF_131_multi_pairing_should_be_product_of_pairings);
+  RUN_TEST(empty_multi_pairing_should_be_one);
+  for (long n = 1; n <= 11; ++n) {
+    RUN_TESTp(GF_131_pairing_with_lines_should_match_pairing, n);
+  }
 }
 
 GREATEST_MAIN_DEFS();
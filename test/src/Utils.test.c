@@ -0,0 +1,228 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "util/Parallel.h"
+#include "util/Utils.h"
+
+// The expected values are computed directly from the definitions of
+// Algorithms 4.1.1 (HashToRange), 4.2.1 (HashBytes) and 4.3.2 (Canonical1) in
+// RFC 5091.
+
+static const char *const P_521 =
+    "1fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+
+static const char *const P_1024 =
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    "ffffffffffffffffffffffffffffffffffffff97";
+
+static const unsigned char HASH_BYTES_SHA1_ABC[] = {
+    0x34, 0x46, 0x6d, 0xa9, 0xea, 0x35, 0xf7, 0x51, 0x83, 0xb8, 0x29, 0x1d,
+    0xd7, 0x10, 0xcc, 0x9a, 0xfd, 0xfb, 0x11, 0x24, 0x8b, 0xdf, 0x31, 0x52,
+    0xba, 0xb2, 0xd0, 0x3d, 0x6f, 0x98, 0xde, 0xbc, 0xde, 0xdb, 0x53, 0xcc,
+    0x1f, 0x20, 0x0e, 0xdc};
+
+static const unsigned char HASH_BYTES_SHA256_EMPTY[] = {
+    0x4b, 0x57, 0xc9, 0xd6, 0xd2, 0xfb, 0x4d, 0x5b, 0x8c, 0x09, 0x16, 0xdd,
+    0xdb, 0x7d, 0xc2, 0xaf, 0x41, 0xdf, 0x03, 0xb0, 0xac, 0x7a, 0x29, 0x50,
+    0xd1, 0xdf, 0xa9, 0x8e, 0x38, 0xa7, 0x4e, 0x62, 0x24, 0xa6, 0xa0, 0x4c,
+    0xc9, 0xe5, 0x04, 0x31, 0xdc, 0xca, 0xd4, 0x66, 0x00, 0x01, 0x6e, 0x7f,
+    0x75, 0x28, 0xdc, 0xb5, 0x21, 0x09, 0xfd, 0xd1, 0xce, 0x4a, 0x56, 0xb1,
+    0xa5, 0xf7, 0xb0, 0xfd, 0x7f, 0xe7, 0x93, 0x37, 0xab, 0x8e};
+
+static const unsigned char LONG_HASH_BYTES_SHA256_DIGEST[] = {
+    0xd7, 0x82, 0x6d, 0xe1, 0x79, 0xb3, 0xff, 0xc0, 0x10, 0xe1, 0x9d, 0x30,
+    0xc4, 0x9b, 0xde, 0x43, 0x6f, 0xeb, 0xa3, 0x3b, 0x80, 0x93, 0x61, 0x6c,
+    0x1e, 0xb5, 0x18, 0xe8, 0xe0, 0x3c, 0xec, 0x80};
+
+static const unsigned char LONG_HASH_BYTES_SHA512_DIGEST[] = {
+    0x09, 0xdf, 0xc1, 0x82, 0x69, 0x8e, 0x1e, 0x18, 0x42, 0x1a, 0xf0, 0x53,
+    0x6c, 0xa3, 0x45, 0xc1, 0x62, 0x52, 0x3b, 0x9b, 0x3c, 0x99, 0x59, 0xeb,
+    0xab, 0x46, 0x91, 0xc3, 0x3c, 0x7a, 0x4e, 0xe8};
+
+static const unsigned char CANONICAL_ORDER_0[] = {
+    0x0a, 0x03};
+
+static const unsigned char CANONICAL_ORDER_1[] = {
+    0x03, 0x0a};
+
+static const unsigned char CANONICAL_ODD_DIGITS[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0a, 0xbc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+static const unsigned char CANONICAL_P_521[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe};
+
+TEST hashToRange_should_match_the_reference(const char *const s,
+                                            const HashFunction hashFunction,
+                                            const char *const pHex,
+                                            const char *const expectedHex) {
+  // Given
+  mpz_t p, result, expected;
+  mpz_init_set_str(p, pHex, 16);
+  mpz_init_set_str(expected, expectedHex, 16);
+  mpz_init(result);
+
+  // When
+  hashToRange(result, (const unsigned char *)s, strlen(s), p, hashFunction);
+
+  // Then
+  ASSERT_EQ(mpz_cmp(result, expected), 0);
+
+  mpz_clears(p, result, expected, NULL);
+
+  PASS();
+}
+
+TEST hashBytes_should_match_the_reference(const int b, const char *const p,
+                                          const HashFunction hashFunction,
+                                          const unsigned char *const expected) {
+  // Given, When
+  unsigned char *result;
+  hashBytes(&result, b, (const unsigned char *)p, strlen(p), hashFunction);
+
+  // Then
+  ASSERT_MEM_EQ(expected, result, b);
+  ASSERT_EQ(result[b], '\0');
+
+  free(result);
+
+  PASS();
+}
+
+// Long outputs are split across threads, so they are compared by their SHA-256
+// digest, for any number of threads.
+TEST long_hashBytes_should_not_depend_on_the_thread_count(
+    const int b, const HashFunction hashFunction,
+    const unsigned char *const expectedDigest) {
+  const int threadCounts[] = {1, 3, 0};
+
+  for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+    // Given
+    parallel_setThreadCount(threadCounts[i]);
+
+    // When
+    unsigned char *result;
+    hashBytes(&result, b, (const unsigned char *)"abc", 3, hashFunction);
+
+    // Then
+    unsigned char digest[HASHFUNCTION_MAX_HASH_SIZE];
+    hashFunction_hash(digest, result, b, hashFunction_SHA256);
+
+    ASSERT_MEM_EQ(expectedDigest, digest, 32);
+
+    free(result);
+  }
+
+  PASS();
+}
+
+TEST canonical_should_match_the_reference(const char *const realHex,
+                                          const char *const imaginaryHex,
+                                          const char *const pHex,
+                                          const int order,
+                                          const unsigned char *const expected,
+                                          const int expectedLength) {
+  // Given
+  mpz_t p, real, imaginary;
+  mpz_init_set_str(p, pHex, 16);
+  mpz_init_set_str(real, realHex, 16);
+  mpz_init_set_str(imaginary, imaginaryHex, 16);
+  Complex v;
+  complex_initMpz(&v, real, imaginary);
+
+  // When
+  unsigned char *result;
+  int resultLength;
+  canonical(&result, &resultLength, v, p, order);
+
+  // Then
+  ASSERT_EQ(resultLength, expectedLength);
+  ASSERT_MEM_EQ(expected, result, resultLength);
+
+  free(result);
+  complex_destroy(v);
+  mpz_clears(p, real, imaginary, NULL);
+
+  PASS();
+}
+
+SUITE(hash_to_range_suite) {
+  RUN_TESTp(hashToRange_should_match_the_reference, "abc", hashFunction_SHA1,
+            "11", "c");
+  RUN_TESTp(hashToRange_should_match_the_reference, "abc", hashFunction_SHA1,
+            "7fffffffffffffffffffffffffffffff",
+            "3dc9bd969bc40d5e43361aa98b5d13bb");
+  RUN_TESTp(hashToRange_should_match_the_reference, "", hashFunction_SHA256,
+            "7fffffffffffffffffffffffffffffff",
+            "3b144cea51c5ebf5b21b5e81d59d7b75");
+  RUN_TESTp(hashToRange_should_match_the_reference,
+            "Alice <alice@example.com>", hashFunction_SHA256, P_521,
+            "7ae067ec76b05034a8db024b509802432812afd1205f74ca6fe6db9ca0ba3d59"
+            "1e23d3ea738fb469f647ecd21e3860b8476dd6aecf485484fee454bfb2bcc60");
+  RUN_TESTp(hashToRange_should_match_the_reference, "abc",
+            hashFunction_SHA512, P_1024,
+            "7682b6b84c6f692545a896ad210299bcc6f74e189d829e165739b11dd83b6f2c"
+            "8cfacf27e812bf064df756d6235ac33c062b89ecb80f8215516dbbb844ce8480"
+            "d2d0ca39ebf74a69d147d88373e5591ca4f21ce0b33d421ee0d48151855bfb89"
+            "825f98651c85ed93e32c1a9848c7a21e1611e133b9b4d72b3501fd0499a5c6d0");
+}
+
+SUITE(hash_bytes_suite) {
+  RUN_TESTp(hashBytes_should_match_the_reference, 40, "abc", hashFunction_SHA1,
+            HASH_BYTES_SHA1_ABC);
+  RUN_TESTp(hashBytes_should_match_the_reference, 70, "", hashFunction_SHA256,
+            HASH_BYTES_SHA256_EMPTY);
+  // No octets of any output.
+  RUN_TESTp(hashBytes_should_match_the_reference, 0, "abc", hashFunction_SHA1,
+            HASH_BYTES_SHA1_ABC);
+
+  RUN_TESTp(long_hashBytes_should_not_depend_on_the_thread_count, 300001,
+            hashFunction_SHA256, LONG_HASH_BYTES_SHA256_DIGEST);
+  RUN_TESTp(long_hashBytes_should_not_depend_on_the_thread_count, 262144,
+            hashFunction_SHA512, LONG_HASH_BYTES_SHA512_DIGEST);
+}
+
+SUITE(canonical_suite) {
+  RUN_TESTp(canonical_should_match_the_reference, "a", "3", "11", 0,
+            CANONICAL_ORDER_0, sizeof(CANONICAL_ORDER_0));
+  RUN_TESTp(canonical_should_match_the_reference, "a", "3", "11", 1,
+            CANONICAL_ORDER_1, sizeof(CANONICAL_ORDER_1));
+  // A coordinate with an odd number of hexadecimal digits.
+  RUN_TESTp(canonical_should_match_the_reference, "abc", "0",
+            "7fffffffffffffffffffffffffffffff", 0,
+            CANONICAL_ODD_DIGITS, sizeof(CANONICAL_ODD_DIGITS));
+  RUN_TESTp(canonical_should_match_the_reference,
+            "1fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+            "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+            "ffe",
+            "1", P_521, 1, CANONICAL_P_521, sizeof(CANONICAL_P_521));
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(hash_to_range_suite);
+  RUN_SUITE(hash_bytes_suite);
+  RUN_SUITE(canonical_suite);
+
+  GREATEST_MAIN_END();
+}
@@ -0,0 +1,246 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "greatest.h"
+
+#include "elliptic/EllipticCurve.h"
+#include "util/Parallel.h"
+#include "util/PrimalityTest.h"
+#include "util/ValidationCache.h"
+
+// A fingerprint of an object of kind "test" with a single field.
+static void fingerprintOf(unsigned char *fingerprint, const unsigned long n) {
+  HashFunctionContext context;
+  mpz_t field;
+  mpz_init_set_ui(field, n);
+
+  validationCache_fingerprintInit(&context, "test");
+  validationCache_fingerprintAddInteger(&context, field);
+  validationCache_fingerprintFinal(fingerprint, &context);
+
+  mpz_clear(field);
+}
+
+TEST contains_should_find_added_fingerprints(void) {
+  // Given
+  unsigned char added[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  unsigned char other[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  fingerprintOf(added, 1);
+  fingerprintOf(other, 2);
+
+  validationCache_invalidate();
+
+  // When
+  validationCache_add(added, validationCache_generation());
+
+  // Then
+  ASSERT_EQ(validationCache_contains(added), CRYPTID_VALIDATION_SUCCESS);
+  ASSERT_EQ(validationCache_contains(other), CRYPTID_VALIDATION_FAILURE);
+
+  PASS();
+}
+
+TEST fingerprint_should_depend_on_kind_and_fields(void) {
+  // Given
+  unsigned char expected[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  HashFunctionContext context;
+  mpz_t field;
+  mpz_init_set_ui(field, 1);
+
+  fingerprintOf(expected, 1);
+
+  // When, Then
+  fingerprintOf(fingerprint, 1);
+  ASSERT_MEM_EQ(expected, fingerprint, VALIDATIONCACHE_FINGERPRINT_SIZE);
+
+  validationCache_fingerprintInit(&context, "other");
+  validationCache_fingerprintAddInteger(&context, field);
+  validationCache_fingerprintFinal(fingerprint, &context);
+  ASSERT(memcmp(expected, fingerprint, VALIDATIONCACHE_FINGERPRINT_SIZE));
+
+  mpz_neg(field, field);
+  validationCache_fingerprintInit(&context, "test");
+  validationCache_fingerprintAddInteger(&context, field);
+  validationCache_fingerprintFinal(fingerprint, &context);
+  ASSERT(memcmp(expected, fingerprint, VALIDATIONCACHE_FINGERPRINT_SIZE));
+
+  mpz_clear(field);
+
+  PASS();
+}
+
+TEST add_should_evict_the_least_recently_used(void) {
+  // Given
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+
+  validationCache_invalidate();
+  for (unsigned long i = 0; i < VALIDATIONCACHE_CAPACITY; i++) {
+    fingerprintOf(fingerprint, i);
+    validationCache_add(fingerprint, validationCache_generation());
+  }
+
+  // Entry 0 becomes the most recently used, so entry 1 is evicted.
+  fingerprintOf(fingerprint, 0);
+  validationCache_contains(fingerprint);
+
+  // When
+  fingerprintOf(fingerprint, VALIDATIONCACHE_CAPACITY);
+  validationCache_add(fingerprint, validationCache_generation());
+
+  // Then
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_SUCCESS);
+
+  fingerprintOf(fingerprint, 0);
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_SUCCESS);
+
+  fingerprintOf(fingerprint, 1);
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_FAILURE);
+
+  fingerprintOf(fingerprint, 2);
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_SUCCESS);
+
+  PASS();
+}
+
+TEST invalidate_should_empty_the_cache(void) {
+  // Given
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  fingerprintOf(fingerprint, 1);
+  validationCache_add(fingerprint, validationCache_generation());
+
+  // When
+  validationCache_invalidate();
+
+  // Then
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_FAILURE);
+
+  PASS();
+}
+
+TEST validation_policy_change_should_empty_the_cache(void) {
+  // Given
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  fingerprintOf(fingerprint, 1);
+  validationCache_add(fingerprint, validationCache_generation());
+
+  // When
+  primalityTest_setPolicy(primalityTest_VALIDATION, primalityTest_MILLER_RABIN);
+
+  // Then
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_FAILURE);
+
+  PASS();
+}
+
+TEST add_should_drop_validations_overlapping_a_policy_change(void) {
+  // Given
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  fingerprintOf(fingerprint, 1);
+  validationCache_invalidate();
+
+  // A validation starts under the current policy.
+  const unsigned long generation = validationCache_generation();
+
+  // When
+  primalityTest_setPolicy(primalityTest_VALIDATION, primalityTest_MILLER_RABIN);
+  validationCache_add(fingerprint, generation);
+
+  // Then
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_FAILURE);
+
+  PASS();
+}
+
+static void addAndLookUp(void *argument, const int taskIndex,
+                         const int taskCount) {
+  (void)argument;
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+
+  for (int i = 0; i < 1000; i++) {
+    fingerprintOf(fingerprint, (unsigned long)(i * taskCount + taskIndex));
+    validationCache_add(fingerprint, validationCache_generation());
+    validationCache_contains(fingerprint);
+  }
+}
+
+TEST cache_should_be_usable_from_multiple_threads(void) {
+  // Given
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+
+  validationCache_invalidate();
+  parallel_setThreadCount(4);
+
+  // When
+  parallel_run(addAndLookUp, NULL, 4);
+
+  parallel_setThreadCount(0);
+
+  // Then
+  // Whatever the interleaving, a full cache of distinct fingerprints remains.
+  int containedCount = 0;
+  for (unsigned long i = 0; i < 4000; i++) {
+    fingerprintOf(fingerprint, i);
+    containedCount += validationCache_contains(fingerprint);
+  }
+  ASSERT_EQ(containedCount, VALIDATIONCACHE_CAPACITY);
+
+  validationCache_invalidate();
+
+  PASS();
+}
+
+TEST isTypeOne_should_cache_only_valid_curves(void) {
+  // Given
+  EllipticCurve valid, invalid;
+  ellipticCurve_initLong(&valid, 0, 1, 199);
+  ellipticCurve_initLong(&invalid, 0, 1, 201);
+
+  validationCache_invalidate();
+
+  // When
+  ASSERT_EQ(ellipticCurve_isTypeOne(valid), CRYPTID_VALIDATION_SUCCESS);
+  ASSERT_EQ(ellipticCurve_isTypeOne(invalid), CRYPTID_VALIDATION_FAILURE);
+
+  // Then
+  // The curve is found again, the composite one is rejected again.
+  ASSERT_EQ(ellipticCurve_isTypeOne(valid), CRYPTID_VALIDATION_SUCCESS);
+  ASSERT_EQ(ellipticCurve_isTypeOne(invalid), CRYPTID_VALIDATION_FAILURE);
+
+  unsigned char fingerprint[VALIDATIONCACHE_FINGERPRINT_SIZE];
+  HashFunctionContext context;
+  validationCache_fingerprintInit(&context, "EllipticCurve");
+  validationCache_fingerprintAddInteger(&context, valid.a);
+  validationCache_fingerprintAddInteger(&context, valid.b);
+  validationCache_fingerprintAddInteger(&context, valid.fieldOrder);
+  validationCache_fingerprintFinal(fingerprint, &context);
+  ASSERT_EQ(validationCache_contains(fingerprint), CRYPTID_VALIDATION_SUCCESS);
+
+  ellipticCurve_destroy(valid);
+  ellipticCurve_destroy(invalid);
+
+  PASS();
+}
+
+SUITE(validation_cache_suite) {
+  RUN_TEST(contains_should_find_added_fingerprints);
+  RUN_TEST(fingerprint_should_depend_on_kind_and_fields);
+  RUN_TEST(add_should_evict_the_least_recently_used);
+  RUN_TEST(invalidate_should_empty_the_cache);
+  RUN_TEST(validation_policy_change_should_empty_the_cache);
+  RUN_TEST(add_should_drop_validations_overlapping_a_policy_change);
+  RUN_TEST(cache_should_be_usable_from_multiple_threads);
+  RUN_TEST(isTypeOne_should_cache_only_valid_curves);
+}
+
+GREATEST_MAIN_DEFS();
+
+int main(int argc, char **argv) {
+  GREATEST_MAIN_BEGIN();
+
+  RUN_SUITE(validation_cache_suite);
+
+  GREATEST_MAIN_END();
+}